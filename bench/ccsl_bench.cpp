@@ -0,0 +1,738 @@
+/**
+ * @file ccsl_bench.cpp
+ * @brief Microbenchmark suite for the CCSL hot paths
+ * @author Shyamal Chandra (C) 2025
+ *
+ * Modeled on Google Benchmark: each benchmark runs its body for as many
+ * iterations as it takes to fill the minimum time, and the results can be
+ * written as JSON in the same layout, so its comparison tools work on them.
+ *
+ * Usage: ccsl_bench [--benchmark_filter=<substring>]
+ *                   [--benchmark_min_time=<seconds>]
+ *                   [--benchmark_format=console|json]
+ *                   [--benchmark_out=<file>]
+ */
+
+#include "synthetic_source.hpp"
+#include <ccsl/metrics.hpp>
+#include <ccsl/license.hpp>
+#include <ccsl/license_snapshot.hpp>
+#include <ccsl/payout.hpp>
+#include <ccsl/source_classifier.hpp>
+#include <ccsl/thread_pool.hpp>
+#include <ccsl/utility.hpp>
+#include <ccsl/bitcoin_address.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef CCSL_VERSION
+#define CCSL_VERSION "unknown"
+#endif
+
+using namespace ccsl;
+using ccsl::bench::makeFragment;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Keep the compiler from discarding a result that is otherwise unused
+template<typename T>
+void doNotOptimize(const T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r"(&value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Iteration state handed to a benchmark body
+ *
+ * The body loops while keepRunning() returns true; only time spent inside
+ * that loop, minus paused spans, is measured.
+ */
+class State {
+public:
+    State(std::int64_t iterations, std::int64_t argument)
+        : m_remaining(iterations), m_iterations(iterations), m_argument(argument) {}
+
+    bool keepRunning() {
+        if (!m_started) {
+            m_started = true;
+            resumeTiming();
+        }
+        if (m_remaining-- > 0) {
+            return true;
+        }
+        pauseTiming();
+        return false;
+    }
+
+    /**
+     * @brief Exclude the following code from the measurement, e.g. per-iteration setup
+     */
+    void pauseTiming() {
+        m_realTime += Clock::now() - m_realStart;
+        m_cpuTime += static_cast<double>(std::clock() - m_cpuStart) / CLOCKS_PER_SEC;
+    }
+
+    void resumeTiming() {
+        m_realStart = Clock::now();
+        m_cpuStart = std::clock();
+    }
+
+    std::int64_t getArgument() const { return m_argument; }
+    std::int64_t getIterations() const { return m_iterations; }
+
+    void setBytesProcessed(std::int64_t bytes) { m_bytes = bytes; }
+    void setItemsProcessed(std::int64_t items) { m_items = items; }
+    std::int64_t getBytesProcessed() const { return m_bytes; }
+    std::int64_t getItemsProcessed() const { return m_items; }
+
+    double getRealSeconds() const { return std::chrono::duration<double>(m_realTime).count(); }
+    double getCpuSeconds() const { return m_cpuTime; }
+
+private:
+    std::int64_t m_remaining;
+    std::int64_t m_iterations;
+    std::int64_t m_argument;
+    std::int64_t m_bytes = 0;
+    std::int64_t m_items = 0;
+    bool m_started = false;
+    Clock::time_point m_realStart;
+    Clock::duration m_realTime{0};
+    std::clock_t m_cpuStart = 0;
+    double m_cpuTime = 0.0;
+};
+
+struct Benchmark {
+    std::string name;                  ///< Name including the argument, e.g. "BM_EvaluateAll/4096"
+    std::function<void(State&)> body;  ///< Code to measure
+    std::int64_t argument;             ///< Value of State::getArgument()
+};
+
+struct Result {
+    std::string name;
+    std::int64_t iterations;
+    double realNanoseconds;  ///< Per iteration
+    double cpuNanoseconds;   ///< Per iteration
+    double bytesPerSecond;   ///< 0 if the benchmark processes no bytes
+    double itemsPerSecond;   ///< 0 if the benchmark processes no items
+};
+
+// Run one benchmark, growing the iteration count until it fills minSeconds
+Result run(const Benchmark& benchmark, double minSeconds) {
+    std::int64_t iterations = 1;
+    while (true) {
+        State state(iterations, benchmark.argument);
+        benchmark.body(state);
+
+        double seconds = state.getRealSeconds();
+        if (seconds >= minSeconds || iterations >= 1000000000) {
+            Result result;
+            result.name = benchmark.name;
+            result.iterations = iterations;
+            result.realNanoseconds = seconds * 1e9 / iterations;
+            result.cpuNanoseconds = state.getCpuSeconds() * 1e9 / iterations;
+            result.bytesPerSecond = seconds > 0 ? state.getBytesProcessed() / seconds : 0.0;
+            result.itemsPerSecond = seconds > 0 ? state.getItemsProcessed() / seconds : 0.0;
+            return result;
+        }
+
+        // Aim 40% past the target, as Google Benchmark does, growing at most 10x per round
+        double scale = seconds > 0 ? minSeconds * 1.4 / seconds : 10.0;
+        iterations = static_cast<std::int64_t>(iterations * std::min(std::max(scale, 2.0), 10.0));
+    }
+}
+
+const char* metricName(MetricType type) {
+    switch (type) {
+        case MetricType::IMPACT: return "Impact";
+        case MetricType::SIMPLICITY: return "Simplicity";
+        case MetricType::CLEANNESS: return "Cleanness";
+        case MetricType::COMMENT: return "Comment";
+        case MetricType::CREDITABILITY: return "Creditability";
+        case MetricType::NOVELTY: return "Novelty";
+    }
+    return "Unknown";
+}
+
+// Large source files written on first use by the file benchmarks and removed on exit
+class TempFiles {
+public:
+    ~TempFiles() {
+        for (const auto& path : m_paths) {
+            std::error_code ignored;
+            std::filesystem::remove(path, ignored);
+        }
+    }
+
+    std::filesystem::path get(std::size_t bytes) {
+        for (std::size_t i = 0; i < m_sizes.size(); i++) {
+            if (m_sizes[i] == bytes) {
+                return m_paths[i];
+            }
+        }
+
+        std::filesystem::path path = std::filesystem::temp_directory_path() /
+            ("ccsl_bench_" + std::to_string(bytes) + ".cpp");
+        std::ofstream(path, std::ios::binary) << makeFragment(bytes);
+        m_sizes.push_back(bytes);
+        m_paths.push_back(path);
+        return m_paths.back();
+    }
+
+private:
+    std::vector<std::size_t> m_sizes;
+    std::vector<std::filesystem::path> m_paths;
+};
+
+std::vector<Benchmark> registerBenchmarks(TempFiles& files) {
+    std::vector<Benchmark> benchmarks;
+    const std::int64_t fragmentSizes[] = {256, 4096, 65536};
+
+    for (MetricType type : {MetricType::IMPACT, MetricType::SIMPLICITY, MetricType::CLEANNESS,
+                            MetricType::COMMENT, MetricType::CREDITABILITY, MetricType::NOVELTY}) {
+        for (std::int64_t size : fragmentSizes) {
+            benchmarks.push_back({
+                std::string("BM_Evaluate<") + metricName(type) + ">/" + std::to_string(size),
+                [type](State& state) {
+                    const std::string code = makeFragment(static_cast<std::size_t>(state.getArgument()));
+                    std::unique_ptr<MetricEvaluator> evaluator = MetricEvaluatorFactory::create(type);
+                    while (state.keepRunning()) {
+                        doNotOptimize(evaluator->evaluate(code));
+                    }
+                    state.setBytesProcessed(state.getIterations() * static_cast<std::int64_t>(code.size()));
+                },
+                size
+            });
+        }
+    }
+
+    for (std::int64_t size : fragmentSizes) {
+        benchmarks.push_back({
+            "BM_EvaluateAll/" + std::to_string(size),
+            [](State& state) {
+                const std::string code = makeFragment(static_cast<std::size_t>(state.getArgument()));
+                MetricsEvaluator evaluator;
+                while (state.keepRunning()) {
+                    doNotOptimize(evaluator.evaluateAll(code));
+                }
+                state.setBytesProcessed(state.getIterations() * static_cast<std::int64_t>(code.size()));
+            },
+            size
+        });
+    }
+
+    // Classifying ordinary source, and a 1 MB single-line file the
+    // classifier rejects against the cost of scoring it anyway
+    for (std::int64_t size : fragmentSizes) {
+        benchmarks.push_back({
+            "BM_ClassifySource/" + std::to_string(size),
+            [](State& state) {
+                const std::string code = makeFragment(static_cast<std::size_t>(state.getArgument()));
+                SourceClassifier classifier;
+                while (state.keepRunning()) {
+                    doNotOptimize(classifier.classify("fragment.cpp", code));
+                }
+                state.setBytesProcessed(state.getIterations() * static_cast<std::int64_t>(code.size()));
+            },
+            size
+        });
+    }
+
+    for (bool classify : {true, false}) {
+        benchmarks.push_back({
+            std::string(classify ? "BM_ClassifyMinified/" : "BM_EvaluateMinified/") + std::to_string(1 << 20),
+            [classify](State& state) {
+                std::string code = makeFragment(static_cast<std::size_t>(state.getArgument()));
+                std::replace(code.begin(), code.end(), '\n', ' ');
+                SourceClassifier classifier;
+                MetricsEvaluator evaluator;
+                while (state.keepRunning()) {
+                    if (classify) {
+                        doNotOptimize(classifier.classify("bundle.c", code));
+                    } else {
+                        doNotOptimize(evaluator.evaluateScores(code));
+                    }
+                }
+                state.setBytesProcessed(state.getIterations() * static_cast<std::int64_t>(code.size()));
+            },
+            1 << 20
+        });
+    }
+
+    // The same evaluations with the result list in a per-fragment arena
+    for (std::int64_t size : fragmentSizes) {
+        benchmarks.push_back({
+            "BM_EvaluateAllArena/" + std::to_string(size),
+            [](State& state) {
+                const std::string code = makeFragment(static_cast<std::size_t>(state.getArgument()));
+                MetricsEvaluator evaluator;
+                std::array<std::byte, 4096> buffer;
+                while (state.keepRunning()) {
+                    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+                    doNotOptimize(evaluator.evaluateAll(code, &arena));
+                }
+                state.setBytesProcessed(state.getIterations() * static_cast<std::int64_t>(code.size()));
+            },
+            size
+        });
+    }
+
+    for (std::int64_t count : {1000, 10000, 100000}) {
+        benchmarks.push_back({
+            "BM_RegisterContribution/" + std::to_string(count),
+            [](State& state) {
+                // Disjoint ranges spread over 100 files, so every registration succeeds
+                std::vector<CodeContribution> contributions;
+                contributions.reserve(static_cast<std::size_t>(state.getArgument()));
+                for (std::int64_t i = 0; i < state.getArgument(); i++) {
+                    int line = static_cast<int>(i / 100) * 10;
+                    contributions.emplace_back("contributor" + std::to_string(i % 7),
+                                               "file" + std::to_string(i % 100) + ".cpp", line, line + 5);
+                }
+
+                while (state.keepRunning()) {
+                    state.pauseTiming();
+                    License license("Bench", "KEY");
+                    state.resumeTiming();
+                    for (const auto& contribution : contributions) {
+                        license.registerContribution(contribution);
+                    }
+                }
+                state.setItemsProcessed(state.getIterations() * state.getArgument());
+            },
+            count
+        });
+
+        // Same workload with one arena per license, released in one step
+        // when the license is destroyed. The arena starts in a buffer kept
+        // across iterations, as a long-running scanner would reuse it
+        benchmarks.push_back({
+            "BM_RegisterContributionArena/" + std::to_string(count),
+            [](State& state) {
+                std::vector<CodeContribution> contributions;
+                contributions.reserve(static_cast<std::size_t>(state.getArgument()));
+                for (std::int64_t i = 0; i < state.getArgument(); i++) {
+                    int line = static_cast<int>(i / 100) * 10;
+                    contributions.emplace_back("contributor" + std::to_string(i % 7),
+                                               "file" + std::to_string(i % 100) + ".cpp", line, line + 5);
+                }
+
+                std::vector<std::byte> buffer(static_cast<std::size_t>(state.getArgument()) * 512);
+                while (state.keepRunning()) {
+                    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+                    state.pauseTiming();
+                    License license("Bench", "KEY", &arena);
+                    state.resumeTiming();
+                    for (const auto& contribution : contributions) {
+                        license.registerContribution(contribution);
+                    }
+                }
+                state.setItemsProcessed(state.getIterations() * state.getArgument());
+            },
+            count
+        });
+    }
+
+    // Reweighing every row with the SIMD kernels, against a row-by-row loop
+    auto makeScoredLicense = [](std::int64_t count) {
+        auto license = std::make_unique<License>("Bench", "CCSL-BENCH-KEY");
+        for (std::int64_t i = 0; i < count; i++) {
+            int line = static_cast<int>(i / 100) * 10;
+            CodeContribution contribution("contributor" + std::to_string(i % 7),
+                                          "file" + std::to_string(i % 100) + ".cpp", line, line + 5);
+            MetricScores scores;
+            for (std::size_t m = 0; m < kMetricTypeCount; m++) {
+                scores.set(static_cast<MetricType>(m), static_cast<double>((i + m) % 10) / 10.0);
+            }
+            contribution.setMetricScores(scores);
+            license->registerContribution(std::move(contribution));
+        }
+        return license;
+    };
+
+    for (std::int64_t count : {100000}) {
+        benchmarks.push_back({
+            "BM_SetMetricWeights/" + std::to_string(count),
+            [makeScoredLicense](State& state) {
+                auto license = makeScoredLicense(state.getArgument());
+                MetricWeights weights;
+                double impact = 1.0;
+                while (state.keepRunning()) {
+                    weights.set(MetricType::IMPACT, impact);
+                    impact = impact > 4.0 ? 1.0 : impact + 0.5;
+                    license->setMetricWeights(weights);
+                    doNotOptimize(license->getTotalValue());
+                }
+                state.setItemsProcessed(state.getIterations() * state.getArgument());
+            },
+            count
+        });
+
+        // The weighing alone, columnar kernels against one row at a time
+        benchmarks.push_back({
+            "BM_ScoreMatrixSetWeights/" + std::to_string(count),
+            [makeScoredLicense](State& state) {
+                auto license = makeScoredLicense(state.getArgument());
+                ScoreMatrix matrix;
+                for (const auto& contribution : license->getContributions()) {
+                    matrix.append(contribution.getMetricScores());
+                }
+                MetricWeights weights;
+                double impact = 1.0;
+                while (state.keepRunning()) {
+                    weights.set(MetricType::IMPACT, impact);
+                    impact = impact > 4.0 ? 1.0 : impact + 0.5;
+                    matrix.setWeights(weights);
+                    doNotOptimize(matrix.getValues().back());
+                }
+                state.setItemsProcessed(state.getIterations() * state.getArgument());
+            },
+            count
+        });
+
+        benchmarks.push_back({
+            "BM_ReweighRowByRow/" + std::to_string(count),
+            [makeScoredLicense](State& state) {
+                auto license = makeScoredLicense(state.getArgument());
+                MetricWeights weights;
+                double impact = 1.0;
+                std::vector<double> values(license->getContributions().size());
+                while (state.keepRunning()) {
+                    weights.set(MetricType::IMPACT, impact);
+                    impact = impact > 4.0 ? 1.0 : impact + 0.5;
+                    const auto& contributions = license->getContributions();
+                    for (std::size_t i = 0; i < contributions.size(); i++) {
+                        values[i] = weights.apply(contributions[i].getMetricScores());
+                    }
+                    doNotOptimize(values.back());
+                }
+                state.setItemsProcessed(state.getIterations() * state.getArgument());
+            },
+            count
+        });
+
+        benchmarks.push_back({
+            "BM_ContributorValues/" + std::to_string(count),
+            [makeScoredLicense](State& state) {
+                auto license = makeScoredLicense(state.getArgument());
+                while (state.keepRunning()) {
+                    // Cached totals: no contribution is visited
+                    doNotOptimize(license->getContributorValue("contributor3"));
+                }
+                state.setItemsProcessed(state.getIterations());
+            },
+            count
+        });
+    }
+
+    // A monthly payout to count contributors with one contribution each
+    for (std::int64_t count : {100000}) {
+        for (std::size_t threads : {std::size_t(1), std::size_t(0)}) {
+            benchmarks.push_back({
+                std::string(threads == 1 ? "BM_ComputePayouts/" : "BM_ComputePayoutsParallel/") + std::to_string(count),
+                [threads](State& state) {
+                    License license("Bench", "CCSL-BENCH-KEY");
+                    std::vector<PaymentSubscription> subscriptions;
+                    subscriptions.reserve(static_cast<std::size_t>(state.getArgument()));
+                    for (std::int64_t i = 0; i < state.getArgument(); i++) {
+                        const std::string contributor = "payee" + std::to_string(i);
+                        CodeContribution contribution(contributor, "file" + std::to_string(i % 100) + ".cpp",
+                                                      static_cast<int>(i) * 10, static_cast<int>(i) * 10 + 5);
+                        MetricScores scores;
+                        scores.set(MetricType::IMPACT, static_cast<double>(i % 10 + 1) / 10.0);
+                        contribution.setMetricScores(scores);
+                        license.registerContribution(std::move(contribution));
+                        subscriptions.emplace_back(contributor, "1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa", 30);
+                    }
+
+                    ThreadPool pool(threads);
+                    PayoutEngine engine(license, threads == 1 ? nullptr : &pool);
+                    while (state.keepRunning()) {
+                        doNotOptimize(engine.computePayouts(subscriptions, Satoshis(kSatoshisPerBitcoin)));
+                    }
+                    state.setItemsProcessed(state.getIterations() * state.getArgument());
+                },
+                count
+            });
+        }
+    }
+
+    // Snapshots of a license with 100 files of count / 100 contributions each
+    auto writeSnapshot = [](std::int64_t count) {
+        License license("Bench", "CCSL-BENCH-KEY");
+        for (std::int64_t i = 0; i < count; i++) {
+            int line = static_cast<int>(i / 100) * 10;
+            license.registerContribution(CodeContribution("contributor" + std::to_string(i % 7),
+                                                          "file" + std::to_string(i % 100) + ".cpp", line, line + 5));
+        }
+        std::filesystem::path path = std::filesystem::temp_directory_path() /
+                                     ("ccsl_bench_snapshot_" + std::to_string(count) + ".bin");
+        LicenseSnapshot::write(license, path);
+        return path;
+    };
+
+    for (std::int64_t count : {100000}) {
+        benchmarks.push_back({
+            "BM_OpenLicenseSnapshot/" + std::to_string(count),
+            [writeSnapshot](State& state) {
+                const std::filesystem::path path = writeSnapshot(state.getArgument());
+                while (state.keepRunning()) {
+                    std::optional<LicenseSnapshot> snapshot = LicenseSnapshot::open(path);
+                    doNotOptimize(snapshot->findContribution("file42.cpp", 5000));
+                }
+                state.setItemsProcessed(state.getIterations());
+                std::filesystem::remove(path);
+            },
+            count
+        });
+
+        benchmarks.push_back({
+            "BM_SnapshotToLicense/" + std::to_string(count),
+            [writeSnapshot](State& state) {
+                const std::filesystem::path path = writeSnapshot(state.getArgument());
+                std::optional<LicenseSnapshot> snapshot = LicenseSnapshot::open(path);
+                while (state.keepRunning()) {
+                    doNotOptimize(snapshot->toLicense().getContributions().size());
+                }
+                state.setItemsProcessed(state.getIterations() * state.getArgument());
+                std::filesystem::remove(path);
+            },
+            count
+        });
+    }
+
+    for (std::int64_t size : {std::int64_t(1) << 20, std::int64_t(16) << 20}) {
+        benchmarks.push_back({
+            "BM_ReadCodeFromFile/" + std::to_string(size),
+            [&files](State& state) {
+                const std::filesystem::path path = files.get(static_cast<std::size_t>(state.getArgument()));
+                std::int64_t bytes = 0;
+                while (state.keepRunning()) {
+                    std::optional<std::string> code = readCodeFromFile(path, 0, 1 << 30);
+                    bytes += code ? static_cast<std::int64_t>(code->size()) : 0;
+                }
+                state.setBytesProcessed(bytes);
+            },
+            size
+        });
+    }
+
+    benchmarks.push_back({
+        "BM_GenerateUUID",
+        [](State& state) {
+            while (state.keepRunning()) {
+                doNotOptimize(generateUUID());
+            }
+            state.setItemsProcessed(state.getIterations());
+        },
+        0
+    });
+
+    benchmarks.push_back({
+        "BM_GenerateUUIDv7",
+        [](State& state) {
+            while (state.keepRunning()) {
+                doNotOptimize(generateUUID(UUIDVersion::V7));
+            }
+            state.setItemsProcessed(state.getIterations());
+        },
+        0
+    });
+
+    benchmarks.push_back({
+        "BM_ParseBitcoinAddress",
+        [](State& state) {
+            const std::string address = "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4";
+            while (state.keepRunning()) {
+                doNotOptimize(parseBitcoinAddress(address));
+            }
+            state.setItemsProcessed(state.getIterations());
+        },
+        0
+    });
+
+    benchmarks.push_back({
+        "BM_ValidateBitcoinAddress",
+        [](State& state) {
+            const std::string address = "1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa";
+            while (state.keepRunning()) {
+                doNotOptimize(validateBitcoinAddress(address));
+            }
+            state.setItemsProcessed(state.getIterations());
+        },
+        0
+    });
+
+    benchmarks.push_back({
+        "BM_GenerateUUIDChars",
+        [](State& state) {
+            while (state.keepRunning()) {
+                doNotOptimize(generateUUIDChars());
+            }
+            state.setItemsProcessed(state.getIterations());
+        },
+        0
+    });
+
+    return benchmarks;
+}
+
+std::string escapeJson(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+void writeJson(std::ostream& out, const std::vector<Result>& results) {
+    std::time_t now = std::time(nullptr);
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    out << "{\n"
+        << "  \"context\": {\n"
+        << "    \"date\": \"" << date << "\",\n"
+        << "    \"library_version\": \"" << CCSL_VERSION << "\",\n"
+        << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+#ifdef NDEBUG
+        << "    \"library_build_type\": \"release\"\n"
+#else
+        << "    \"library_build_type\": \"debug\"\n"
+#endif
+        << "  },\n"
+        << "  \"benchmarks\": [";
+
+    out << std::setprecision(17);
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const Result& result = results[i];
+        out << (i > 0 ? "," : "") << "\n    {\n"
+            << "      \"name\": \"" << escapeJson(result.name) << "\",\n"
+            << "      \"run_name\": \"" << escapeJson(result.name) << "\",\n"
+            << "      \"run_type\": \"iteration\",\n"
+            << "      \"iterations\": " << result.iterations << ",\n"
+            << "      \"real_time\": " << result.realNanoseconds << ",\n"
+            << "      \"cpu_time\": " << result.cpuNanoseconds << ",\n"
+            << "      \"time_unit\": \"ns\"";
+        if (result.bytesPerSecond > 0) {
+            out << ",\n      \"bytes_per_second\": " << result.bytesPerSecond;
+        }
+        if (result.itemsPerSecond > 0) {
+            out << ",\n      \"items_per_second\": " << result.itemsPerSecond;
+        }
+        out << "\n    }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+void printConsoleHeader() {
+    std::cout << std::left << std::setw(40) << "Benchmark"
+              << std::right << std::setw(16) << "Time (ns)"
+              << std::setw(16) << "CPU (ns)"
+              << std::setw(14) << "Iterations"
+              << "  Throughput\n"
+              << std::string(100, '-') << "\n";
+}
+
+void printConsoleRow(const Result& result) {
+    std::cout << std::left << std::setw(40) << result.name
+              << std::right << std::fixed << std::setprecision(0)
+              << std::setw(16) << result.realNanoseconds
+              << std::setw(16) << result.cpuNanoseconds
+              << std::setw(14) << result.iterations << "  ";
+    if (result.bytesPerSecond > 0) {
+        std::cout << std::setprecision(1) << result.bytesPerSecond / (1 << 20) << " MiB/s";
+    } else if (result.itemsPerSecond > 0) {
+        std::cout << std::setprecision(1) << result.itemsPerSecond / 1000.0 << " k items/s";
+    }
+    std::cout << std::endl;
+}
+
+bool startsWith(const std::string& text, const std::string& prefix) {
+    return text.compare(0, prefix.size(), prefix) == 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string filter;
+    std::string format = "console";
+    std::string outPath;
+    double minSeconds = 0.5;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (startsWith(arg, "--benchmark_filter=")) {
+            filter = arg.substr(19);
+        } else if (startsWith(arg, "--benchmark_min_time=")) {
+            minSeconds = std::stod(arg.substr(21));
+        } else if (startsWith(arg, "--benchmark_format=")) {
+            format = arg.substr(19);
+        } else if (startsWith(arg, "--benchmark_out=")) {
+            outPath = arg.substr(16);
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n"
+                      << "Usage: " << argv[0] << " [--benchmark_filter=<substring>]"
+                      << " [--benchmark_min_time=<seconds>] [--benchmark_format=console|json]"
+                      << " [--benchmark_out=<file>]\n";
+            return 1;
+        }
+    }
+    if (format != "console" && format != "json") {
+        std::cerr << "Unknown format: " << format << "\n";
+        return 1;
+    }
+
+    TempFiles files;
+    std::vector<Benchmark> benchmarks = registerBenchmarks(files);
+    std::vector<Result> results;
+
+    if (format == "console") {
+        printConsoleHeader();
+    }
+    for (const Benchmark& benchmark : benchmarks) {
+        if (benchmark.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        results.push_back(run(benchmark, minSeconds));
+        if (format == "console") {
+            printConsoleRow(results.back());
+        }
+    }
+
+    if (format == "json") {
+        writeJson(std::cout, results);
+    }
+    if (!outPath.empty()) {
+        std::ofstream out(outPath);
+        writeJson(out, results);
+        if (!out) {
+            std::cerr << "Failed to write " << outPath << "\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file keyword_bench.cpp
+ * @brief Benchmark of the keyword matcher against the former std::regex path
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include "synthetic_source.hpp"
+#include <ccsl/metrics.hpp>
+#include <iostream>
+#include <iomanip>
+#include <regex>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace ccsl;
+using ccsl::bench::makeFragment;
+
+namespace {
+
+// Count matches of a pattern the way the evaluators used to: compile the
+// regex on every call and walk it with std::sregex_iterator
+int countMatches(const std::string& code, const char* pattern) {
+    std::regex regex(pattern);
+    return static_cast<int>(std::distance(
+        std::sregex_iterator(code.begin(), code.end(), regex), std::sregex_iterator()));
+}
+
+// The regex work ImpactEvaluator, CreditabilityEvaluator and NoveltyEvaluator
+// used to do for a single fragment
+int regexPath(const std::string& code) {
+    int total = 0;
+    total += countMatches(code, R"(\b\w+\s*\()");
+    total += countMatches(code, R"(\b(if|for|while|switch)\s*\()");
+    total += countMatches(code, R"(\b(test|assert|expect|should|mock|stub|spy)\b)");
+    total += countMatches(code, R"(\@(param|return|throws?|see|link|since|version|author|deprecated))");
+    total += countMatches(code, R"((http|https)://[^\s"'<>]+|(RFC|IEEE|ISO)[- ][0-9]+)");
+    total += countMatches(code, R"(\b(template|constexpr|decltype|concept|requires|noexcept|auto|lambda|fold|structured\s+binding)\b)");
+    total += countMatches(code, R"(\b(Factory|Builder|Singleton|Adapter|Bridge|Composite|Decorator|Facade|Proxy|Observer|Strategy|Command|State|Visitor|Interpreter|Iterator|Mediator|Memento|Prototype)\b)");
+    total += countMatches(code, R"(O\([^\)]*\))");
+    return total;
+}
+
+// The same three evaluators on top of the lexer and keyword matcher
+int matcherPath(const std::string& code) {
+    static const ImpactEvaluator impact;
+    static const CreditabilityEvaluator creditability;
+    static const NoveltyEvaluator novelty;
+
+    SourceSummary summary = scanSource(code);
+    double total = impact.evaluate(summary).value +
+                   creditability.evaluate(summary).value +
+                   novelty.evaluate(summary).value;
+    return static_cast<int>(total * 1000);
+}
+
+template<typename Func>
+double microsecondsPerCall(Func func, const std::string& code, int iterations) {
+    volatile int sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        sink = sink + func(code);
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::micro> elapsed = end - start;
+    return elapsed.count() / iterations;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Keyword matcher vs std::regex (Impact, Creditability, Novelty)\n";
+    std::cout << "==============================================================\n";
+    std::cout << std::left << std::setw(12) << "Bytes"
+              << std::setw(16) << "Regex (us)"
+              << std::setw(16) << "Matcher (us)"
+              << "Speedup\n";
+
+    for (std::size_t bytes : {256, 1024, 4096, 16384, 65536}) {
+        const std::string code = makeFragment(bytes);
+        const int iterations = static_cast<int>(std::max<std::size_t>(4, 262144 / code.size()));
+
+        double regexTime = microsecondsPerCall(regexPath, code, iterations);
+        double matcherTime = microsecondsPerCall(matcherPath, code, iterations * 16);
+
+        std::cout << std::left << std::setw(12) << code.size()
+                  << std::setw(16) << std::fixed << std::setprecision(2) << regexTime
+                  << std::setw(16) << matcherTime
+                  << std::setprecision(1) << regexTime / matcherTime << "x\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,464 @@
+/**
+ * @file scaling_bench.cpp
+ * @brief Thread scaling benchmark of evaluation, registration and repository scans
+ * @author Shyamal Chandra (C) 2025
+ *
+ * Generates a deterministic synthetic source tree, then measures lines
+ * per second and peak resident memory of each workload at 1, 2, 4, ...
+ * threads and prints the scaling curve. Each measurement runs in its own
+ * child process, so peak RSS belongs to that measurement alone.
+ *
+ * With --baseline the results are compared against a baseline recorded
+ * with --write-baseline, and the exit status is 1 if any workload scales
+ * worse or uses more memory than the baseline allows. Parallel efficiency
+ * (speedup divided by threads) is compared rather than raw throughput,
+ * but efficiency still depends on the core count, so a baseline is only
+ * accepted on a machine with the hardware threads it was recorded with;
+ * thread counts beyond them are measured but not checked. A baseline
+ * covering a single thread would check no scaling at all, so recording
+ * or checking one needs at least 2 hardware threads.
+ *
+ * Usage: ccsl_scaling_bench [--files=N] [--lines=N] [--depth=N] [--comments=F] [--seed=N]
+ *                           [--max-threads=N] [--min-time=SECONDS]
+ *                           [--baseline=FILE] [--tolerance=F] [--write-baseline=FILE]
+ */
+
+#include "synthetic_source.hpp"
+#include <ccsl/license.hpp>
+#include <ccsl/metrics.hpp>
+#include <ccsl/repository_scanner.hpp>
+#include <ccsl/thread_pool.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CCSL_SCALING_FORK 1
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace ccsl;
+using namespace ccsl::bench;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Workload {
+    std::string name;       ///< Name in the output and the baseline
+    bool parallel;          ///< False if the workload is single-threaded by design
+    std::function<std::uint64_t(std::size_t threads, double minSeconds, double& seconds)> run; ///< Returns lines processed
+};
+
+struct Measurement {
+    std::string workload;
+    std::size_t threads = 0;
+    double linesPerSecond = 0.0;
+    double efficiency = 0.0;     ///< Speedup over one thread, divided by threads
+    long peakRssKiB = 0;         ///< 0 if it could not be measured
+    bool ok = false;
+};
+
+struct BaselineEntry {
+    std::string workload;
+    std::size_t threads = 0;
+    double linesPerSecond = 0.0;
+    double efficiency = 0.0;
+    long peakRssKiB = 0;
+};
+
+// Repeat a body until it has run for minSeconds, counting the lines it processed
+template <typename Body>
+std::uint64_t repeat(double minSeconds, std::uint64_t linesPerRun, double& seconds, Body body) {
+    std::uint64_t lines = 0;
+    const Clock::time_point start = Clock::now();
+    do {
+        body();
+        lines += linesPerRun;
+        seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (seconds < minSeconds);
+    return lines;
+}
+
+std::vector<std::string> loadTree(const std::filesystem::path& root, std::size_t fileCount) {
+    std::vector<std::string> files;
+    files.reserve(fileCount);
+    for (std::size_t i = 0; i < fileCount; i++) {
+        std::ifstream in(root / SyntheticSourceGenerator::relativePath(i), std::ios::binary);
+        std::ostringstream contents;
+        contents << in.rdbuf();
+        files.push_back(contents.str());
+    }
+    return files;
+}
+
+std::vector<Workload> makeWorkloads(const std::filesystem::path& root, const SyntheticSourceOptions& options) {
+    const std::uint64_t totalLines = options.fileCount * options.linesPerFile;
+    std::vector<Workload> workloads;
+
+    workloads.push_back({"evaluate", true, [=](std::size_t threads, double minSeconds, double& seconds) {
+        const std::vector<std::string> files = loadTree(root, options.fileCount);
+        const std::vector<std::string_view> fragments(files.begin(), files.end());
+        MetricsEvaluator evaluator;
+        ThreadPool pool(threads);
+        return repeat(minSeconds, totalLines, seconds, [&] {
+            std::vector<MetricScores> scores = evaluator.evaluateBatchScores(fragments, pool);
+            if (scores.size() != fragments.size()) {
+                std::abort();
+            }
+        });
+    }});
+
+    // License is not thread-safe, so registration only runs on one thread
+    workloads.push_back({"register", false, [=](std::size_t, double minSeconds, double& seconds) {
+        const std::vector<std::string> files = loadTree(root, options.fileCount);
+        MetricsEvaluator evaluator;
+        std::vector<CodeContribution> contributions;
+        for (std::size_t i = 0; i < files.size(); i++) {
+            contributions.emplace_back("contributor" + std::to_string(i % 16),
+                                       SyntheticSourceGenerator::relativePath(i).generic_string(),
+                                       0, static_cast<int>(options.linesPerFile) - 1);
+            contributions.back().setMetricScores(evaluator.evaluateScores(files[i]));
+        }
+        return repeat(minSeconds, totalLines, seconds, [&] {
+            License license("Scaling", "CCSL-SCALING-KEY");
+            for (const CodeContribution& contribution : contributions) {
+                license.registerContribution(contribution);
+            }
+        });
+    }});
+
+    workloads.push_back({"scan", true, [=](std::size_t threads, double minSeconds, double& seconds) {
+        RepositoryScanOptions scanOptions;
+        scanOptions.contributor = "Scaling";
+        scanOptions.evaluateThreads = threads;
+        RepositoryScanner scanner(scanOptions);
+        return repeat(minSeconds, totalLines, seconds, [&] {
+            License license("Scaling", "CCSL-SCALING-KEY");
+            scanner.scan(root, license);
+        });
+    }});
+
+    return workloads;
+}
+
+// Run one measurement, in a child process where fork() is available
+Measurement measure(const Workload& workload, std::size_t threads, double minSeconds) {
+    Measurement measurement;
+    measurement.workload = workload.name;
+    measurement.threads = threads;
+
+#if defined(CCSL_SCALING_FORK)
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return measurement;
+    }
+    std::cout.flush();
+    const pid_t child = fork();
+    if (child == 0) {
+        close(fds[0]);
+        double seconds = 0.0;
+        const std::uint64_t lines = workload.run(threads, minSeconds, seconds);
+        const double rate = seconds > 0 ? static_cast<double>(lines) / seconds : 0.0;
+        const bool written = write(fds[1], &rate, sizeof(rate)) == static_cast<ssize_t>(sizeof(rate));
+        _exit(written ? 0 : 1);
+    }
+    close(fds[1]);
+    double rate = 0.0;
+    const bool received = child > 0 && read(fds[0], &rate, sizeof(rate)) == static_cast<ssize_t>(sizeof(rate));
+    close(fds[0]);
+    int status = 0;
+    struct rusage usage {};
+    if (child > 0 && wait4(child, &status, 0, &usage) == child && received &&
+        WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+        measurement.linesPerSecond = rate;
+#if defined(__APPLE__)
+        measurement.peakRssKiB = usage.ru_maxrss / 1024;
+#else
+        measurement.peakRssKiB = usage.ru_maxrss;
+#endif
+        measurement.ok = true;
+    }
+#else
+    double seconds = 0.0;
+    const std::uint64_t lines = workload.run(threads, minSeconds, seconds);
+    measurement.linesPerSecond = seconds > 0 ? static_cast<double>(lines) / seconds : 0.0;
+    measurement.ok = true;
+#endif
+    return measurement;
+}
+
+std::string optionsLine(const SyntheticSourceOptions& options) {
+    std::ostringstream line;
+    line << "files=" << options.fileCount << " lines=" << options.linesPerFile
+         << " depth=" << options.nestingDepth << " comments=" << options.commentDensity
+         << " seed=" << options.seed;
+    return line.str();
+}
+
+void printCurve(const std::vector<Measurement>& results, const std::string& workload) {
+    double bestSpeedup = 0.0;
+    for (const Measurement& m : results) {
+        if (m.workload == workload) {
+            bestSpeedup = std::max(bestSpeedup, m.efficiency * static_cast<double>(m.threads));
+        }
+    }
+
+    std::cout << "\n" << workload << "\n"
+              << std::right << std::setw(8) << "Threads" << std::setw(16) << "Lines/s"
+              << std::setw(10) << "Speedup" << std::setw(12) << "Efficiency" << std::setw(14) << "Peak RSS"
+              << "  Scaling\n"
+              << std::string(100, '-') << "\n";
+    for (const Measurement& m : results) {
+        if (m.workload != workload) {
+            continue;
+        }
+        if (!m.ok) {
+            std::cout << std::setw(8) << m.threads << "  failed\n";
+            continue;
+        }
+        const double speedup = m.efficiency * static_cast<double>(m.threads);
+        const int bar = bestSpeedup > 0 ? static_cast<int>(40.0 * speedup / bestSpeedup + 0.5) : 0;
+        std::cout << std::fixed << std::setw(8) << m.threads
+                  << std::setw(16) << std::setprecision(0) << m.linesPerSecond
+                  << std::setw(9) << std::setprecision(2) << speedup << "x"
+                  << std::setw(11) << std::setprecision(0) << m.efficiency * 100.0 << "%"
+                  << std::setw(10) << std::setprecision(1) << m.peakRssKiB / 1024.0 << " MiB"
+                  << "  " << std::string(static_cast<std::size_t>(bar), '#') << "\n";
+    }
+}
+
+bool readBaseline(const std::string& path, std::string& options, std::size_t& hardwareThreads,
+                  std::vector<BaselineEntry>& entries) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.rfind("# options ", 0) == 0) {
+            options = line.substr(10);
+            continue;
+        }
+        if (line.rfind("# hardware_threads ", 0) == 0) {
+            hardwareThreads = std::stoul(line.substr(19));
+            continue;
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        BaselineEntry entry;
+        if (fields >> entry.workload >> entry.threads >> entry.linesPerSecond >> entry.efficiency >> entry.peakRssKiB) {
+            entries.push_back(entry);
+        }
+    }
+    return true;
+}
+
+bool writeBaseline(const std::string& path, const SyntheticSourceOptions& options,
+                   const std::vector<Measurement>& results, std::size_t hardwareThreads) {
+    std::ofstream out(path);
+    out << "# Scaling baseline for ccsl_scaling_bench; regenerate with --write-baseline\n"
+        << "# options " << optionsLine(options) << "\n"
+        << "# hardware_threads " << hardwareThreads << "\n"
+        << "# workload threads lines_per_second efficiency peak_rss_kib\n";
+    // Thread counts the machine cannot run in parallel say nothing about scaling
+    for (const Measurement& m : results) {
+        if (m.ok && m.threads <= hardwareThreads) {
+            out << m.workload << " " << m.threads << " " << std::fixed << std::setprecision(0) << m.linesPerSecond
+                << " " << std::setprecision(3) << m.efficiency << " " << m.peakRssKiB << "\n";
+        }
+    }
+    return static_cast<bool>(out);
+}
+
+// Report every measurement outside the baseline's tolerance or missing from it
+int checkBaseline(const std::vector<Measurement>& results, const std::vector<BaselineEntry>& baseline,
+                  double tolerance, std::size_t hardwareThreads) {
+    int regressions = 0;
+    std::cout << "\nBaseline comparison (tolerance " << std::fixed << std::setprecision(0) << tolerance * 100.0 << "%)\n";
+    for (const Measurement& m : results) {
+        std::ostringstream label;
+        label << m.workload << "/" << m.threads;
+        if (m.threads > hardwareThreads) {
+            std::cout << "  " << label.str() << ": more threads than hardware threads, not checked\n";
+            continue;
+        }
+        auto found = std::find_if(baseline.begin(), baseline.end(), [&](const BaselineEntry& entry) {
+            return entry.workload == m.workload && entry.threads == m.threads;
+        });
+        if (found == baseline.end()) {
+            std::cout << "  REGRESSION " << label.str() << ": no baseline row\n";
+            regressions++;
+            continue;
+        }
+        const BaselineEntry& entry = *found;
+        if (!m.ok) {
+            std::cout << "  REGRESSION " << label.str() << ": measurement failed\n";
+            regressions++;
+            continue;
+        }
+
+        std::cout << "  " << std::left << std::setw(16) << label.str() << std::right << std::fixed
+                  << " throughput " << std::showpos << std::setprecision(1)
+                  << (m.linesPerSecond / entry.linesPerSecond - 1.0) * 100.0 << "%" << std::noshowpos
+                  << ", efficiency " << std::setprecision(2) << m.efficiency << " (baseline " << entry.efficiency << ")"
+                  << ", peak RSS " << m.peakRssKiB << " KiB (baseline " << entry.peakRssKiB << ")\n";
+        if (m.efficiency < entry.efficiency * (1.0 - tolerance)) {
+            std::cout << "  REGRESSION " << label.str() << ": parallel efficiency dropped\n";
+            regressions++;
+        }
+        if (m.peakRssKiB > 0 && entry.peakRssKiB > 0 &&
+            static_cast<double>(m.peakRssKiB) > static_cast<double>(entry.peakRssKiB) * (1.0 + tolerance)) {
+            std::cout << "  REGRESSION " << label.str() << ": peak RSS grew\n";
+            regressions++;
+        }
+    }
+    return regressions;
+}
+
+bool startsWith(const std::string& text, const std::string& prefix) {
+    return text.compare(0, prefix.size(), prefix) == 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    SyntheticSourceOptions options;
+    std::size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t maxThreads = hardwareThreads;
+    double minSeconds = 0.5;
+    double tolerance = 0.15;
+    std::string baselinePath;
+    std::string writePath;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            const std::string arg = argv[i];
+            const std::string value = arg.substr(arg.find('=') + 1);
+            if (startsWith(arg, "--files=")) {
+                options.fileCount = std::stoul(value);
+            } else if (startsWith(arg, "--lines=")) {
+                options.linesPerFile = std::stoul(value);
+            } else if (startsWith(arg, "--depth=")) {
+                options.nestingDepth = std::stoul(value);
+            } else if (startsWith(arg, "--comments=")) {
+                options.commentDensity = std::stod(value);
+            } else if (startsWith(arg, "--seed=")) {
+                options.seed = std::stoull(value);
+            } else if (startsWith(arg, "--max-threads=")) {
+                maxThreads = std::max<std::size_t>(1, std::stoul(value));
+            } else if (startsWith(arg, "--min-time=")) {
+                minSeconds = std::stod(value);
+            } else if (startsWith(arg, "--baseline=")) {
+                baselinePath = value;
+            } else if (startsWith(arg, "--tolerance=")) {
+                tolerance = std::stod(value);
+            } else if (startsWith(arg, "--write-baseline=")) {
+                writePath = value;
+            } else {
+                throw std::invalid_argument(arg);
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Usage: " << argv[0] << " [--files=N] [--lines=N] [--depth=N] [--comments=F] [--seed=N]"
+                  << " [--max-threads=N] [--min-time=SECONDS] [--baseline=FILE] [--tolerance=F]"
+                  << " [--write-baseline=FILE]\n";
+        return 1;
+    }
+    if (options.linesPerFile < 4) {
+        std::cerr << "--lines must be at least 4\n";
+        return 1;
+    }
+
+    // Thread counts up to this are checked against, and recorded in, a baseline
+    const std::size_t checkedThreads = std::min(hardwareThreads, maxThreads);
+    if (!writePath.empty() && checkedThreads < 2) {
+        std::cerr << "A scaling baseline needs at least 2 hardware threads; record it on the machine that runs the check\n";
+        return 1;
+    }
+
+    std::string baselineOptions;
+    std::size_t baselineThreads = 0;
+    std::vector<BaselineEntry> baseline;
+    if (!baselinePath.empty()) {
+        if (!readBaseline(baselinePath, baselineOptions, baselineThreads, baseline)) {
+            std::cerr << "Failed to read " << baselinePath << "\n";
+            return 1;
+        }
+        if (baselineOptions != optionsLine(options)) {
+            std::cerr << "Baseline was recorded with " << baselineOptions << ", not " << optionsLine(options) << "\n";
+            return 1;
+        }
+        // Efficiency depends on the machine's core count, so a baseline only
+        // checks runs over exactly the thread counts it was recorded with
+        if (baselineThreads < 2) {
+            std::cerr << "Baseline covers " << baselineThreads << " thread(s) and checks no scaling; "
+                      << "record one with --write-baseline on a machine with at least 2 hardware threads\n";
+            return 1;
+        }
+        if (baselineThreads != checkedThreads) {
+            std::cerr << "Baseline was recorded with " << baselineThreads << " hardware threads, but this run covers "
+                      << checkedThreads << "; run the check on the machine that recorded it\n";
+            return 1;
+        }
+    }
+
+    const std::filesystem::path root = std::filesystem::temp_directory_path() /
+                                       ("ccsl_scaling_" + std::to_string(options.seed));
+    std::filesystem::remove_all(root);
+    const std::size_t lines = SyntheticSourceGenerator(options).writeTree(root);
+    std::cout << "Synthetic tree: " << optionsLine(options) << " (" << lines << " lines), "
+              << hardwareThreads << " hardware threads\n";
+
+    std::vector<std::size_t> threadCounts;
+    for (std::size_t threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    std::vector<Measurement> results;
+    for (const Workload& workload : makeWorkloads(root, options)) {
+        double single = 0.0;
+        for (std::size_t threads : threadCounts) {
+            if (!workload.parallel && threads > 1) {
+                break;
+            }
+            Measurement m = measure(workload, threads, minSeconds);
+            if (threads == 1) {
+                single = m.linesPerSecond;
+            }
+            m.efficiency = single > 0 ? m.linesPerSecond / single / static_cast<double>(threads) : 0.0;
+            results.push_back(m);
+        }
+        printCurve(results, workload.name);
+    }
+    std::filesystem::remove_all(root);
+
+    if (!writePath.empty() && !writeBaseline(writePath, options, results, checkedThreads)) {
+        std::cerr << "Failed to write " << writePath << "\n";
+        return 1;
+    }
+    if (!baselinePath.empty()) {
+        const int regressions = checkBaseline(results, baseline, tolerance, hardwareThreads);
+        if (regressions > 0) {
+            std::cout << regressions << " regression(s) against " << baselinePath << "\n";
+            return 1;
+        }
+        std::cout << "No regressions against " << baselinePath << "\n";
+    }
+    return 0;
+}
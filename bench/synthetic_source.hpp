@@ -0,0 +1,193 @@
+/**
+ * @file synthetic_source.hpp
+ * @brief Deterministic generator of synthetic C++ source trees for benchmarks
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#ifndef CCSL_BENCH_SYNTHETIC_SOURCE_HPP
+#define CCSL_BENCH_SYNTHETIC_SOURCE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace ccsl {
+namespace bench {
+
+/**
+ * @brief Shape of a synthetic source tree
+ */
+struct SyntheticSourceOptions {
+    std::size_t fileCount = 500;      ///< Number of files
+    std::size_t linesPerFile = 200;   ///< Lines of each file
+    std::size_t nestingDepth = 3;     ///< Deepest nesting of blocks inside a function
+    double commentDensity = 0.2;      ///< Fraction of lines that are comments, 0.0 to 1.0
+    std::uint64_t seed = 1;           ///< Seed; the same options always give the same tree
+};
+
+/**
+ * @brief Generates C++ functions with controlled size, nesting and comments
+ *
+ * Comments alternate between line comments and doc blocks with tags,
+ * URLs, standard references and complexity annotations, and the code uses
+ * control statements, advanced keywords and asserts, so every counter of
+ * the lexer has something to count.
+ *
+ * Only std::mt19937_64 output is used, never a standard distribution,
+ * because the engine's sequence is fixed by the standard and the
+ * distributions are not. The same options give byte-identical files with
+ * every compiler and standard library, so baselines stay comparable.
+ */
+class SyntheticSourceGenerator {
+public:
+    explicit SyntheticSourceGenerator(const SyntheticSourceOptions& options) : m_options(options) {}
+
+    /**
+     * @brief Generate one file
+     * @param index Index of the file; each index has its own contents
+     * @return Exactly linesPerFile lines of C++
+     */
+    std::string generateFile(std::size_t index) const {
+        std::mt19937_64 random(m_options.seed * 0x9e3779b97f4a7c15ull + index);
+        std::string out;
+        std::size_t lines = 0;
+        std::size_t function = 0;
+
+        auto emit = [&](std::size_t depth, const std::string& text) {
+            out.append(4 * depth, ' ');
+            out += text;
+            out += '\n';
+            lines++;
+        };
+        auto next = [&](std::uint64_t bound) { return random() % bound; };
+        auto chance = [&](double probability) {
+            return static_cast<double>(random() >> 11) * 0x1.0p-53 < probability;
+        };
+
+        // Each function needs room for a comment, its header, its return and its closing brace
+        while (lines + 4 <= m_options.linesPerFile) {
+            const std::string name = "step" + std::to_string(index) + "_" + std::to_string(function++);
+            if (chance(m_options.commentDensity)) {
+                if (lines + 8 <= m_options.linesPerFile && next(2) == 0) {
+                    emit(0, "/**");
+                    emit(0, " * @brief Advance the state by one " + name + " round - O(n)");
+                    emit(0, " * @param a The state to advance");
+                    emit(0, " * @see https://example.com/" + name + " and RFC " + std::to_string(1000 + next(9000)));
+                    emit(0, " */");
+                } else {
+                    emit(0, "// Advances the state by one " + name + " round");
+                }
+            }
+            emit(0, "auto " + name + "(int a, int b) noexcept {");
+
+            std::size_t depth = 1;
+            // Leaves room to close every open block and the function
+            while (lines + depth + 2 < m_options.linesPerFile && next(24) != 0) {
+                if (chance(m_options.commentDensity)) {
+                    emit(depth, "// Keep a and b within range (" + std::to_string(next(100)) + ")");
+                    continue;
+                }
+                const std::string bound = std::to_string(next(64));
+                switch (next(depth <= m_options.nestingDepth ? 7 : 4)) {
+                    case 0:
+                        emit(depth, "a = (a * " + bound + " + b) % 1021;");
+                        break;
+                    case 1:
+                        emit(depth, "b ^= a << " + std::to_string(next(8)) + ";");
+                        break;
+                    case 2:
+                        emit(depth, "assert(a != " + bound + ");");
+                        break;
+                    case 3:
+                        if (depth > 1) {
+                            emit(--depth, "}");
+                        } else {
+                            emit(depth, "a += std::abs(b - " + bound + ");");
+                        }
+                        break;
+                    case 4:
+                        emit(depth++, "if (a > " + bound + " && b != 0) {");
+                        break;
+                    case 5:
+                        emit(depth++, "for (auto i = 0; i < " + bound + "; i++) {");
+                        break;
+                    default:
+                        emit(depth++, "while (b-- > " + bound + ") {");
+                        break;
+                }
+            }
+            while (depth > 1) {
+                emit(--depth, "}");
+            }
+            emit(1, "return a + b;");
+            emit(0, "}");
+        }
+        while (lines < m_options.linesPerFile) {
+            emit(0, "");
+        }
+        return out;
+    }
+
+    /**
+     * @brief Generate one code fragment of about a given size
+     * @param bytes Size of the fragment
+     * @return Consecutive files, starting with file 0, cut after the last
+     *         whole line that fits in bytes
+     */
+    std::string generateFragment(std::size_t bytes) const {
+        std::string fragment;
+        for (std::size_t i = 0; fragment.size() < bytes; i++) {
+            fragment += generateFile(i);
+        }
+        const std::size_t lastLine = fragment.rfind('\n', bytes - 1);
+        fragment.resize(lastLine != std::string::npos ? lastLine + 1 : bytes);
+        return fragment;
+    }
+
+    /**
+     * @brief Get the path of a file relative to the tree's root
+     * @param index Index of the file
+     * @return The path, spread over subdirectories of 100 files each
+     */
+    static std::filesystem::path relativePath(std::size_t index) {
+        return std::filesystem::path("dir" + std::to_string(index / 100)) / ("file" + std::to_string(index) + ".cpp");
+    }
+
+    /**
+     * @brief Write the whole tree
+     * @param root Directory to write into; created if missing
+     * @return Total number of lines written
+     */
+    std::size_t writeTree(const std::filesystem::path& root) const {
+        for (std::size_t i = 0; i < m_options.fileCount; i++) {
+            const std::filesystem::path path = root / relativePath(i);
+            std::filesystem::create_directories(path.parent_path());
+            std::ofstream(path, std::ios::binary) << generateFile(i);
+        }
+        return m_options.fileCount * m_options.linesPerFile;
+    }
+
+    const SyntheticSourceOptions& getOptions() const { return m_options; }
+
+private:
+    SyntheticSourceOptions m_options; ///< Shape of the tree
+};
+
+/**
+ * @brief Generate a code fragment for the micro benchmarks
+ * @param bytes Size of the fragment
+ * @return Files of 40 lines in the default shape, cut to about bytes
+ */
+inline std::string makeFragment(std::size_t bytes) {
+    SyntheticSourceOptions options;
+    options.linesPerFile = 40;
+    return SyntheticSourceGenerator(options).generateFragment(bytes);
+}
+
+} // namespace bench
+} // namespace ccsl
+
+#endif // CCSL_BENCH_SYNTHETIC_SOURCE_HPP
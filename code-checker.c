@@ -4,580 +4,561 @@
  * @author Shyamal Chandra (C) 2025
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdarg.h>
 #include <ctype.h>
 #include <time.h>
+#include <errno.h>
+#include <pthread.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <ccsl/c_api.h>
 
-/* Maximum file size to read */
-#define MAX_FILE_SIZE 1048576 /* 1MB */
+/* Files in flight per worker; bounds memory held by finished but unprinted results */
+#define JOBS_PER_WORKER 4
 
-/* Metric types */
+/* Report formats */
 typedef enum {
-    METRIC_IMPACT = 0,
-    METRIC_SIMPLICITY = 1,
-    METRIC_CLEANNESS = 2,
-    METRIC_COMMENT = 3,
-    METRIC_CREDITABILITY = 4,
-    METRIC_NOVELTY = 5,
-    METRIC_COUNT = 6
-} metric_type_t;
-
-/* Metric scores */
+    OUTPUT_TEXT,    /* Human-readable report per file */
+    OUTPUT_NDJSON   /* One JSON object per line */
+} output_format_t;
+
+/* Growable output buffer, so workers can format results without printing */
+typedef struct {
+    char *data;
+    size_t length;
+    size_t capacity;
+} string_buffer_t;
+
+/* List of files to analyze, in output order */
+typedef struct {
+    char **paths;
+    size_t count;
+    size_t capacity;
+} file_list_t;
+
+/* State shared between the workers and the printing thread */
 typedef struct {
-    double scores[METRIC_COUNT];
-    char *rationales[METRIC_COUNT];
-} metric_scores_t;
+    const file_list_t *files;
+    string_buffer_t *outputs;   /* One formatted result per file */
+    int *done;                  /* Set once outputs[i] is complete */
+    size_t next_job;            /* Next file to hand to a worker */
+    size_t next_print;          /* Next file to print */
+    size_t window;              /* Maximum files started but not printed */
+    pthread_mutex_t mutex;
+    pthread_cond_t job_done;    /* Signals the printer */
+    pthread_cond_t slot_free;   /* Signals the workers */
+} job_queue_t;
+
+/* Shared by all workers; set up before any starts */
+static ccsl_evaluator_t *evaluator = NULL;
+static output_format_t output_format = OUTPUT_TEXT;
+static int analyze_all = 0;   /* Score files the classifier would skip */
 
 /* Function prototypes */
-char* read_file(const char *filename);
-metric_scores_t evaluate_code(const char *code);
-double calculate_impact(const char *code);
-double calculate_simplicity(const char *code);
-double calculate_cleanness(const char *code);
-double calculate_comment(const char *code);
-double calculate_creditability(const char *code);
-double calculate_novelty(const char *code);
-void print_results(const metric_scores_t *scores);
-void free_scores(metric_scores_t *scores);
-char* generate_rationale(metric_type_t type, double score);
+void print_results(string_buffer_t *out, const ccsl_scores_t *scores);
+void print_json(string_buffer_t *out, const char *filename, const ccsl_scores_t *scores);
+void print_json_skipped(string_buffer_t *out, const char *filename, int verdict);
+void analyze_file(string_buffer_t *out, const char *filename);
+void buffer_printf(string_buffer_t *out, const char *format, ...);
+int collect_path(file_list_t *files, const char *path);
+int collect_list(file_list_t *files, FILE *list);
+int run_serial(const file_list_t *files);
+int run_parallel(const file_list_t *files, int workers);
+void print_usage(const char *program);
 
 int main(int argc, char *argv[]) {
-    /* Check arguments */
-    if (argc < 2) {
-        printf("Usage: %s <file1> [file2] ...\n", argv[0]);
-        return 1;
-    }
+    file_list_t files = {NULL, 0, 0};
+    int workers = 1;
+    int have_inputs = 0;
 
-    /* Process each file */
+    /* Parse arguments */
     for (int i = 1; i < argc; i++) {
-        printf("\nAnalyzing file: %s\n", argv[i]);
-        printf("====================\n");
-        
-        /* Read the file */
-        char *code = read_file(argv[i]);
-        if (!code) {
-            printf("Error: Failed to read file '%s'\n", argv[i]);
-            continue;
+        if (strncmp(argv[i], "-j", 2) == 0) {
+            const char *value = argv[i][2] ? argv[i] + 2 : (i + 1 < argc ? argv[++i] : NULL);
+            char *end = NULL;
+            long count = value ? strtol(value, &end, 10) : -1;
+            if (!value || *end != '\0' || count < 0 || count > 1024) {
+                fprintf(stderr, "Invalid worker count for -j\n");
+                return 1;
+            }
+
+            /* -j 0 uses one worker per online CPU */
+            if (count == 0) {
+                long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+                count = cpus > 0 ? cpus : 1;
+            }
+            workers = (int)count;
+        } else if (strcmp(argv[i], "--format") == 0 || strncmp(argv[i], "--format=", 9) == 0) {
+            const char *value = argv[i][8] ? argv[i] + 9 : (i + 1 < argc ? argv[++i] : NULL);
+            if (value && strcmp(value, "text") == 0) {
+                output_format = OUTPUT_TEXT;
+            } else if (value && strcmp(value, "ndjson") == 0) {
+                output_format = OUTPUT_NDJSON;
+            } else {
+                fprintf(stderr, "Invalid output format for --format\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--all") == 0) {
+            analyze_all = 1;
+        } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else if (strcmp(argv[i], "-") == 0) {
+            have_inputs = 1;
+            if (collect_list(&files, stdin) != 0) {
+                return 1;
+            }
+        } else {
+            have_inputs = 1;
+            if (collect_path(&files, argv[i]) != 0) {
+                return 1;
+            }
         }
-        
-        /* Evaluate code */
-        metric_scores_t scores = evaluate_code(code);
-        
-        /* Print results */
-        print_results(&scores);
-        
-        /* Clean up */
-        free_scores(&scores);
-        free(code);
     }
-    
-    return 0;
-}
 
-/* Read a file into memory */
-char* read_file(const char *filename) {
-    FILE *file = fopen(filename, "r");
-    if (!file) return NULL;
-    
-    /* Get file size */
-    fseek(file, 0, SEEK_END);
-    long size = ftell(file);
-    fseek(file, 0, SEEK_SET);
-    
-    /* Limit file size */
-    if (size > MAX_FILE_SIZE) {
-        fprintf(stderr, "File too large: %s\n", filename);
-        fclose(file);
-        return NULL;
+    /* Check arguments */
+    if (!have_inputs) {
+        print_usage(argv[0]);
+        return 1;
     }
-    
-    /* Allocate memory for file content */
-    char *buffer = (char *) malloc(size + 1);
-    if (!buffer) {
-        fclose(file);
-        return NULL;
+
+    evaluator = ccsl_evaluator_create();
+    int status = 1;
+    if (!evaluator) {
+        fprintf(stderr, "Out of memory\n");
+    } else {
+        status = workers > 1 && files.count > 1 ? run_parallel(&files, workers) : run_serial(&files);
+        ccsl_evaluator_destroy(evaluator);
     }
-    
-    /* Read file content */
-    size_t read_size = fread(buffer, 1, size, file);
-    buffer[read_size] = '\0';
-    
-    fclose(file);
-    return buffer;
-}
 
-/* Evaluate code using all metrics */
-metric_scores_t evaluate_code(const char *code) {
-    metric_scores_t scores;
-    
-    /* Calculate scores for each metric */
-    scores.scores[METRIC_IMPACT] = calculate_impact(code);
-    scores.scores[METRIC_SIMPLICITY] = calculate_simplicity(code);
-    scores.scores[METRIC_CLEANNESS] = calculate_cleanness(code);
-    scores.scores[METRIC_COMMENT] = calculate_comment(code);
-    scores.scores[METRIC_CREDITABILITY] = calculate_creditability(code);
-    scores.scores[METRIC_NOVELTY] = calculate_novelty(code);
-    
-    /* Generate rationales */
-    for (int i = 0; i < METRIC_COUNT; i++) {
-        scores.rationales[i] = generate_rationale((metric_type_t)i, scores.scores[i]);
+    for (size_t i = 0; i < files.count; i++) {
+        free(files.paths[i]);
     }
-    
-    return scores;
+    free(files.paths);
+
+    return status;
 }
 
-/* Calculate Impact metric (0.0 - 1.0) */
-double calculate_impact(const char *code) {
-    double score = 0.0;
-    int total_lines = 0;
-    int function_calls = 0;
-    int control_statements = 0;
-    
-    /* Count lines */
-    const char *ptr = code;
-    while (*ptr) {
-        if (*ptr == '\n') total_lines++;
-        ptr++;
+/* Print command-line usage */
+void print_usage(const char *program) {
+    printf("Usage: %s [-j N] [--format text|ndjson] [--all] <file|directory|-> ...\n", program);
+    printf("  -j N       Analyze N files in parallel (0 = one per CPU)\n");
+    printf("  --format   Print a text report per file (default) or one JSON object per line\n");
+    printf("  --all      Also analyze binary, minified and non-C-family files instead of skipping them\n");
+    printf("  directory  Analyze every regular file below it, in name order\n");
+    printf("  -          Read a newline-separated list of files from stdin\n");
+}
+
+/* Append formatted text to an output buffer */
+void buffer_printf(string_buffer_t *out, const char *format, ...) {
+    va_list args;
+
+    va_start(args, format);
+    int needed = vsnprintf(NULL, 0, format, args);
+    va_end(args);
+    if (needed < 0) return;
+
+    if (out->length + (size_t)needed + 1 > out->capacity) {
+        size_t capacity = out->capacity ? out->capacity : 1024;
+        while (out->length + (size_t)needed + 1 > capacity) capacity *= 2;
+
+        char *data = realloc(out->data, capacity);
+        if (!data) return;
+        out->data = data;
+        out->capacity = capacity;
     }
-    
-    /* Count function calls */
-    ptr = code;
-    while ((ptr = strstr(ptr, "("))) {
-        /* Check if it's likely a function call */
-        if (ptr > code && isalpha(*(ptr-1))) {
-            function_calls++;
+
+    va_start(args, format);
+    vsnprintf(out->data + out->length, out->capacity - out->length, format, args);
+    va_end(args);
+    out->length += (size_t)needed;
+}
+
+/* Add a path to the file list, taking ownership of it */
+static int append_file(file_list_t *files, char *path) {
+    if (files->count == files->capacity) {
+        size_t capacity = files->capacity ? files->capacity * 2 : 64;
+        char **paths = realloc(files->paths, capacity * sizeof(char *));
+        if (!paths) {
+            free(path);
+            fprintf(stderr, "Out of memory\n");
+            return -1;
         }
-        ptr++;
+        files->paths = paths;
+        files->capacity = capacity;
     }
-    
-    /* Count control statements */
-    const char *keywords[] = {"if", "for", "while", "switch", "return"};
-    for (int i = 0; i < 5; i++) {
-        const char *p = code;
-        while ((p = strstr(p, keywords[i]))) {
-            /* Check if it's a whole word */
-            if ((p == code || !isalnum(*(p-1))) && 
-                !isalnum(*(p + strlen(keywords[i])))) {
-                control_statements++;
-            }
-            p += strlen(keywords[i]);
-        }
+
+    files->paths[files->count++] = path;
+    return 0;
+}
+
+static int compare_names(const void *a, const void *b) {
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+/* Add a file, or every regular file below a directory, to the file list */
+int collect_path(file_list_t *files, const char *path) {
+    struct stat info;
+    if (stat(path, &info) != 0 || !S_ISDIR(info.st_mode)) {
+        /* Files that can't be read are reported when they are analyzed */
+        char *copy = strdup(path);
+        return copy ? append_file(files, copy) : -1;
     }
-    
-    /* Calculate score */
-    if (total_lines > 0) {
-        double density = (double)(function_calls + control_statements) / total_lines;
-        score = density > 0.5 ? 0.5 + (density - 0.5) * 0.5 : density;
-        
-        /* Cap at 1.0 */
-        if (score > 1.0) score = 1.0;
+
+    DIR *dir = opendir(path);
+    if (!dir) {
+        fprintf(stderr, "Error: Failed to open directory '%s'\n", path);
+        return 0;
     }
-    
-    return score;
-}
 
-/* Calculate Simplicity metric (0.0 - 1.0) */
-double calculate_simplicity(const char *code) {
-    double score = 0.0;
-    int total_lines = 0;
-    int long_lines = 0;
-    int nesting_depth = 0;
-    int max_nesting_depth = 0;
-    
-    /* Count lines and long lines */
-    const char *line_start = code;
-    while (*line_start) {
-        /* Find end of line */
-        const char *line_end = strchr(line_start, '\n');
-        if (!line_end) line_end = line_start + strlen(line_start);
-        
-        int line_length = (int)(line_end - line_start);
-        total_lines++;
-        
-        /* Check if line is long (>80 chars) */
-        if (line_length > 80) {
-            long_lines++;
+    /* Gather and sort the entries so the output order is deterministic */
+    char **names = NULL;
+    size_t count = 0, capacity = 0;
+    struct dirent *entry;
+    while ((entry = readdir(dir))) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
+
+        if (count == capacity) {
+            capacity = capacity ? capacity * 2 : 32;
+            char **grown = realloc(names, capacity * sizeof(char *));
+            if (!grown) break;
+            names = grown;
         }
-        
-        /* Track nesting depth */
-        for (const char *p = line_start; p < line_end; p++) {
-            if (*p == '{') {
-                nesting_depth++;
-                if (nesting_depth > max_nesting_depth) {
-                    max_nesting_depth = nesting_depth;
+        names[count] = strdup(entry->d_name);
+        if (names[count]) count++;
+    }
+    closedir(dir);
+
+    qsort(names, count, sizeof(char *), compare_names);
+
+    int status = 0;
+    size_t path_length = strlen(path);
+    int has_slash = path_length > 0 && path[path_length - 1] == '/';
+    for (size_t i = 0; i < count; i++) {
+        if (status == 0) {
+            size_t length = path_length + strlen(names[i]) + 2;
+            char *child = malloc(length);
+            if (!child) {
+                status = -1;
+            } else {
+                snprintf(child, length, has_slash ? "%s%s" : "%s/%s", path, names[i]);
+
+                struct stat child_info;
+                if (lstat(child, &child_info) == 0 &&
+                    (S_ISDIR(child_info.st_mode) || S_ISREG(child_info.st_mode))) {
+                    /* Symbolic links are skipped so cycles can't recurse forever */
+                    status = S_ISDIR(child_info.st_mode) ? collect_path(files, child)
+                                                         : append_file(files, strdup(child));
                 }
-            } else if (*p == '}') {
-                nesting_depth--;
+                free(child);
             }
         }
-        
-        /* Move to next line */
-        line_start = line_end;
-        if (*line_start == '\n') line_start++;
+        free(names[i]);
     }
-    
-    /* Calculate score */
-    double long_line_penalty = total_lines > 0 ? (double)long_lines / total_lines : 0;
-    double nesting_penalty = max_nesting_depth > 3 ? (max_nesting_depth - 3) * 0.1 : 0;
-    
-    score = 1.0 - long_line_penalty - nesting_penalty;
-    
-    /* Ensure score is in range */
-    if (score < 0.0) score = 0.0;
-    if (score > 1.0) score = 1.0;
-    
-    return score;
+    free(names);
+
+    return status;
 }
 
-/* Calculate Cleanness metric (0.0 - 1.0) */
-double calculate_cleanness(const char *code) {
-    double score = 0.0;
-    int total_lines = 0;
-    int indented_lines = 0;
-    int consistent_spacing = 0;
-    int inconsistent_spacing = 0;
-    
-    /* Count lines and check indentation */
-    const char *line_start = code;
-    while (*line_start) {
-        /* Find end of line */
-        const char *line_end = strchr(line_start, '\n');
-        if (!line_end) line_end = line_start + strlen(line_start);
-        
-        total_lines++;
-        
-        /* Check if line is indented correctly */
-        int spaces = 0;
-        for (const char *p = line_start; p < line_end && isspace(*p); p++) {
-            if (*p == ' ') spaces++;
-        }
-        
-        /* Consider lines with multiple of 2 or 4 spaces as properly indented */
-        if (spaces > 0 && (spaces % 2 == 0 || spaces % 4 == 0)) {
-            indented_lines++;
+/* Add every line of a file list to the file list */
+int collect_list(file_list_t *files, FILE *list) {
+    char *line = NULL;
+    size_t capacity = 0;
+    ssize_t length;
+
+    while ((length = getline(&line, &capacity, list)) != -1) {
+        while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) {
+            line[--length] = '\0';
         }
-        
-        /* Check operator spacing */
-        for (const char *p = line_start; p < line_end; p++) {
-            if (*p == '=' || *p == '+' || *p == '-' || *p == '*' || *p == '/') {
-                if ((p > line_start && *(p-1) == ' ' && *(p+1) == ' ') ||
-                    (*(p+1) != ' ' && *(p-1) != ' ')) {
-                    consistent_spacing++;
-                } else {
-                    inconsistent_spacing++;
-                }
-            }
+        if (length == 0) continue;
+
+        if (collect_path(files, line) != 0) {
+            free(line);
+            return -1;
         }
-        
-        /* Move to next line */
-        line_start = line_end;
-        if (*line_start == '\n') line_start++;
     }
-    
-    /* Calculate score */
-    double indentation_score = total_lines > 0 ? (double)indented_lines / total_lines : 0;
-    double spacing_score = (consistent_spacing + inconsistent_spacing) > 0 ? 
-                          (double)consistent_spacing / (consistent_spacing + inconsistent_spacing) : 0.5;
-    
-    score = 0.7 * indentation_score + 0.3 * spacing_score;
-    
-    /* Ensure score is in range */
-    if (score < 0.0) score = 0.0;
-    if (score > 1.0) score = 1.0;
-    
-    return score;
+
+    free(line);
+    return 0;
 }
 
-/* Calculate Comment metric (0.0 - 1.0) */
-double calculate_comment(const char *code) {
-    double score = 0.0;
-    int total_lines = 0;
-    int comment_lines = 0;
-    int doc_comment_lines = 0;
-    
-    /* Count lines and comments */
-    const char *line_start = code;
-    int in_comment = 0;  /* 1 for // comments, 2 for /* comments */
-    
-    while (*line_start) {
-        /* Find end of line */
-        const char *line_end = strchr(line_start, '\n');
-        if (!line_end) line_end = line_start + strlen(line_start);
-        
-        total_lines++;
-        
-        /* Skip leading whitespace */
-        const char *p = line_start;
-        while (p < line_end && isspace(*p)) p++;
-        
-        /* Check for comments */
-        if (in_comment == 2) {
-            /* Inside a multi-line comment */
-            comment_lines++;
-            
-            /* Check if this line has a */ closing the comment */
-            const char *end_comment = strstr(line_start, "*/");
-            if (end_comment && end_comment < line_end) {
-                in_comment = 0;
-            }
-            
-            /* Check for doc comment features */
-            if (strstr(line_start, "@param") || strstr(line_start, "@return") ||
-                strstr(line_start, "@brief") || strstr(line_start, "@see")) {
-                doc_comment_lines++;
-            }
+/* Analyze one file and format its report */
+void analyze_file(string_buffer_t *out, const char *filename) {
+    ccsl_scores_t scores;
+    int verdict = CCSL_SOURCE_EVALUATE;
+    /* Classifying first keeps binaries and minified files from stalling a worker */
+    int status = analyze_all ? ccsl_evaluate_file(evaluator, filename, &scores)
+                             : ccsl_evaluate_source_file(evaluator, filename, &scores, &verdict);
+
+    if (output_format == OUTPUT_NDJSON) {
+        if (status == 1) {
+            print_json_skipped(out, filename, verdict);
         } else {
-            /* Check for single-line comments */
-            const char *comment_start = strstr(p, "//");
-            if (comment_start && comment_start < line_end) {
-                comment_lines++;
-            }
-            
-            /* Check for multi-line comment start */
-            comment_start = strstr(p, "/*");
-            if (comment_start && comment_start < line_end) {
-                comment_lines++;
-                in_comment = 2;
-                
-                /* Check for doc comment features */
-                if (*(comment_start+2) == '*') {
-                    /* Doc comment */
-                    doc_comment_lines++;
-                }
-                
-                /* Check if the comment ends on the same line */
-                const char *end_comment = strstr(comment_start + 2, "*/");
-                if (end_comment && end_comment < line_end) {
-                    in_comment = 0;
-                }
-            }
+            print_json(out, filename, status == 0 ? &scores : NULL);
         }
-        
-        /* Move to next line */
-        line_start = line_end;
-        if (*line_start == '\n') line_start++;
+        return;
     }
-    
-    /* Calculate score */
-    double comment_ratio = total_lines > 0 ? (double)comment_lines / total_lines : 0;
-    double doc_comment_ratio = comment_lines > 0 ? (double)doc_comment_lines / comment_lines : 0;
-    
-    /* Ideal comment ratio is around 0.2-0.3 (too many or too few comments are not good) */
-    double comment_score = comment_ratio <= 0.3 ? comment_ratio / 0.3 : (1.0 - comment_ratio) / 0.7;
-    
-    score = 0.6 * comment_score + 0.4 * doc_comment_ratio;
-    
-    /* Ensure score is in range */
-    if (score < 0.0) score = 0.0;
-    if (score > 1.0) score = 1.0;
-    
-    return score;
-}
 
-/* Calculate Creditability metric (0.0 - 1.0) */
-double calculate_creditability(const char *code) {
-    double score = 0.0;
-    int total_lines = 0;
-    int has_author = 0;
-    int has_license = 0;
-    int has_version = 0;
-    int has_references = 0;
-    int has_tests = 0;
-    
-    /* Count lines and check creditability markers */
-    const char *ptr = code;
-    total_lines = 0;
-    while (*ptr) {
-        if (*ptr == '\n') total_lines++;
-        ptr++;
-    }
-    
-    /* Check for author information */
-    if (strstr(code, "@author") || strstr(code, "Author:") || 
-        strstr(code, "COPYRIGHT") || strstr(code, "Copyright") || 
-        strstr(code, "(c)") || strstr(code, "(C)")) {
-        has_author = 1;
-    }
-    
-    /* Check for license information */
-    if (strstr(code, "License") || strstr(code, "LICENSE") || 
-        strstr(code, "MIT") || strstr(code, "GPL") || 
-        strstr(code, "Apache") || strstr(code, "CCSL")) {
-        has_license = 1;
+    buffer_printf(out, "\nAnalyzing file: %s\n", filename);
+    buffer_printf(out, "====================\n");
+    if (status == 1) {
+        buffer_printf(out, "Skipped: %s file\n", ccsl_verdict_name(verdict));
+        return;
     }
-    
-    /* Check for version information */
-    if (strstr(code, "@version") || strstr(code, "Version:") || 
-        strstr(code, "v1.") || strstr(code, "v0.")) {
-        has_version = 1;
-    }
-    
-    /* Check for references */
-    if (strstr(code, "@see") || strstr(code, "http://") || 
-        strstr(code, "https://") || strstr(code, "www.")) {
-        has_references = 1;
+    if (status != 0) {
+        buffer_printf(out, "Error: Failed to read file '%s'\n", filename);
+        return;
     }
-    
-    /* Check for tests */
-    if (strstr(code, "test") || strstr(code, "Test") || 
-        strstr(code, "assert") || strstr(code, "Assert") ||
-        strstr(code, "expect") || strstr(code, "should")) {
-        has_tests = 1;
+
+    print_results(out, &scores);
+}
+
+/* Analyze the files one after another */
+int run_serial(const file_list_t *files) {
+    string_buffer_t out = {NULL, 0, 0};
+
+    for (size_t i = 0; i < files->count; i++) {
+        out.length = 0;
+        analyze_file(&out, files->paths[i]);
+        fwrite(out.data, 1, out.length, stdout);
     }
-    
-    /* Calculate score */
-    score = 0.2 * has_author + 0.2 * has_license + 0.2 * has_version + 
-            0.2 * has_references + 0.2 * has_tests;
-    
-    return score;
+
+    free(out.data);
+    return 0;
 }
 
-/* Calculate Novelty metric (0.0 - 1.0) */
-double calculate_novelty(const char *code) {
-    double score = 0.0;
-    int has_templates = 0;
-    int has_lambda = 0;
-    int has_algorithms = 0;
-    int has_concepts = 0;
-    int has_meta = 0;
-    int has_design_patterns = 0;
-    
-    /* Check for templates */
-    if (strstr(code, "template") || strstr(code, "<typename") || 
-        strstr(code, "<class")) {
-        has_templates = 1;
+static void *worker_main(void *arg) {
+    job_queue_t *queue = arg;
+
+    pthread_mutex_lock(&queue->mutex);
+    while (queue->next_job < queue->files->count) {
+        /* Don't run too far ahead of the printer */
+        if (queue->next_job >= queue->next_print + queue->window) {
+            pthread_cond_wait(&queue->slot_free, &queue->mutex);
+            continue;
+        }
+
+        size_t job = queue->next_job++;
+        pthread_mutex_unlock(&queue->mutex);
+
+        analyze_file(&queue->outputs[job], queue->files->paths[job]);
+
+        pthread_mutex_lock(&queue->mutex);
+        queue->done[job] = 1;
+        pthread_cond_signal(&queue->job_done);
     }
-    
-    /* Check for lambda expressions */
-    if (strstr(code, "[]") || strstr(code, "=>") || 
-        strstr(code, "->") || strstr(code, "auto")) {
-        has_lambda = 1;
+    pthread_mutex_unlock(&queue->mutex);
+
+    return NULL;
+}
+
+/* Analyze the files on a pool of workers, printing results in input order */
+int run_parallel(const file_list_t *files, int workers) {
+    job_queue_t queue;
+    queue.files = files;
+    queue.outputs = calloc(files->count, sizeof(string_buffer_t));
+    queue.done = calloc(files->count, sizeof(int));
+    queue.next_job = 0;
+    queue.next_print = 0;
+    queue.window = (size_t)workers * JOBS_PER_WORKER;
+    if (!queue.outputs || !queue.done) {
+        free(queue.outputs);
+        free(queue.done);
+        fprintf(stderr, "Out of memory\n");
+        return 1;
     }
-    
-    /* Check for advanced algorithms */
-    if (strstr(code, "algorithm") || strstr(code, "transform") || 
-        strstr(code, "accumulate") || strstr(code, "fold") ||
-        strstr(code, "recursive")) {
-        has_algorithms = 1;
+    pthread_mutex_init(&queue.mutex, NULL);
+    pthread_cond_init(&queue.job_done, NULL);
+    pthread_cond_init(&queue.slot_free, NULL);
+
+    pthread_t *threads = malloc((size_t)workers * sizeof(pthread_t));
+    int started = 0;
+    for (int i = 0; threads && i < workers; i++) {
+        if (pthread_create(&threads[i], NULL, worker_main, &queue) != 0) break;
+        started++;
     }
-    
-    /* Check for concepts (C++20) */
-    if (strstr(code, "concept") || strstr(code, "requires") || 
-        strstr(code, "std::same_as") || strstr(code, "std::convertible_to")) {
-        has_concepts = 1;
+
+    if (started == 0) {
+        /* Fall back to the calling thread */
+        free(threads);
+        free(queue.outputs);
+        free(queue.done);
+        pthread_mutex_destroy(&queue.mutex);
+        pthread_cond_destroy(&queue.job_done);
+        pthread_cond_destroy(&queue.slot_free);
+        return run_serial(files);
     }
-    
-    /* Check for metaprogramming */
-    if (strstr(code, "std::enable_if") || strstr(code, "std::conditional") || 
-        strstr(code, "constexpr") || strstr(code, "if constexpr")) {
-        has_meta = 1;
+
+    /* Print each result as soon as it and everything before it is done */
+    for (size_t i = 0; i < files->count; i++) {
+        pthread_mutex_lock(&queue.mutex);
+        while (!queue.done[i]) {
+            pthread_cond_wait(&queue.job_done, &queue.mutex);
+        }
+        pthread_mutex_unlock(&queue.mutex);
+
+        fwrite(queue.outputs[i].data, 1, queue.outputs[i].length, stdout);
+        free(queue.outputs[i].data);
+        queue.outputs[i].data = NULL;
+
+        pthread_mutex_lock(&queue.mutex);
+        queue.next_print = i + 1;
+        pthread_cond_broadcast(&queue.slot_free);
+        pthread_mutex_unlock(&queue.mutex);
     }
-    
-    /* Check for design patterns */
-    if (strstr(code, "Factory") || strstr(code, "Singleton") || 
-        strstr(code, "Observer") || strstr(code, "Strategy") ||
-        strstr(code, "Visitor") || strstr(code, "Adapter")) {
-        has_design_patterns = 1;
+
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
     }
-    
-    /* Calculate score */
-    score = 0.15 * has_templates + 0.15 * has_lambda + 0.20 * has_algorithms + 
-            0.2 * has_concepts + 0.15 * has_meta + 0.15 * has_design_patterns;
-    
-    return score;
+
+    free(threads);
+    free(queue.outputs);
+    free(queue.done);
+    pthread_mutex_destroy(&queue.mutex);
+    pthread_cond_destroy(&queue.job_done);
+    pthread_cond_destroy(&queue.slot_free);
+    return 0;
 }
 
-/* Print evaluation results */
-void print_results(const metric_scores_t *scores) {
-    const char *metric_names[] = {
-        "Impact", "Simplicity", "Cleanness", 
-        "Comment", "Creditability", "Novelty"
-    };
-    
-    printf("CCSL Metric Evaluation Results:\n");
-    printf("-------------------------------\n");
-    
-    double total_score = 0.0;
-    for (int i = 0; i < METRIC_COUNT; i++) {
-        printf("%s: %.2f\n", metric_names[i], scores->scores[i]);
-        printf("  %s\n", scores->rationales[i]);
-        total_score += scores->scores[i];
+/* Format evaluation results */
+void print_results(string_buffer_t *out, const ccsl_scores_t *scores) {
+    buffer_printf(out, "CCSL Metric Evaluation Results:\n");
+    buffer_printf(out, "-------------------------------\n");
+    
+    for (int i = 0; i < CCSL_METRIC_COUNT; i++) {
+        char rationale[256];
+        size_t length = ccsl_format_rationale(evaluator, scores, i, rationale, sizeof(rationale));
+
+        buffer_printf(out, "%s: %.2f\n", ccsl_metric_name(i), scores->values[i]);
+        if (length < sizeof(rationale)) {
+            buffer_printf(out, "  %s\n", rationale);
+        } else {
+            /* Rare long rationales get a buffer of their own */
+            char *full = malloc(length + 1);
+            if (full) ccsl_format_rationale(evaluator, scores, i, full, length + 1);
+            buffer_printf(out, "  %s\n", full ? full : rationale);
+            free(full);
+        }
     }
     
-    double average_score = total_score / METRIC_COUNT;
-    printf("\nOverall Credit Score: %.2f / 1.00\n", average_score);
+    double average_score = ccsl_scores_mean(scores);
+    buffer_printf(out, "\nOverall Credit Score: %.2f / 1.00\n", average_score);
     
     /* Qualitative assessment */
-    printf("Assessment: ");
+    buffer_printf(out, "Assessment: ");
     if (average_score >= 0.9) {
-        printf("Excellent\n");
+        buffer_printf(out, "Excellent\n");
     } else if (average_score >= 0.8) {
-        printf("Very Good\n");
+        buffer_printf(out, "Very Good\n");
     } else if (average_score >= 0.7) {
-        printf("Good\n");
+        buffer_printf(out, "Good\n");
     } else if (average_score >= 0.6) {
-        printf("Above Average\n");
+        buffer_printf(out, "Above Average\n");
     } else if (average_score >= 0.5) {
-        printf("Average\n");
+        buffer_printf(out, "Average\n");
     } else if (average_score >= 0.4) {
-        printf("Below Average\n");
+        buffer_printf(out, "Below Average\n");
     } else if (average_score >= 0.3) {
-        printf("Poor\n");
+        buffer_printf(out, "Poor\n");
     } else {
-        printf("Very Poor\n");
+        buffer_printf(out, "Very Poor\n");
     }
 }
 
-/* Generate a rationale for a metric score */
-char* generate_rationale(metric_type_t type, double score) {
-    char *rationale = malloc(256);
-    if (!rationale) return NULL;
-    
-    const char *high_rationales[] = {
-        "High functional significance with good control flow",
-        "Clean and straightforward implementation, easy to understand",
-        "Well-formatted with consistent style and spacing",
-        "Well-documented with helpful comments at appropriate density",
-        "Includes comprehensive attribution and references",
-        "Uses advanced language features and design patterns"
-    };
-    
-    const char *medium_rationales[] = {
-        "Moderate functional significance with acceptable control flow",
-        "Reasonably clear implementation with some complexity",
-        "Generally consistent formatting with minor inconsistencies",
-        "Contains some useful comments but could be improved",
-        "Includes some attribution information",
-        "Uses some modern language features"
-    };
-    
-    const char *low_rationales[] = {
-        "Limited functional significance with unclear control flow",
-        "Overly complex or confusing implementation",
-        "Inconsistent formatting and style",
-        "Lacks sufficient commenting or has too many unhelpful comments",
-        "Missing attribution and references",
-        "Uses only basic language features"
-    };
-    
-    const char **rationales;
-    if (score >= 0.7) {
-        rationales = high_rationales;
-    } else if (score >= 0.4) {
-        rationales = medium_rationales;
-    } else {
-        rationales = low_rationales;
+/* Append a JSON string literal */
+/* Length of the well-formed UTF-8 sequence at p, or 0 if it is not one;
+ * overlong forms, surrogates and code points past U+10FFFF are invalid */
+static size_t utf8_sequence_length(const unsigned char *p) {
+    if (p[0] < 0x80) return 1;
+    if (p[0] >= 0xc2 && p[0] <= 0xdf) {
+        return (p[1] & 0xc0) == 0x80 ? 2 : 0;
     }
-    
-    snprintf(rationale, 256, "%s", rationales[type]);
-    return rationale;
+    if (p[0] >= 0xe0 && p[0] <= 0xef) {
+        unsigned char min = p[0] == 0xe0 ? 0xa0 : 0x80;
+        unsigned char max = p[0] == 0xed ? 0x9f : 0xbf;
+        return p[1] >= min && p[1] <= max && (p[2] & 0xc0) == 0x80 ? 3 : 0;
+    }
+    if (p[0] >= 0xf0 && p[0] <= 0xf4) {
+        unsigned char min = p[0] == 0xf0 ? 0x90 : 0x80;
+        unsigned char max = p[0] == 0xf4 ? 0x8f : 0xbf;
+        return p[1] >= min && p[1] <= max && (p[2] & 0xc0) == 0x80 && (p[3] & 0xc0) == 0x80 ? 4 : 0;
+    }
+    return 0;
+}
+
+/* Paths are arbitrary bytes, but JSON text must be UTF-8, so each byte
+ * that is not part of a well-formed sequence becomes U+FFFD */
+static void buffer_print_json_string(string_buffer_t *out, const char *text) {
+    buffer_printf(out, "\"");
+    const unsigned char *p = (const unsigned char *)text;
+    while (*p) {
+        /* Copy runs that need no escaping in one go; the NUL terminator
+         * stops utf8_sequence_length() before it reads past the string */
+        size_t run = 0;
+        size_t length;
+        while (p[run] && p[run] != '"' && p[run] != '\\' && p[run] >= 0x20 &&
+               (length = utf8_sequence_length(p + run)) > 0) {
+            run += length;
+        }
+        if (run > 0) {
+            buffer_printf(out, "%.*s", (int)run, (const char *)p);
+            p += run;
+        } else if (*p == '"' || *p == '\\') {
+            buffer_printf(out, "\\%c", *p++);
+        } else if (*p < 0x20) {
+            buffer_printf(out, "\\u%04x", *p++);
+        } else {
+            buffer_printf(out, "\\ufffd");
+            p++;
+        }
+    }
+    buffer_printf(out, "\"");
 }
 
-/* Free resources used by metric scores */
-void free_scores(metric_scores_t *scores) {
-    for (int i = 0; i < METRIC_COUNT; i++) {
-        free(scores->rationales[i]);
+/* Append a number that parses back to exactly the same double */
+static void buffer_print_json_number(string_buffer_t *out, double value) {
+    char text[32];
+    snprintf(text, sizeof(text), "%.15g", value);
+    if (strtod(text, NULL) != value) {
+        snprintf(text, sizeof(text), "%.17g", value);
     }
-}
\ No newline at end of file
+    buffer_printf(out, "%s", text);
+}
+
+/* Format evaluation results as one JSON line; scores is NULL if the file could not be read */
+void print_json(string_buffer_t *out, const char *filename, const ccsl_scores_t *scores) {
+    const char *keys[CCSL_METRIC_COUNT] = {
+        "impact", "simplicity", "cleanness", "comment", "creditability", "novelty"
+    };
+
+    buffer_printf(out, "{\"file\":");
+    buffer_print_json_string(out, filename);
+    if (!scores) {
+        buffer_printf(out, ",\"error\":\"Failed to read file\"}\n");
+        return;
+    }
+
+    buffer_printf(out, ",\"version\":%u,\"scores\":{", ccsl_evaluator_version());
+    for (int i = 0; i < CCSL_METRIC_COUNT; i++) {
+        buffer_printf(out, "%s\"%s\":", i > 0 ? "," : "", keys[i]);
+        buffer_print_json_number(out, scores->values[i]);
+    }
+    buffer_printf(out, "},\"overall\":");
+    buffer_print_json_number(out, ccsl_scores_mean(scores));
+    buffer_printf(out, "}\n");
+}
+
+/* Print one JSON line for a file the classifier skipped */
+void print_json_skipped(string_buffer_t *out, const char *filename, int verdict) {
+    buffer_printf(out, "{\"file\":");
+    buffer_print_json_string(out, filename);
+    buffer_printf(out, ",\"skipped\":");
+    buffer_print_json_string(out, ccsl_verdict_name(verdict));
+    buffer_printf(out, "}\n");
+}
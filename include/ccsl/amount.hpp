@@ -0,0 +1,120 @@
+/**
+ * @file amount.hpp
+ * @brief Exact Bitcoin amounts as a whole number of satoshis
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#ifndef CCSL_AMOUNT_HPP
+#define CCSL_AMOUNT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <optional>
+
+namespace ccsl {
+
+/**
+ * @brief Number of satoshis in one bitcoin
+ */
+constexpr std::int64_t kSatoshisPerBitcoin = 100000000;
+
+/**
+ * @brief A Bitcoin amount counted in satoshis (1e-8 BTC)
+ *
+ * Sums of satoshis are exact, unlike sums of double bitcoin amounts, and
+ * integer arithmetic is cheaper. Construction from a plain number is
+ * explicit so satoshis and bitcoins cannot be mixed up silently.
+ */
+class Satoshis {
+public:
+    constexpr Satoshis() = default;
+
+    /**
+     * @brief Create an amount from a number of satoshis
+     * @param satoshis The number of satoshis
+     */
+    constexpr explicit Satoshis(std::int64_t satoshis) : m_satoshis(satoshis) {}
+
+    /**
+     * @brief Convert an amount in bitcoins, rounding to the nearest satoshi
+     * @param bitcoins The amount in bitcoins
+     * @return The amount in satoshis
+     * @throws std::invalid_argument if bitcoins is not finite or out of range
+     */
+    static Satoshis fromBitcoins(double bitcoins);
+
+    /**
+     * @brief Convert a payment amount in bitcoins, rounding to the nearest satoshi
+     * @param bitcoins The amount in bitcoins
+     * @return The amount, or nothing if it is NaN, out of range or rounds to
+     *         zero or less
+     */
+    static std::optional<Satoshis> tryFromBitcoins(double bitcoins);
+
+    /**
+     * @brief Get the number of satoshis
+     * @return The amount in satoshis
+     */
+    constexpr std::int64_t getSatoshis() const { return m_satoshis; }
+
+    /**
+     * @brief Convert to bitcoins
+     * @return The nearest double to the amount in bitcoins
+     */
+    constexpr double toBitcoins() const { return static_cast<double>(m_satoshis) / kSatoshisPerBitcoin; }
+
+    /**
+     * @brief Add another amount if the sum fits
+     * @param other The amount to add
+     * @return False, leaving this amount unchanged, if the sum would overflow
+     */
+    constexpr bool tryAdd(Satoshis other) {
+        if ((other.m_satoshis > 0 && m_satoshis > std::numeric_limits<std::int64_t>::max() - other.m_satoshis) ||
+            (other.m_satoshis < 0 && m_satoshis < std::numeric_limits<std::int64_t>::min() - other.m_satoshis)) {
+            return false;
+        }
+        m_satoshis += other.m_satoshis;
+        return true;
+    }
+
+    constexpr Satoshis& operator+=(Satoshis other) { m_satoshis += other.m_satoshis; return *this; }
+    constexpr Satoshis& operator-=(Satoshis other) { m_satoshis -= other.m_satoshis; return *this; }
+    friend constexpr Satoshis operator+(Satoshis a, Satoshis b) { return a += b; }
+    friend constexpr Satoshis operator-(Satoshis a, Satoshis b) { return a -= b; }
+    friend constexpr bool operator==(Satoshis a, Satoshis b) { return a.m_satoshis == b.m_satoshis; }
+    friend constexpr bool operator!=(Satoshis a, Satoshis b) { return a.m_satoshis != b.m_satoshis; }
+    friend constexpr bool operator<(Satoshis a, Satoshis b) { return a.m_satoshis < b.m_satoshis; }
+    friend constexpr bool operator<=(Satoshis a, Satoshis b) { return a.m_satoshis <= b.m_satoshis; }
+    friend constexpr bool operator>(Satoshis a, Satoshis b) { return a.m_satoshis > b.m_satoshis; }
+    friend constexpr bool operator>=(Satoshis a, Satoshis b) { return a.m_satoshis >= b.m_satoshis; }
+
+private:
+    std::int64_t m_satoshis = 0; ///< The amount in satoshis
+};
+
+/**
+ * @brief Most characters formatSatoshis() writes
+ */
+constexpr std::size_t kMaxBitcoinAmountChars = 21;
+
+/**
+ * @brief Format an amount in bitcoins with exactly 8 decimals, e.g. "-0.00100000"
+ * @param amount The amount
+ * @param buffer Receives the text, without terminator; at least kMaxBitcoinAmountChars long
+ * @return Number of characters written
+ */
+std::size_t formatSatoshis(Satoshis amount, char* buffer);
+
+/**
+ * @brief Write an amount in bitcoins with exactly 8 decimals
+ * @param out The stream
+ * @param amount The amount
+ * @return The stream
+ */
+std::ostream& operator<<(std::ostream& out, Satoshis amount);
+
+} // namespace ccsl
+
+#endif // CCSL_AMOUNT_HPP
@@ -0,0 +1,55 @@
+/**
+ * @file bitcoin_address.hpp
+ * @brief Bitcoin address decoding: Base58Check, Bech32 and Bech32m
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#ifndef CCSL_BITCOIN_ADDRESS_HPP
+#define CCSL_BITCOIN_ADDRESS_HPP
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace ccsl {
+
+/**
+ * @brief Kinds of mainnet Bitcoin address
+ */
+enum class BitcoinAddressType {
+    P2PKH,           ///< Base58Check with version 0x00, starts with "1"
+    P2SH,            ///< Base58Check with version 0x05, starts with "3"
+    P2WPKH,          ///< Bech32, witness version 0 with a 20-byte program
+    P2WSH,           ///< Bech32, witness version 0 with a 32-byte program
+    P2TR,            ///< Bech32m, witness version 1 with a 32-byte program
+    WITNESS_UNKNOWN  ///< Bech32m, any other witness version 1 to 16 program
+};
+
+/**
+ * @brief A SHA-256 digest
+ */
+using Sha256Digest = std::array<std::uint8_t, 32>;
+
+/**
+ * @brief Calculates the SHA-256 digest of a byte sequence
+ * @param data The bytes to hash
+ * @return The digest
+ */
+Sha256Digest sha256(std::string_view data);
+
+/**
+ * @brief Decodes and checks a mainnet Bitcoin address
+ *
+ * Base58Check addresses must carry a valid double SHA-256 checksum, and
+ * segwit addresses a valid Bech32 (BIP 173) or Bech32m (BIP 350) checksum
+ * with the "bc" prefix. The function does not allocate.
+ *
+ * @param address The address
+ * @return The kind of address, or std::nullopt if it is not a valid mainnet address
+ */
+std::optional<BitcoinAddressType> parseBitcoinAddress(std::string_view address);
+
+} // namespace ccsl
+
+#endif // CCSL_BITCOIN_ADDRESS_HPP
@@ -0,0 +1,152 @@
+/**
+ * @file c_api.h
+ * @brief C interface to the CCSL metric evaluators
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#ifndef CCSL_C_API_H
+#define CCSL_C_API_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number of metrics, as ccsl::kMetricTypeCount
+ */
+#define CCSL_METRIC_COUNT 6
+
+/**
+ * @brief Number of raw counts per metric, as ccsl::MetricCounts
+ */
+#define CCSL_METRIC_COUNTS 3
+
+/**
+ * @brief Verdicts of the source classifier, as ccsl::SourceVerdict
+ */
+#define CCSL_SOURCE_EVALUATE 0     /**< C-family source; scored */
+#define CCSL_SOURCE_NOT_C_FAMILY 1 /**< Extension of a language the evaluators were not made for */
+#define CCSL_SOURCE_BINARY 2       /**< Holds NUL bytes */
+#define CCSL_SOURCE_MINIFIED 3     /**< Lines too long for hand-written code */
+
+/**
+ * @brief Scores of all metrics for one code fragment
+ *
+ * Arrays are indexed like ccsl::metricIndex(): impact, simplicity,
+ * cleanness, comment, creditability, novelty.
+ */
+typedef struct ccsl_scores {
+    double values[CCSL_METRIC_COUNT];                     /**< Score per metric, 0.0 to 1.0 */
+    double counts[CCSL_METRIC_COUNT][CCSL_METRIC_COUNTS]; /**< Raw counts behind each score */
+    unsigned present;                                     /**< Bit per metric that holds a score */
+} ccsl_scores_t;
+
+/**
+ * @brief Opaque handle to a ccsl::MetricsEvaluator
+ *
+ * An evaluator is immutable once created, so one handle may be used from
+ * several threads at once.
+ */
+typedef struct ccsl_evaluator ccsl_evaluator_t;
+
+/**
+ * @brief Create an evaluator for all metrics
+ * @return The evaluator, or NULL if out of memory
+ */
+ccsl_evaluator_t *ccsl_evaluator_create(void);
+
+/**
+ * @brief Destroy an evaluator; NULL is ignored
+ * @param evaluator The evaluator to destroy
+ */
+void ccsl_evaluator_destroy(ccsl_evaluator_t *evaluator);
+
+/**
+ * @brief Get the version of the scoring rules, as ccsl::MetricsEvaluator::kVersion
+ * @return The scoring version
+ */
+unsigned ccsl_evaluator_version(void);
+
+/**
+ * @brief Score a code fragment held in memory
+ * @param evaluator The evaluator
+ * @param code The code; need not be NUL-terminated
+ * @param length Length of the code in bytes
+ * @param scores Receives the scores
+ * @return 0 on success, -1 on failure
+ */
+int ccsl_evaluate(const ccsl_evaluator_t *evaluator, const char *code, size_t length, ccsl_scores_t *scores);
+
+/**
+ * @brief Score the contents of a file
+ * @param evaluator The evaluator
+ * @param path Path of the file
+ * @param scores Receives the scores
+ * @return 0 on success, -1 if the file cannot be read or scored
+ */
+int ccsl_evaluate_file(const ccsl_evaluator_t *evaluator, const char *path, ccsl_scores_t *scores);
+
+/**
+ * @brief Classify code with the default ccsl::SourceClassifier limits
+ * @param path Path or name of the file, used for its extension; may be NULL
+ * @param code The code; need not be NUL-terminated
+ * @param length Length of the code in bytes
+ * @return One of the CCSL_SOURCE_ verdicts, or -1 on invalid arguments
+ */
+int ccsl_classify(const char *path, const char *code, size_t length);
+
+/**
+ * @brief Score the contents of a file unless the classifier rejects it
+ *
+ * Reads the file once, classifies it and only scores C-family source, so
+ * binaries and minified files cost a single pass.
+ *
+ * @param evaluator The evaluator
+ * @param path Path of the file
+ * @param scores Receives the scores if the file is scored
+ * @param verdict Receives the CCSL_SOURCE_ verdict; may be NULL
+ * @return 0 if scored, 1 if the classifier rejected the file, -1 if it cannot be read or scored
+ */
+int ccsl_evaluate_source_file(const ccsl_evaluator_t *evaluator, const char *path, ccsl_scores_t *scores,
+                              int *verdict);
+
+/**
+ * @brief Get a short name for a verdict
+ * @param verdict One of the CCSL_SOURCE_ verdicts
+ * @return Name such as "binary", or NULL if the verdict is out of range
+ */
+const char *ccsl_verdict_name(int verdict);
+
+/**
+ * @brief Format the rationale for one metric, as snprintf() does
+ * @param evaluator The evaluator that produced the scores
+ * @param scores The scores
+ * @param metric Index of the metric
+ * @param buffer Receives the NUL-terminated rationale, truncated to fit
+ * @param size Size of the buffer; may be 0
+ * @return Length of the full rationale, or 0 if the metric was not scored
+ */
+size_t ccsl_format_rationale(const ccsl_evaluator_t *evaluator, const ccsl_scores_t *scores,
+                             int metric, char *buffer, size_t size);
+
+/**
+ * @brief Calculate the average of the stored scores, as ccsl::MetricScores::mean()
+ * @param scores The scores
+ * @return Mean score, or 0.0 if no metric has been scored
+ */
+double ccsl_scores_mean(const ccsl_scores_t *scores);
+
+/**
+ * @brief Get the display name of a metric
+ * @param metric Index of the metric
+ * @return Name such as "Impact", or NULL if the index is out of range
+ */
+const char *ccsl_metric_name(int metric);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CCSL_C_API_H */
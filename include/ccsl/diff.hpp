@@ -0,0 +1,68 @@
+/**
+ * @file diff.hpp
+ * @brief Parsed unified diffs, as produced by git diff or diff -u
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#ifndef CCSL_DIFF_HPP
+#define CCSL_DIFF_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ccsl {
+
+/**
+ * @brief One contiguous block of changed lines
+ *
+ * Context lines are not part of a hunk: a unified-diff hunk with context
+ * becomes one DiffHunk per run of removed and added lines. Lines are
+ * 0-based. A block that only adds lines has oldCount 0 and inserts them
+ * before old line oldStart; one that only removes lines has newCount 0.
+ */
+struct DiffHunk {
+    int oldStart = 0; ///< First removed line, or the insertion point, in the old file
+    int oldCount = 0; ///< Number of removed lines
+    int newStart = 0; ///< First added line, or where the removal was, in the new file
+    int newCount = 0; ///< Number of added lines
+};
+
+/**
+ * @brief The changes to one file
+ */
+struct FileDiff {
+    std::string oldPath;          ///< Path before the change, or empty for a new file
+    std::string newPath;          ///< Path after the change, or empty for a deleted file
+    std::vector<DiffHunk> hunks;  ///< Changed blocks in line order
+
+    /**
+     * @brief Check whether the file was created by the change
+     * @return True if there is no old file
+     */
+    bool isNew() const { return oldPath.empty(); }
+
+    /**
+     * @brief Check whether the file was deleted by the change
+     * @return True if there is no new file
+     */
+    bool isDeleted() const { return newPath.empty(); }
+};
+
+/**
+ * @brief Parse unified diff text
+ *
+ * Understands git's extended headers (renames, new and deleted files) and
+ * plain "--- / +++" headers. The "a/" and "b/" prefixes git adds are
+ * stripped. Files without text hunks, e.g. binary files and mode changes,
+ * are listed with no hunks.
+ *
+ * @param text The diff
+ * @return The changed files in the order they appear
+ * @throws std::invalid_argument if a hunk header is malformed or a hunk is truncated
+ */
+std::vector<FileDiff> parseUnifiedDiff(std::string_view text);
+
+} // namespace ccsl
+
+#endif // CCSL_DIFF_HPP
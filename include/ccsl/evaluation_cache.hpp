@@ -0,0 +1,137 @@
+/**
+ * @file evaluation_cache.hpp
+ * @brief Content-addressed cache of metric evaluations
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#ifndef CCSL_EVALUATION_CACHE_HPP
+#define CCSL_EVALUATION_CACHE_HPP
+
+#include <ccsl/license.hpp>
+#include <ccsl/metrics.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ccsl {
+
+/**
+ * @brief Cache of metric scores keyed by the hash of the scored code
+ *
+ * Fragments whose bytes have not changed are not scored again. Entries are
+ * keyed by hashBytes() of the fragment, seeded with the evaluator version,
+ * and store the compact MetricScores; rationales are rebuilt on demand.
+ * The cache can be saved to and loaded from disk so unchanged code is not
+ * re-scored between runs. All member functions are thread-safe.
+ */
+class EvaluationCache {
+public:
+    /**
+     * @brief Constructor
+     * @param evaluatorVersion Version tag of the scoring rules; entries saved
+     *        with a different version are ignored when loading
+     */
+    explicit EvaluationCache(std::uint32_t evaluatorVersion = MetricsEvaluator::kVersion);
+
+    /**
+     * @brief Score a fragment, reusing the cached result if there is one
+     * @param evaluator Evaluator used on a cache miss
+     * @param code The code fragment to evaluate
+     * @return Compact scores, as MetricsEvaluator::evaluateScores() would return
+     */
+    MetricScores evaluateScores(const MetricsEvaluator& evaluator, std::string_view code);
+
+    /**
+     * @brief Evaluate a fragment, reusing the cached result if there is one
+     * @param evaluator Evaluator used on a cache miss and to format rationales
+     * @param code The code fragment to evaluate
+     * @return Metric evaluations, as MetricsEvaluator::evaluateAll() would return
+     */
+    std::vector<MetricEvaluation> evaluateAll(const MetricsEvaluator& evaluator, std::string_view code);
+
+    /**
+     * @brief Look up the cached scores of a fragment
+     * @param code The code fragment
+     * @return The cached scores, or empty if the fragment is not cached
+     */
+    std::optional<MetricScores> find(std::string_view code) const;
+
+    /**
+     * @brief Store the scores of a fragment
+     * @param code The code fragment
+     * @param scores Scores of the fragment
+     */
+    void insert(std::string_view code, const MetricScores& scores);
+
+    /**
+     * @brief Load entries saved by save(), keeping entries already in memory
+     * @param filePath Path to the cache file
+     * @return True if the file was read; false if it is missing, corrupt or
+     *         was written for another evaluator version
+     */
+    bool load(const std::filesystem::path& filePath);
+
+    /**
+     * @brief Write all entries to disk
+     *
+     * The file is written next to its destination and renamed into place,
+     * so a crash never leaves a truncated cache behind.
+     *
+     * @param filePath Path to the cache file
+     * @return True if the file was written
+     */
+    bool save(const std::filesystem::path& filePath) const;
+
+    /**
+     * @brief Remove all entries and reset the statistics
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of cached fragments
+     * @return Number of entries
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Get the number of lookups that found a cached result
+     * @return Number of cache hits
+     */
+    std::size_t getHits() const { return m_hits.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the number of lookups that had to score the fragment
+     * @return Number of cache misses
+     */
+    std::size_t getMisses() const { return m_misses.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the evaluator version this cache is bound to
+     * @return The version tag
+     */
+    std::uint32_t getEvaluatorVersion() const { return m_evaluatorVersion; }
+
+private:
+    struct Entry {
+        std::uint64_t length; ///< Fragment length, checked to make collisions even less likely
+        MetricScores scores;  ///< Cached scores
+    };
+
+    std::uint64_t keyOf(std::string_view code) const;
+
+    std::uint32_t m_evaluatorVersion;                  ///< Version tag of the scoring rules
+    mutable std::shared_mutex m_mutex;                 ///< Guards m_entries
+    std::unordered_map<std::uint64_t, Entry> m_entries; ///< Entries keyed by content hash
+    mutable std::atomic<std::size_t> m_hits{0};        ///< Lookups served from the cache
+    mutable std::atomic<std::size_t> m_misses{0};      ///< Lookups that missed
+};
+
+} // namespace ccsl
+
+#endif // CCSL_EVALUATION_CACHE_HPP
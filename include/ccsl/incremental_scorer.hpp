@@ -0,0 +1,109 @@
+/**
+ * @file incremental_scorer.hpp
+ * @brief Rescoring only the lines a diff changed
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#ifndef CCSL_INCREMENTAL_SCORER_HPP
+#define CCSL_INCREMENTAL_SCORER_HPP
+
+#include <ccsl/diff.hpp>
+#include <ccsl/evaluation_cache.hpp>
+#include <ccsl/license.hpp>
+#include <ccsl/metrics.hpp>
+#include <ccsl/source_file.hpp>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ccsl {
+
+/**
+ * @brief Opens the new contents of a changed file
+ *
+ * Receives the file's path as it appears in the diff and returns the file,
+ * or empty if it cannot be read.
+ */
+using SourceProvider = std::function<std::optional<SourceFile>(const std::string& path)>;
+
+/**
+ * @brief Totals of applying a diff to a license
+ */
+struct IncrementalResult {
+    std::size_t files = 0;                 ///< Files the diff changed
+    std::size_t shifted = 0;               ///< Contributions moved to new line numbers
+    std::size_t removed = 0;               ///< Contributions dropped or merged away
+    std::size_t added = 0;                 ///< Contributions registered for changed lines
+    std::size_t scoredLines = 0;           ///< Lines that were scored
+    std::vector<std::string> missingFiles; ///< Changed files whose new contents could not be read
+};
+
+/**
+ * @brief Keeps a License up to date with a stream of diffs
+ *
+ * For each changed file the license shifts and drops contributions with
+ * License::applyDiff(); only the changed lines are then read, scored and
+ * registered as new contributions of the diff's author. Files the diff
+ * does not mention are never touched, so the cost of a commit follows the
+ * size of its diff rather than the size of the repository.
+ */
+class IncrementalScorer {
+public:
+    /**
+     * @brief Constructor
+     * @param policy How contributions touched by a change are handled
+     * @param cache Optional cache consulted before scoring; it must outlive the scorer
+     */
+    explicit IncrementalScorer(OverlapPolicy policy = OverlapPolicy::DROP, EvaluationCache* cache = nullptr);
+
+    /**
+     * @brief Apply parsed diffs to a license
+     * @param license The license to update
+     * @param diffs The changed files
+     * @param contributor Author of the change, credited with the changed lines
+     * @param sources Opens the new contents of each changed file
+     * @return Totals of the update
+     * @throws std::invalid_argument if contributor is empty
+     */
+    IncrementalResult apply(
+        License& license,
+        const std::vector<FileDiff>& diffs,
+        const std::string& contributor,
+        const SourceProvider& sources
+    ) const;
+
+    /**
+     * @brief Apply unified diff text to a license, reading new contents from a checkout
+     * @param license The license to update
+     * @param diffText Output of git diff or diff -u
+     * @param contributor Author of the change, credited with the changed lines
+     * @param root Directory the diff's paths are relative to, holding the new contents
+     * @return Totals of the update
+     * @throws std::invalid_argument if contributor is empty or the diff is malformed
+     */
+    IncrementalResult apply(
+        License& license,
+        std::string_view diffText,
+        const std::string& contributor,
+        const std::filesystem::path& root
+    ) const;
+
+    /**
+     * @brief Get the overlap policy
+     * @return How contributions touched by a change are handled
+     */
+    OverlapPolicy getPolicy() const { return m_policy; }
+
+private:
+    OverlapPolicy m_policy;        ///< How touched contributions are handled
+    EvaluationCache* m_cache;      ///< Cache consulted before scoring, or null
+    MetricsEvaluator m_evaluator;  ///< Scores the changed lines
+};
+
+} // namespace ccsl
+
+#endif // CCSL_INCREMENTAL_SCORER_HPP
@@ -0,0 +1,257 @@
+/**
+ * @file instrumentation.hpp
+ * @brief Optional latency, throughput and allocation probes on the hot paths
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#ifndef CCSL_INSTRUMENTATION_HPP
+#define CCSL_INSTRUMENTATION_HPP
+
+#include <ccsl/license.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Set to 1 to compile the probes into the library
+ *
+ * The CCSL_ENABLE_INSTRUMENTATION CMake option sets it for the library and
+ * everything that links it. When it is 0 the probes expand to nothing, and
+ * Instrumentation only reports what is recorded through it directly.
+ */
+#ifndef CCSL_INSTRUMENTATION
+#define CCSL_INSTRUMENTATION 0
+#endif
+
+namespace ccsl {
+
+/**
+ * @brief Instrumented call sites
+ */
+enum class Probe {
+    SCAN_SOURCE,            ///< scanSource(), the phase shared by all evaluators
+    EVALUATE_IMPACT,        ///< Scoring by each evaluator, in MetricType order
+    EVALUATE_SIMPLICITY,
+    EVALUATE_CLEANNESS,
+    EVALUATE_COMMENT,
+    EVALUATE_CREDITABILITY,
+    EVALUATE_NOVELTY,
+    READ_CODE_FROM_FILE,    ///< readCodeFromFile()
+    REGISTER_CONTRIBUTION,  ///< License::registerContribution()
+    SEND_PAYMENT            ///< BitcoinPaymentManager::sendPayment(), up to scheduling verification
+};
+
+/**
+ * @brief Number of probes
+ */
+constexpr std::size_t kProbeCount = 10;
+
+/**
+ * @brief Get the probe for scoring by one evaluator
+ * @param type The metric type
+ * @return The matching EVALUATE_* probe
+ */
+constexpr Probe evaluateProbe(MetricType type) {
+    return static_cast<Probe>(static_cast<std::size_t>(Probe::EVALUATE_IMPACT) + metricIndex(type));
+}
+
+/**
+ * @brief Get the name used for a probe in exported metrics and traces
+ * @param probe The probe
+ * @return Name such as "scan_source"
+ */
+const char* probeName(Probe probe);
+
+/**
+ * @brief Upper bounds of the latency histogram buckets, in nanoseconds
+ *
+ * One more bucket, for slower calls, follows the last bound.
+ */
+constexpr std::array<std::uint64_t, 21> kLatencyBounds = {
+    1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000,
+    1000000, 2500000, 5000000, 10000000, 25000000, 50000000, 100000000,
+    250000000, 500000000, 1000000000, 2500000000, 10000000000
+};
+
+/**
+ * @brief Totals recorded for one probe
+ */
+struct ProbeStats {
+    std::uint64_t calls = 0;        ///< Completed calls
+    std::uint64_t nanoseconds = 0;  ///< Total latency
+    std::uint64_t bytes = 0;        ///< Total bytes processed
+    std::uint64_t allocations = 0;  ///< Heap allocations made during the calls, nested ones included
+    std::array<std::uint64_t, kLatencyBounds.size() + 1> latency{}; ///< Calls per latency bucket
+};
+
+/**
+ * @brief Process-wide registry the probes record into
+ *
+ * Recording is lock-free unless tracing is on, in which case each call also
+ * appends an event for the Chrome trace under a mutex. Counting allocations
+ * replaces the global operator new, so it is only done when the probes are
+ * compiled in.
+ */
+class Instrumentation {
+public:
+    /**
+     * @brief Whether the probes are compiled into the library
+     */
+    static constexpr bool kEnabled = CCSL_INSTRUMENTATION != 0;
+
+    /**
+     * @brief Get the registry
+     * @return The process-wide instance
+     */
+    static Instrumentation& get();
+
+    /**
+     * @brief Record one completed call
+     * @param probe The call site
+     * @param start When the call started
+     * @param nanoseconds How long it took
+     * @param bytes Bytes it processed
+     * @param allocations Heap allocations it made
+     */
+    void record(Probe probe, std::chrono::steady_clock::time_point start, std::uint64_t nanoseconds,
+                std::uint64_t bytes, std::uint64_t allocations);
+
+    /**
+     * @brief Get the totals of one probe
+     * @param probe The probe
+     * @return Totals recorded since the last reset()
+     */
+    ProbeStats getStats(Probe probe) const;
+
+    /**
+     * @brief Clear all totals and trace events
+     */
+    void reset();
+
+    /**
+     * @brief Start or stop keeping an event per call for the Chrome trace
+     * @param enabled Whether to keep events
+     * @param maxEvents Events kept at most; later calls are only counted
+     */
+    void setTracing(bool enabled, std::size_t maxEvents = 1000000);
+
+    /**
+     * @brief Get the number of trace events kept
+     * @return Number of events
+     */
+    std::size_t getTraceEventCount() const;
+
+    /**
+     * @brief Export the totals in the Prometheus text exposition format
+     * @return Latency histograms and byte and allocation counters, labeled by probe
+     */
+    std::string toPrometheus() const;
+
+    /**
+     * @brief Export the trace events as Chrome trace JSON, for chrome://tracing or Perfetto
+     * @return The trace
+     */
+    std::string toChromeTrace() const;
+
+    /**
+     * @brief Write toChromeTrace() to a file
+     * @param filePath Path of the file
+     * @return True if the file was written
+     */
+    bool writeChromeTrace(const std::filesystem::path& filePath) const;
+
+    /**
+     * @brief Get the number of heap allocations made so far by the calling thread
+     * @return Allocation count, or 0 when the probes are not compiled in
+     */
+    static std::uint64_t getThreadAllocations();
+
+private:
+    Instrumentation();
+
+    struct Counters {
+        std::atomic<std::uint64_t> calls{0};
+        std::atomic<std::uint64_t> nanoseconds{0};
+        std::atomic<std::uint64_t> bytes{0};
+        std::atomic<std::uint64_t> allocations{0};
+        std::array<std::atomic<std::uint64_t>, kLatencyBounds.size() + 1> latency{};
+    };
+
+    struct TraceEvent {
+        Probe probe;
+        std::uint64_t startNanoseconds;  ///< Since m_epoch
+        std::uint64_t nanoseconds;
+        std::uint64_t bytes;
+        std::uint64_t allocations;
+        std::uint64_t thread;            ///< Small per-thread number
+    };
+
+    std::array<Counters, kProbeCount> m_counters;  ///< Totals per probe
+    std::atomic<bool> m_tracing{false};            ///< Whether to keep trace events
+    mutable std::mutex m_traceMutex;               ///< Guards the members below
+    std::vector<TraceEvent> m_events;              ///< Trace events in completion order
+    std::size_t m_maxEvents = 0;                   ///< Events kept at most
+    const std::chrono::steady_clock::time_point m_epoch; ///< Time zero of the trace
+};
+
+/**
+ * @brief Records the call it is scoped to into the registry when destroyed
+ *
+ * Use it through CCSL_PROBE so it is compiled out when instrumentation is off.
+ */
+class ScopedProbe {
+public:
+    /**
+     * @brief Start timing a call
+     * @param probe The call site
+     * @param bytes Bytes the call processes, if known up front
+     */
+    explicit ScopedProbe(Probe probe, std::uint64_t bytes = 0)
+        : m_probe(probe),
+          m_bytes(bytes),
+          m_allocations(Instrumentation::getThreadAllocations()),
+          m_start(std::chrono::steady_clock::now()) {}
+
+    ~ScopedProbe() {
+        auto elapsed = std::chrono::steady_clock::now() - m_start;
+        Instrumentation::get().record(
+            m_probe, m_start,
+            static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+            m_bytes, Instrumentation::getThreadAllocations() - m_allocations);
+    }
+
+    ScopedProbe(const ScopedProbe&) = delete;
+    ScopedProbe& operator=(const ScopedProbe&) = delete;
+
+    /**
+     * @brief Count bytes that only become known during the call
+     * @param bytes Bytes processed
+     */
+    void addBytes(std::uint64_t bytes) { m_bytes += bytes; }
+
+private:
+    Probe m_probe;
+    std::uint64_t m_bytes;
+    std::uint64_t m_allocations;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+} // namespace ccsl
+
+#if CCSL_INSTRUMENTATION
+/** @brief Time the rest of the enclosing scope as a call of probe */
+#define CCSL_PROBE(name, probe, bytes) ::ccsl::ScopedProbe name((probe), (bytes))
+/** @brief Add bytes to a probe started with CCSL_PROBE */
+#define CCSL_PROBE_ADD_BYTES(name, bytes) (name).addBytes(bytes)
+#else
+#define CCSL_PROBE(name, probe, bytes) ((void)0)
+#define CCSL_PROBE_ADD_BYTES(name, bytes) ((void)0)
+#endif
+
+#endif // CCSL_INSTRUMENTATION_HPP
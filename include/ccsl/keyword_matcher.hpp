@@ -0,0 +1,133 @@
+/**
+ * @file keyword_matcher.hpp
+ * @brief Compile-time perfect hash for fixed keyword lists
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#ifndef CCSL_KEYWORD_MATCHER_HPP
+#define CCSL_KEYWORD_MATCHER_HPP
+
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+namespace ccsl {
+
+/**
+ * @brief A keyword and the value it maps to
+ */
+template<typename Value>
+struct KeywordEntry {
+    std::string_view word; ///< Keyword text
+    Value value;           ///< Value returned when the keyword matches
+};
+
+/**
+ * @brief Perfect hash over a fixed keyword list, built at compile time
+ *
+ * The constructor searches for a hash seed under which every keyword lands
+ * in its own slot of a power-of-two table. A lookup therefore costs one
+ * hash of the word and at most one string comparison, with no allocation.
+ * Declare matchers constexpr so the seed search runs during compilation.
+ */
+template<typename Value, std::size_t N>
+class KeywordMatcher {
+public:
+    static constexpr std::size_t kTableSize = [] {
+        std::size_t size = 1;
+        while (size < 4 * N) {
+            size <<= 1;
+        }
+        return size;
+    }();
+
+    /**
+     * @brief Build the perfect hash table
+     * @param entries The keywords and their values, all distinct and non-empty
+     */
+    constexpr explicit KeywordMatcher(const KeywordEntry<Value> (&entries)[N])
+        : m_slots{}, m_seed(0), m_minLength(~std::size_t(0)), m_maxLength(0)
+    {
+        for (const auto& entry : entries) {
+            m_minLength = entry.word.size() < m_minLength ? entry.word.size() : m_minLength;
+            m_maxLength = entry.word.size() > m_maxLength ? entry.word.size() : m_maxLength;
+        }
+
+        for (std::uint32_t seed = 1; m_seed == 0; ++seed) {
+            for (auto& slot : m_slots) {
+                slot = KeywordEntry<Value>{};
+            }
+
+            bool collision = false;
+            for (const auto& entry : entries) {
+                auto& slot = m_slots[hash(entry.word, seed) & (kTableSize - 1)];
+                if (!slot.word.empty()) {
+                    collision = true;
+                    break;
+                }
+                slot = entry;
+            }
+
+            if (!collision) {
+                m_seed = seed;
+            }
+        }
+    }
+
+    /**
+     * @brief Look up a word
+     * @param word The word to look up
+     * @return The keyword's value, or a value-initialized Value if it is not a keyword
+     */
+    constexpr Value find(std::string_view word) const {
+        if (word.size() < m_minLength || word.size() > m_maxLength) {
+            return Value{};
+        }
+
+        const auto& slot = m_slots[hash(word, m_seed) & (kTableSize - 1)];
+        return slot.word == word ? slot.value : Value{};
+    }
+
+    /**
+     * @brief Check whether a word is one of the keywords
+     * @param word The word to check
+     * @return True if the word is a keyword
+     */
+    constexpr bool contains(std::string_view word) const {
+        if (word.size() < m_minLength || word.size() > m_maxLength) {
+            return false;
+        }
+
+        return m_slots[hash(word, m_seed) & (kTableSize - 1)].word == word;
+    }
+
+private:
+    static constexpr std::uint32_t hash(std::string_view word, std::uint32_t seed) {
+        // FNV-1a, seeded and mixed with the length
+        std::uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u) ^ static_cast<std::uint32_t>(word.size());
+        for (char c : word) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 16777619u;
+        }
+        return h ^ (h >> 15);
+    }
+
+    KeywordEntry<Value> m_slots[kTableSize]; ///< Open table, one keyword per slot
+    std::uint32_t m_seed;                    ///< Collision-free seed found at construction
+    std::size_t m_minLength;                 ///< Length of the shortest keyword
+    std::size_t m_maxLength;                 ///< Length of the longest keyword
+};
+
+/**
+ * @brief Build a keyword matcher, deducing the value type and keyword count
+ * @param entries The keywords and their values
+ * @return The keyword matcher
+ */
+template<typename Value, std::size_t N>
+constexpr KeywordMatcher<Value, N> makeKeywordMatcher(const KeywordEntry<Value> (&entries)[N]) {
+    return KeywordMatcher<Value, N>(entries);
+}
+
+} // namespace ccsl
+
+#endif // CCSL_KEYWORD_MATCHER_HPP
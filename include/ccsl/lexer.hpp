@@ -0,0 +1,73 @@
+/**
+ * @file lexer.hpp
+ * @brief Single-pass source lexer shared by the metric evaluators
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#ifndef CCSL_LEXER_HPP
+#define CCSL_LEXER_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+
+namespace ccsl {
+
+/**
+ * @brief Per-line facts collected by the source lexer
+ *
+ * Lines are split on '\n' the same way std::getline splits them, so a
+ * trailing newline does not produce an extra empty line.
+ */
+struct LineSummary {
+    std::size_t offset = 0;                         ///< Byte offset of the line in the source
+    std::size_t length = 0;                         ///< Length of the line, excluding the newline
+    bool blank = true;                              ///< True if the line holds only spaces, tabs or '\r'
+    std::size_t indentLength = 0;                   ///< Number of leading spaces and tabs
+    char indentChar = '\0';                         ///< First indentation character, or '\0' if none
+    bool mixedIndent = false;                       ///< True if the indentation mixes spaces and tabs
+    std::size_t blockCommentOpen = std::string::npos;  ///< Offset of the first "/*", or npos
+    std::size_t blockCommentClose = std::string::npos; ///< Offset of the first "*/", or npos
+    std::size_t lineComment = std::string::npos;       ///< Offset of the first "//", or npos
+    int words = 0;                                  ///< Whitespace-separated words in the line
+    int wordsFromBlockComment = 0;                  ///< Words from the first "/*" to the end of the line
+    int wordsAfterLineComment = 0;                  ///< Words after the first "//" to the end of the line
+};
+
+/**
+ * @brief Token and line summary of a code fragment
+ *
+ * Produced by a single walk over the bytes of a fragment. Every metric
+ * evaluator computes its score from this summary, so a fragment is only
+ * scanned once no matter how many metrics are evaluated.
+ */
+struct SourceSummary {
+    std::size_t byteCount = 0;            ///< Size of the fragment in bytes
+    std::vector<LineSummary> lines;       ///< Per-line facts in source order
+
+    int identifiers = 0;                  ///< Word tokens ([A-Za-z0-9_]+ runs)
+    int callSites = 0;                    ///< Word tokens followed by optional whitespace and '('
+    int controlStatements = 0;            ///< if/for/while/switch followed by optional whitespace and '('
+    int testIndicators = 0;               ///< test/assert/expect/should/mock/stub/spy tokens
+    int docTags = 0;                      ///< Documentation tags such as @param or @return
+    int references = 0;                   ///< URLs and RFC/IEEE/ISO standard references
+    int advancedFeatures = 0;             ///< Advanced language feature keywords
+    int designPatterns = 0;               ///< Design pattern names
+    int complexityAnnotations = 0;        ///< Big-O annotations such as O(n log n)
+
+    int symbols = 0;                      ///< Operator and punctuation characters
+    int maxBraceDepth = 0;                ///< Deepest curly brace nesting
+    int closeParenBraces = 0;             ///< ')' followed by optional whitespace and '{'
+};
+
+/**
+ * @brief Scan a code fragment once and summarize it
+ * @param code The code fragment to scan
+ * @return Summary consumed by the metric evaluators
+ */
+SourceSummary scanSource(std::string_view code);
+
+} // namespace ccsl
+
+#endif // CCSL_LEXER_HPP
@@ -7,12 +7,23 @@
 #ifndef CCSL_LICENSE_HPP
 #define CCSL_LICENSE_HPP
 
+#include <ccsl/amount.hpp>
+#include <ccsl/diff.hpp>
+#include <ccsl/report_writer.hpp>
+#include <ccsl/string_interner.hpp>
 #include <string>
 #include <vector>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <unordered_map>
+#include <map>
 #include <memory>
+#include <memory_resource>
 #include <chrono>
 #include <functional>
+#include <iosfwd>
+#include <utility>
 
 namespace ccsl {
 
@@ -37,31 +48,263 @@ struct MetricEvaluation {
     std::string rationale; ///< Explanation for the given value
 };
 
+/**
+ * @brief Number of metric types
+ */
+constexpr std::size_t kMetricTypeCount = 6;
+
+/**
+ * @brief Index of a metric type in per-metric arrays
+ * @param type The metric type
+ * @return Index between 0 and kMetricTypeCount - 1
+ */
+constexpr std::size_t metricIndex(MetricType type) { return static_cast<std::size_t>(type); }
+
+/**
+ * @brief Raw measurements behind a metric score, used to format its rationale
+ *
+ * The meaning of each slot depends on the metric, e.g. function calls and
+ * control structures for IMPACT.
+ */
+using MetricCounts = std::array<double, 3>;
+
+/**
+ * @brief Compact, allocation-free storage for the scores of all metrics
+ *
+ * Scores and their raw counts are indexed by metricIndex(). Rationales are
+ * not stored; MetricsEvaluator::formatRationale() builds them on demand.
+ */
+struct MetricScores {
+    std::array<double, kMetricTypeCount> values{};       ///< Score per metric type
+    std::array<MetricCounts, kMetricTypeCount> counts{}; ///< Raw counts per metric type
+    std::uint8_t present = 0;                            ///< Bit per metric type that holds a score
+    
+    /**
+     * @brief Store the score of a metric
+     * @param type The metric type
+     * @param value Normalized value between 0.0 and 1.0
+     * @param rawCounts Raw measurements behind the value
+     */
+    void set(MetricType type, double value, const MetricCounts& rawCounts = {});
+    
+    /**
+     * @brief Check whether a metric has been scored
+     * @param type The metric type
+     * @return True if a score is stored for the metric
+     */
+    bool has(MetricType type) const { return (present >> metricIndex(type)) & 1u; }
+    
+    /**
+     * @brief Get the score of a metric
+     * @param type The metric type
+     * @return The stored score, or 0.0 if the metric has not been scored
+     */
+    double get(MetricType type) const { return values[metricIndex(type)]; }
+    
+    /**
+     * @brief Get the number of scored metrics
+     * @return Number of metric types holding a score
+     */
+    std::size_t size() const;
+    
+    /**
+     * @brief Calculate the average of the stored scores
+     * @return Mean score, or 0.0 if no metric has been scored
+     */
+    double mean() const;
+};
+
+/**
+ * @brief Per-project weights of the metrics in a contribution's value
+ *
+ * A contribution is worth the weighted mean of the metrics it has scores
+ * for: the sum of weight times score divided by the sum of the weights.
+ * With every weight at 1, the default, this is the plain mean that
+ * CodeContribution::calculateValue() returns. A weight of 0 leaves a
+ * metric out.
+ */
+struct MetricWeights {
+    std::array<double, kMetricTypeCount> values; ///< Weight per metric type, indexed by metricIndex()
+    
+    /**
+     * @brief Weigh every metric equally
+     */
+    MetricWeights() { values.fill(1.0); }
+    
+    /**
+     * @brief Set the weight of a metric
+     * @param type The metric type
+     * @param weight The weight
+     * @throws std::invalid_argument if weight is negative or not finite
+     */
+    void set(MetricType type, double weight);
+    
+    /**
+     * @brief Get the weight of a metric
+     * @param type The metric type
+     * @return The weight
+     */
+    double get(MetricType type) const { return values[metricIndex(type)]; }
+    
+    /**
+     * @brief Calculate the weighted value of a set of scores
+     * @param scores The scores
+     * @return Weighted mean of the scored metrics, or 0.0 if none has weight
+     */
+    double apply(const MetricScores& scores) const;
+};
+
+/**
+ * @brief Scores of many contributions stored column by column, with their weighted values
+ *
+ * Each metric's scores and presence flags are kept in their own
+ * contiguous column, so weighing every row is a short dot product that
+ * runs four rows at a time with AVX2, or two with NEON. AVX2 is picked at
+ * run time on x86-64, so no special build flags are needed. The kernels
+ * add in the same order as MetricWeights::apply() and never fuse a
+ * multiply with an add, so every path gives bit-identical values.
+ *
+ * Weighted values are cached per row: appending weighs only the new row,
+ * and only setWeights() weighs them all again.
+ */
+class ScoreMatrix {
+public:
+    /**
+     * @brief Constructor
+     * @param weights Weights of the metrics
+     * @param resource Memory resource for the columns
+     */
+    explicit ScoreMatrix(const MetricWeights& weights = MetricWeights(),
+                         std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    
+    /**
+     * @brief Add a row
+     * @param scores Scores of the row
+     * @return Weighted value of the row
+     */
+    double append(const MetricScores& scores);
+    
+    /**
+     * @brief Remove a row by moving the last row into its place
+     * @param row Index of the row to remove
+     */
+    void removeSwap(std::size_t row);
+    
+    /**
+     * @brief Remove all rows
+     */
+    void clear();
+    
+    /**
+     * @brief Reserve space for rows
+     * @param rows Number of rows to reserve space for
+     */
+    void reserve(std::size_t rows);
+    
+    /**
+     * @brief Change the weights and weigh every row again
+     * @param weights New weights of the metrics
+     */
+    void setWeights(const MetricWeights& weights);
+    
+    /**
+     * @brief Get the weights
+     * @return The weights of the metrics
+     */
+    const MetricWeights& getWeights() const { return m_weights; }
+    
+    /**
+     * @brief Get the weighted value of a row
+     * @param row Index of the row, below size()
+     * @return The weighted value
+     */
+    double getValue(std::size_t row) const { return m_rowValues[row]; }
+    
+    /**
+     * @brief Get the weighted values of all rows
+     * @return One value per row
+     */
+    const std::pmr::vector<double>& getValues() const { return m_rowValues; }
+    
+    /**
+     * @brief Get the number of rows
+     * @return Number of rows
+     */
+    std::size_t size() const { return m_rowValues.size(); }
+    
+private:
+    MetricWeights m_weights;                                         ///< Weights of the metrics
+    std::array<std::pmr::vector<double>, kMetricTypeCount> m_scores;  ///< Score column per metric; 0 if absent
+    std::array<std::pmr::vector<double>, kMetricTypeCount> m_present; ///< Presence column per metric, 1 or 0
+    std::pmr::vector<double> m_rowValues;                            ///< Weighted value per row
+};
+
 /**
  * @brief Class for tracking code contributions and their valuations
+ *
+ * Contributions are allocator-aware: the evaluation list is allocated from
+ * the memory resource given at construction, and a std::pmr container of
+ * contributions, such as the one inside a License, hands its own resource
+ * to every contribution it holds. Copies use the default resource unless
+ * one is given.
  */
 class CodeContribution {
 public:
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+    using EvaluationList = std::pmr::vector<MetricEvaluation>; ///< Type returned by getMetricEvaluations()
+    
     /**
      * @brief Constructor for a code contribution
      * @param contributor Name of the contributor
      * @param fileId Identifier for the file
      * @param lineStart Starting line of the contribution
      * @param lineEnd Ending line of the contribution
+     * @param allocator Allocator for the evaluation list
      */
     CodeContribution(
         const std::string& contributor,
         const std::string& fileId,
         int lineStart,
-        int lineEnd
+        int lineEnd,
+        const allocator_type& allocator = {}
     );
     
+    CodeContribution(const CodeContribution& other) = default;
+    CodeContribution(CodeContribution&& other) noexcept = default;
+    CodeContribution& operator=(const CodeContribution& other) = default;
+    CodeContribution& operator=(CodeContribution&& other) = default;
+    
+    /**
+     * @brief Copy a contribution into another memory resource
+     * @param other The contribution to copy
+     * @param allocator Allocator for the copy's evaluation list
+     */
+    CodeContribution(const CodeContribution& other, const allocator_type& allocator);
+    
+    /**
+     * @brief Move a contribution into another memory resource
+     * @param other The contribution to move; its evaluations are copied if the resources differ
+     * @param allocator Allocator for the new contribution's evaluation list
+     */
+    CodeContribution(CodeContribution&& other, const allocator_type& allocator);
+    
     /**
      * @brief Add a metric evaluation to this contribution
      * @param evaluation The metric evaluation to add
      */
     void addMetricEvaluation(const MetricEvaluation& evaluation);
     
+    /**
+     * @brief Set compact metric scores for this contribution
+     *
+     * Replaces any evaluation of the same metric types. No rationale is
+     * stored, so getMetricEvaluations() only lists metrics added through
+     * addMetricEvaluation().
+     *
+     * @param scores The scores to store
+     */
+    void setMetricScores(const MetricScores& scores);
+    
     /**
      * @brief Calculate the total value of this contribution
      * @return Double value representing the contribution's worth
@@ -72,13 +315,25 @@ public:
      * @brief Get the contributor's name
      * @return String containing the contributor's name
      */
-    std::string getContributor() const { return m_contributor; }
+    const std::string& getContributor() const { return m_contributor.str(); }
+    
+    /**
+     * @brief Get the contributor's name as an interned string
+     * @return The contributor's name, which compares and hashes as an integer
+     */
+    InternedString getInternedContributor() const { return m_contributor; }
     
     /**
      * @brief Get the file identifier
      * @return String containing the file identifier
      */
-    std::string getFileId() const { return m_fileId; }
+    const std::string& getFileId() const { return m_fileId.str(); }
+    
+    /**
+     * @brief Get the file identifier as an interned string
+     * @return The file identifier, which compares and hashes as an integer
+     */
+    InternedString getInternedFileId() const { return m_fileId; }
     
     /**
      * @brief Get the line range of this contribution
@@ -88,16 +343,32 @@ public:
     
     /**
      * @brief Get all metric evaluations for this contribution
-     * @return Vector of metric evaluations
+     * @return Vector of metric evaluations; a std::pmr::vector since the
+     *         list is allocator-aware, not the std::vector of earlier versions
+     */
+    const EvaluationList& getMetricEvaluations() const { return m_evaluations; }
+    
+    /**
+     * @brief Get the compact scores of all metrics for this contribution
+     * @return Scores indexed by metric type
      */
-    const std::vector<MetricEvaluation>& getMetricEvaluations() const { return m_evaluations; }
+    const MetricScores& getMetricScores() const { return m_scores; }
+    
+    /**
+     * @brief Get the allocator the evaluation list uses
+     * @return The allocator
+     */
+    allocator_type get_allocator() const { return m_evaluations.get_allocator(); }
     
 private:
-    std::string m_contributor;              ///< Name of the contributor
-    std::string m_fileId;                   ///< Identifier for the file
+    friend class License; // Moves registered contributions when a diff shifts their lines
+    
+    InternedString m_contributor;           ///< Name of the contributor
+    InternedString m_fileId;                ///< Identifier for the file
     int m_lineStart;                        ///< Starting line of the contribution
     int m_lineEnd;                          ///< Ending line of the contribution
-    std::vector<MetricEvaluation> m_evaluations; ///< Metric evaluations for this contribution
+    EvaluationList m_evaluations;           ///< Metric evaluations with rationales
+    MetricScores m_scores;                  ///< Scores of all evaluated metrics
 };
 
 /**
@@ -114,7 +385,15 @@ public:
     /**
      * @brief Record a payment for a code contribution
      * @param contribution The code contribution being paid for
-     * @param amount The amount in bitcoins
+     * @param amount The amount paid
+     * @return True if payment was successfully recorded
+     */
+    bool recordPayment(const CodeContribution& contribution, Satoshis amount);
+    
+    /**
+     * @brief Record a payment for a code contribution
+     * @param contribution The code contribution being paid for
+     * @param amount The amount in bitcoins, rounded to whole satoshis
      * @return True if payment was successfully recorded
      */
     bool recordPayment(const CodeContribution& contribution, double amount);
@@ -122,19 +401,69 @@ public:
     /**
      * @brief Get total payments for a specific contributor
      * @param contributor Name of the contributor
-     * @return Total amount paid to the contributor
+     * @return Total amount paid to the contributor, in bitcoins
      */
     double getTotalPaymentsForContributor(const std::string& contributor) const;
     
+    /**
+     * @brief Get the exact total of payments for a specific contributor
+     * @param contributor Name of the contributor
+     * @return Total amount paid to the contributor
+     */
+    Satoshis getContributorTotal(const std::string& contributor) const;
+    
+    /**
+     * @brief Get the exact total of all recorded payments
+     *
+     * The total is kept up to date as payments are recorded, so this is O(1).
+     *
+     * @return Total amount paid to all contributors
+     */
+    Satoshis getTotalPayments() const { return m_total; }
+    
     /**
      * @brief Generate a payment report
      * @return String containing the payment report
      */
     std::string generatePaymentReport() const;
     
+    /**
+     * @brief Stream the payment report to a stream
+     * @param out The stream
+     */
+    void writePaymentReport(std::ostream& out) const;
+    
+    /**
+     * @brief Stream the payment report to a callback, a buffer at a time
+     * @param sink Receives the report in chunks
+     */
+    void writePaymentReport(const ReportSink& sink) const;
+    
 private:
+    friend class LicenseSnapshot; // Restores the ledger from a snapshot
+    
+    void writeReport(ReportWriter& writer) const;
+    
     std::string m_walletAddress; ///< Bitcoin wallet address for payments
-    std::unordered_map<std::string, double> m_payments; ///< Map of contributor to total payments
+    std::unordered_map<InternedString, Satoshis> m_payments; ///< Map of contributor to total payments
+    Satoshis m_total;            ///< Sum of m_payments
+};
+
+/**
+ * @brief What License::applyDiff() does with a contribution that a changed block touches
+ */
+enum class OverlapPolicy {
+    DROP,  ///< Remove it; only the added lines are left to score
+    MERGE  ///< Remove it and leave its remaining lines to score together with the added lines
+};
+
+/**
+ * @brief Effect of a diff on the contributions registered for a file
+ */
+struct DiffEffect {
+    std::size_t shifted = 0;                      ///< Contributions moved to new line numbers
+    std::size_t removed = 0;                      ///< Contributions dropped or merged away
+    std::vector<std::pair<int, int>> dirtyRanges; ///< Line ranges of the new file left to score, sorted and disjoint
 };
 
 /**
@@ -142,25 +471,183 @@ private:
  */
 class License {
 public:
+    using ContributionList = std::pmr::vector<CodeContribution>; ///< Type returned by getContributions()
+    
     /**
      * @brief Constructor
+     *
+     * The contributions and the line index are allocated from resource, so
+     * a scan can back a whole license with one arena, such as a
+     * std::pmr::monotonic_buffer_resource, and free it in a single release.
+     * The resource must outlive the license. Copies of the license use the
+     * default resource; moves keep the original one.
+     *
      * @param projectName Name of the licensed project
      * @param licenseKey Unique license key
+     * @param resource Memory resource for the contributions and their index
      */
-    License(const std::string& projectName, const std::string& licenseKey);
+    License(const std::string& projectName, const std::string& licenseKey,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource());
     
     /**
      * @brief Register a code contribution
+     *
+     * A contribution is rejected if its line range overlaps, in any way, the
+     * range of a contribution already registered for the same file. The
+     * check is an O(log n) lookup in a per-file interval map.
+     *
      * @param contribution The code contribution to register
      * @return True if contribution was successfully registered
      */
     bool registerContribution(const CodeContribution& contribution);
     
+    /**
+     * @brief Register a code contribution, moving it into the license
+     * @param contribution The code contribution to register; left unchanged if it is rejected
+     * @return True if contribution was successfully registered
+     */
+    bool registerContribution(CodeContribution&& contribution);
+    
+    /**
+     * @brief Construct a code contribution in place and register it
+     *
+     * The contribution is built directly in the license's storage and
+     * discarded again if it overlaps a registered contribution.
+     *
+     * @param args Arguments for the CodeContribution constructor
+     * @return True if contribution was successfully registered
+     * @throws std::invalid_argument if the arguments are invalid
+     */
+    template <typename... Args>
+    bool emplaceContribution(Args&&... args) {
+        m_contributions.emplace_back(std::forward<Args>(args)...);
+        return indexLastContribution();
+    }
+    
+    /**
+     * @brief Register many code contributions at once
+     *
+     * The contributions are sorted by file and start line and checked in a
+     * single sweep. A contribution that overlaps a registered contribution,
+     * or one accepted earlier in the sweep, is skipped.
+     *
+     * @param contributions The code contributions to register
+     * @return Number of contributions that were registered
+     */
+    std::size_t registerContributions(const std::vector<CodeContribution>& contributions);
+    
+    /**
+     * @brief Register many code contributions at once, moving them into the license
+     * @param contributions The code contributions to register; registered ones are left moved-from
+     * @return Number of contributions that were registered
+     */
+    std::size_t registerContributions(std::vector<CodeContribution>&& contributions);
+    
+    /**
+     * @brief Update the contributions of one file for a change to it
+     *
+     * Contributions that no changed block touches keep their lines, shifted
+     * by the number of lines added and removed above them, and follow the
+     * file if it was renamed. Contributions a block touches are removed,
+     * as are all contributions of a deleted file. A block that only inserts
+     * lines touches a contribution if the lines go strictly inside it.
+     *
+     * The caller scores and registers the returned dirty ranges, which are
+     * in new-file lines; IncrementalScorer does both. The cost depends on
+     * the number of contributions in the file, not in the whole license.
+     * Removing a contribution moves the last one into its slot, so the
+     * order of getContributions() changes.
+     *
+     * @param diff The changes to the file
+     * @param policy How touched contributions are handled
+     * @return What changed and which lines need scoring
+     */
+    DiffEffect applyDiff(const FileDiff& diff, OverlapPolicy policy = OverlapPolicy::DROP);
+    
     /**
      * @brief Get all registered contributions
-     * @return Vector of registered code contributions
+     * @return Vector of registered code contributions; a std::pmr::vector
+     *         allocated from getMemoryResource(), not the std::vector of
+     *         earlier versions
      */
-    const std::vector<CodeContribution>& getContributions() const { return m_contributions; }
+    const ContributionList& getContributions() const { return m_contributions; }
+    
+    /**
+     * @brief Get the memory resource the contributions are allocated from
+     * @return The memory resource
+     */
+    std::pmr::memory_resource* getMemoryResource() const { return m_contributions.get_allocator().resource(); }
+    
+    /**
+     * @brief Set the project's metric weights and weigh every contribution again
+     *
+     * This is the only operation that weighs the whole license; it runs
+     * SIMD kernels over the columnar scores and then rebuilds the totals.
+     *
+     * @param weights Weights of the metrics
+     */
+    void setMetricWeights(const MetricWeights& weights);
+    
+    /**
+     * @brief Get the project's metric weights
+     * @return The weights, all 1 unless set
+     */
+    const MetricWeights& getMetricWeights() const { return m_scoreMatrix.getWeights(); }
+    
+    /**
+     * @brief Get the weighted value of a registered contribution
+     * @param index Index of the contribution in getContributions()
+     * @return The weighted value
+     * @throws std::out_of_range if index is too large
+     */
+    double getContributionValue(std::size_t index) const;
+    
+    /**
+     * @brief Get the total weighted value of a contributor's contributions
+     *
+     * Totals are kept up to date as contributions are registered, removed
+     * or moved, so this is O(1).
+     *
+     * @param contributor Name of the contributor
+     * @return Sum of the weighted values, or 0.0 for an unknown contributor
+     */
+    double getContributorValue(const std::string& contributor) const;
+    
+    /**
+     * @brief Get the total weighted value of an interned contributor's contributions
+     *
+     * Unlike getContributorValue() this does not search the interner, so
+     * it takes no lock and suits lookups from many threads at once.
+     *
+     * @param contributor Interned name of the contributor
+     * @return Sum of the weighted values, or 0.0 for an unknown contributor
+     */
+    double getInternedContributorValue(InternedString contributor) const;
+    
+    /**
+     * @brief Get the total weighted value of the contributions to a file
+     * @param fileId Identifier for the file
+     * @return Sum of the weighted values, or 0.0 for an unknown file
+     */
+    double getFileValue(const std::string& fileId) const;
+    
+    /**
+     * @brief Get the total weighted value of all contributions
+     * @return Sum of the weighted values
+     */
+    double getTotalValue() const { return m_totalValue; }
+    
+    /**
+     * @brief Get the total weighted value of every contributor
+     * @return Contributor names with their totals, sorted by name
+     */
+    std::vector<std::pair<std::string, double>> getContributorValues() const;
+    
+    /**
+     * @brief Get the total weighted value of every file
+     * @return File identifiers with their totals, sorted by identifier
+     */
+    std::vector<std::pair<std::string, double>> getFileValues() const;
     
     /**
      * @brief Get the payment manager
@@ -180,10 +667,58 @@ public:
      */
     std::string getLicenseInfo() const;
     
+    /**
+     * @brief Stream license information to a stream
+     *
+     * The text is the same as getLicenseInfo() returns, but it is written a
+     * buffer at a time, so memory use does not grow with the number of
+     * contributions.
+     *
+     * @param out The stream
+     */
+    void writeLicenseInfo(std::ostream& out) const;
+    
+    /**
+     * @brief Stream license information to a callback, a buffer at a time
+     * @param sink Receives the text in chunks
+     */
+    void writeLicenseInfo(const ReportSink& sink) const;
+    
 private:
+    friend class LicenseSnapshot; // Saves and restores the contributions and their index
+    
+    struct IndexedRange {
+        int lineEnd;              ///< Ending line of the contribution
+        std::size_t contribution; ///< Index of the contribution in m_contributions
+    };
+    
+    using LineRanges = std::pmr::map<int, IndexedRange>;
+    
+    struct ValueTotal {
+        double value = 0.0;           ///< Sum of the weighted values
+        std::size_t contributions = 0; ///< Number of contributions summed
+    };
+    
+    using ValueTotals = std::pmr::unordered_map<InternedString, ValueTotal>;
+    
+    void writeInfo(ReportWriter& writer) const;
+    bool indexContribution(const CodeContribution& contribution, std::size_t index);
+    bool indexLastContribution();
+    void addValue(std::size_t index);
+    void subtractValue(ValueTotals& totals, InternedString key, double value);
+    void rebuildValues();
+    template <typename Contribution>
+    std::size_t registerSorted(std::vector<Contribution*>& order);
+    void removeContributions(std::vector<std::size_t>& indices);
+    
     std::string m_projectName;              ///< Name of the licensed project
     std::string m_licenseKey;               ///< Unique license key
-    std::vector<CodeContribution> m_contributions; ///< Registered code contributions
+    ContributionList m_contributions;       ///< Registered code contributions
+    std::pmr::unordered_map<InternedString, LineRanges> m_lineIndex; ///< Per-file map from start line to end line and contribution
+    ScoreMatrix m_scoreMatrix;              ///< Columnar scores and weighted values, one row per contribution
+    ValueTotals m_contributorValues;        ///< Weighted value per contributor
+    ValueTotals m_fileValues;               ///< Weighted value per file
+    double m_totalValue = 0.0;              ///< Weighted value of all contributions
     PaymentManager m_paymentManager;        ///< Payment manager for this license
 };
 
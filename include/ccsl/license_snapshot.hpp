@@ -0,0 +1,187 @@
+/**
+ * @file license_snapshot.hpp
+ * @brief Flat, memory-mappable binary snapshot of a License
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#ifndef CCSL_LICENSE_SNAPSHOT_HPP
+#define CCSL_LICENSE_SNAPSHOT_HPP
+
+#include <ccsl/amount.hpp>
+#include <ccsl/license.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+namespace ccsl {
+
+/**
+ * @brief A contribution read from a snapshot
+ *
+ * The strings point into the snapshot and stay valid while it is open.
+ */
+struct SnapshotContribution {
+    std::string_view contributor; ///< Name of the contributor
+    std::string_view fileId;      ///< Identifier for the file
+    int lineStart = 0;            ///< Starting line of the contribution
+    int lineEnd = 0;              ///< Ending line of the contribution
+    MetricScores scores;          ///< Scores of all evaluated metrics
+
+    /**
+     * @brief Calculate the total value of this contribution
+     * @return The same value CodeContribution::calculateValue() returns
+     */
+    double calculateValue() const { return scores.mean(); }
+};
+
+/**
+ * @brief Read-only License state mapped straight from a file
+ *
+ * The file holds a header, fixed-size contribution records, a per-file
+ * index of line ranges sorted by start line, the payment ledger and one
+ * table of deduplicated strings. Records are laid out so they can be used
+ * in place: open() validates the header and maps the file, and nothing
+ * is parsed until it is queried. The mapping is shared, so any number of
+ * processes can query the same snapshot while paying for its pages once.
+ *
+ * Values are stored in host byte order; snapshots written on a machine of
+ * the other endianness, or by another format version, are refused.
+ * Metric rationales are not stored, since
+ * MetricsEvaluator::formatRationale() rebuilds them from the scores.
+ */
+class LicenseSnapshot {
+public:
+    /**
+     * @brief Version of the file format
+     */
+    static constexpr std::uint32_t kVersion = 1;
+
+    /**
+     * @brief Write a snapshot of a license
+     *
+     * The file is written next to its destination and renamed into place,
+     * so processes that have the old snapshot open keep a consistent view.
+     *
+     * @param license The license to save
+     * @param filePath Path to the snapshot file
+     * @return True if the file was written
+     */
+    static bool write(const License& license, const std::filesystem::path& filePath);
+
+    /**
+     * @brief Map a snapshot for querying
+     * @param filePath Path to the snapshot file
+     * @return The snapshot, or empty if the file is missing, truncated or of another format
+     */
+    static std::optional<LicenseSnapshot> open(const std::filesystem::path& filePath);
+
+    ~LicenseSnapshot();
+
+    LicenseSnapshot(LicenseSnapshot&& other) noexcept;
+    LicenseSnapshot& operator=(LicenseSnapshot&& other) noexcept;
+    LicenseSnapshot(const LicenseSnapshot&) = delete;
+    LicenseSnapshot& operator=(const LicenseSnapshot&) = delete;
+
+    /**
+     * @brief Get the name of the licensed project
+     * @return The project name
+     */
+    std::string_view getProjectName() const;
+
+    /**
+     * @brief Get the license key
+     * @return The license key
+     */
+    std::string_view getLicenseKey() const;
+
+    /**
+     * @brief Get the number of contributions
+     * @return Number of contributions
+     */
+    std::size_t getContributionCount() const;
+
+    /**
+     * @brief Get a contribution, in the order License::getContributions() had them
+     * @param index Index of the contribution, below getContributionCount()
+     * @return The contribution
+     * @throws std::out_of_range if index is too large
+     */
+    SnapshotContribution getContribution(std::size_t index) const;
+
+    /**
+     * @brief Find the contribution covering a line
+     * @param fileId Identifier for the file
+     * @param line The line
+     * @return The contribution, or empty if no contribution covers the line
+     */
+    std::optional<SnapshotContribution> findContribution(std::string_view fileId, int line) const;
+
+    /**
+     * @brief Check whether a line range overlaps a contribution, as License::registerContribution() does
+     * @param fileId Identifier for the file
+     * @param lineStart Starting line
+     * @param lineEnd Ending line
+     * @return True if a contribution overlaps the range
+     */
+    bool overlaps(std::string_view fileId, int lineStart, int lineEnd) const;
+
+    /**
+     * @brief Get the exact total of payments for a contributor
+     * @param contributor Name of the contributor
+     * @return Total amount paid to the contributor
+     */
+    Satoshis getContributorTotal(std::string_view contributor) const;
+
+    /**
+     * @brief Get the exact total of all recorded payments
+     * @return Total amount paid to all contributors
+     */
+    Satoshis getTotalPayments() const;
+
+    /**
+     * @brief Rebuild an editable License from the snapshot
+     *
+     * No contribution is scored again and the line index is rebuilt in a
+     * single pass, so this takes time linear in the size of the snapshot.
+     * Metric weights are not stored; the license starts with default
+     * weights, and callers reapply theirs with License::setMetricWeights().
+     *
+     * @return The license, with its contributions and payment ledger
+     * @throws std::invalid_argument if the snapshot holds an invalid project, key or contribution
+     */
+    License toLicense() const;
+
+private:
+    struct Header;
+    struct StringRef;
+    struct ContributionRecord;
+    struct FileRecord;
+    struct RangeRecord;
+    struct PaymentRecord;
+
+    LicenseSnapshot() = default;
+
+    void release();
+    const Header& header() const;
+    std::string_view stringAt(const StringRef& ref) const;
+    SnapshotContribution toContribution(const ContributionRecord& record) const;
+    const FileRecord* findFile(std::string_view fileId) const;
+    const RangeRecord* findRange(const FileRecord& file, int line) const;
+
+    template <typename T>
+    const T* section(std::uint64_t offset) const {
+        return reinterpret_cast<const T*>(m_data + offset);
+    }
+
+    const char* m_data = nullptr;                   ///< First byte of the snapshot
+    std::size_t m_size = 0;                         ///< Number of bytes in the snapshot
+    void* m_mapping = nullptr;                      ///< Mapped region, or null if not mapped
+    std::unique_ptr<std::uint64_t[]> m_buffer;      ///< Owned, aligned contents when not mapped
+};
+
+} // namespace ccsl
+
+#endif // CCSL_LICENSE_SNAPSHOT_HPP
@@ -8,15 +8,24 @@
 #define CCSL_METRICS_HPP
 
 #include <ccsl/license.hpp>
+#include <ccsl/lexer.hpp>
+#include <ccsl/thread_pool.hpp>
 #include <string>
+#include <string_view>
+#include <cstdint>
 #include <vector>
 #include <memory>
+#include <memory_resource>
 #include <functional>
 
 namespace ccsl {
 
 /**
  * @brief Abstract base class for metric evaluators
+ *
+ * Evaluators must be stateless: evaluate() is const and may be called
+ * concurrently from several threads on the same instance, as
+ * MetricsEvaluator::evaluateBatch() does.
  */
 class MetricEvaluator {
 public:
@@ -27,7 +36,29 @@ public:
      * @param code The code fragment to evaluate
      * @return A metric evaluation result
      */
-    virtual MetricEvaluation evaluate(const std::string& code) const = 0;
+    virtual MetricEvaluation evaluate(std::string_view code) const;
+    
+    /**
+     * @brief Evaluate an already scanned code fragment according to this metric
+     * @param summary Summary produced by scanSource()
+     * @return A metric evaluation result
+     */
+    virtual MetricEvaluation evaluate(const SourceSummary& summary) const;
+    
+    /**
+     * @brief Score an already scanned code fragment without formatting a rationale
+     * @param summary Summary produced by scanSource()
+     * @param counts Receives the raw measurements the score is based on
+     * @return Normalized value between 0.0 and 1.0
+     */
+    virtual double score(const SourceSummary& summary, MetricCounts& counts) const = 0;
+    
+    /**
+     * @brief Format the explanation for a score from its raw measurements
+     * @param counts Raw measurements filled in by score()
+     * @return String explaining the score
+     */
+    virtual std::string formatRationale(const MetricCounts& counts) const = 0;
     
     /**
      * @brief Get the type of this metric evaluator
@@ -48,7 +79,8 @@ public:
  */
 class ImpactEvaluator : public MetricEvaluator {
 public:
-    MetricEvaluation evaluate(const std::string& code) const override;
+    double score(const SourceSummary& summary, MetricCounts& counts) const override;
+    std::string formatRationale(const MetricCounts& counts) const override;
     MetricType getType() const override { return MetricType::IMPACT; }
     std::string getDescription() const override;
 };
@@ -59,7 +91,8 @@ public:
  */
 class SimplicityEvaluator : public MetricEvaluator {
 public:
-    MetricEvaluation evaluate(const std::string& code) const override;
+    double score(const SourceSummary& summary, MetricCounts& counts) const override;
+    std::string formatRationale(const MetricCounts& counts) const override;
     MetricType getType() const override { return MetricType::SIMPLICITY; }
     std::string getDescription() const override;
 };
@@ -70,7 +103,8 @@ public:
  */
 class CleanessEvaluator : public MetricEvaluator {
 public:
-    MetricEvaluation evaluate(const std::string& code) const override;
+    double score(const SourceSummary& summary, MetricCounts& counts) const override;
+    std::string formatRationale(const MetricCounts& counts) const override;
     MetricType getType() const override { return MetricType::CLEANNESS; }
     std::string getDescription() const override;
 };
@@ -81,7 +115,8 @@ public:
  */
 class CommentEvaluator : public MetricEvaluator {
 public:
-    MetricEvaluation evaluate(const std::string& code) const override;
+    double score(const SourceSummary& summary, MetricCounts& counts) const override;
+    std::string formatRationale(const MetricCounts& counts) const override;
     MetricType getType() const override { return MetricType::COMMENT; }
     std::string getDescription() const override;
 };
@@ -92,7 +127,8 @@ public:
  */
 class CreditabilityEvaluator : public MetricEvaluator {
 public:
-    MetricEvaluation evaluate(const std::string& code) const override;
+    double score(const SourceSummary& summary, MetricCounts& counts) const override;
+    std::string formatRationale(const MetricCounts& counts) const override;
     MetricType getType() const override { return MetricType::CREDITABILITY; }
     std::string getDescription() const override;
 };
@@ -103,7 +139,8 @@ public:
  */
 class NoveltyEvaluator : public MetricEvaluator {
 public:
-    MetricEvaluation evaluate(const std::string& code) const override;
+    double score(const SourceSummary& summary, MetricCounts& counts) const override;
+    std::string formatRationale(const MetricCounts& counts) const override;
     MetricType getType() const override { return MetricType::NOVELTY; }
     std::string getDescription() const override;
 };
@@ -132,6 +169,14 @@ public:
  */
 class MetricsEvaluator {
 public:
+    /**
+     * @brief Version of the scoring rules
+     *
+     * Bump this whenever a change to the evaluators alters the scores or
+     * counts they produce, so cached results from older builds are ignored.
+     */
+    static constexpr std::uint32_t kVersion = 1;
+    
     /**
      * @brief Constructor
      */
@@ -142,14 +187,96 @@ public:
      * @param code The code fragment to evaluate
      * @return Vector of metric evaluations
      */
-    std::vector<MetricEvaluation> evaluateAll(const std::string& code) const;
+    std::vector<MetricEvaluation> evaluateAll(std::string_view code) const;
+    
+    /**
+     * @brief Evaluate all metrics for a code fragment, allocating the result from a memory resource
+     *
+     * Scanning the fragment allocates nothing, so the result list is the
+     * only allocation besides the rationale strings, which MetricEvaluation
+     * keeps in the default resource. Scans that do not need rationales can
+     * use evaluateScores(), which allocates nothing at all.
+     *
+     * @param code The code fragment to evaluate
+     * @param resource Memory resource for the result, typically one arena per scan
+     * @return Metric evaluations, in the same order as evaluateAll(code)
+     */
+    std::pmr::vector<MetricEvaluation> evaluateAll(std::string_view code, std::pmr::memory_resource* resource) const;
+    
+    /**
+     * @brief Score all metrics for a code fragment without formatting rationales
+     * @param code The code fragment to evaluate
+     * @return Compact scores and raw counts indexed by metric type
+     */
+    MetricScores evaluateScores(std::string_view code) const;
+    
+    /**
+     * @brief Format the rationale for one metric of a compact result
+     * @param scores Scores returned by evaluateScores()
+     * @param type The metric to explain
+     * @return String explaining the score, or empty if the metric was not scored
+     */
+    std::string formatRationale(const MetricScores& scores, MetricType type) const;
+    
+    /**
+     * @brief Expand a compact result into full evaluations with rationales
+     * @param scores Scores returned by evaluateScores()
+     * @return Vector of metric evaluations, as evaluateAll() would return
+     */
+    std::vector<MetricEvaluation> toEvaluations(const MetricScores& scores) const;
     
     /**
      * @brief Calculate the overall value of a code fragment
      * @param code The code fragment to evaluate
      * @return Double value representing the code's worth
      */
-    double calculateValue(const std::string& code) const;
+    double calculateValue(std::string_view code) const;
+    
+    /**
+     * @brief Evaluate all metrics for many code fragments in parallel
+     *
+     * Fragments are spread across the pool's workers; the evaluators are
+     * shared between threads, which is safe because they are stateless.
+     * The fragments must stay alive until the call returns.
+     *
+     * @param fragments The code fragments to evaluate
+     * @param pool Thread pool to run the evaluations on
+     * @return Evaluations laid out fragment by fragment: the evaluation of
+     *         metric m for fragment f is at index f * getMetricCount() + m,
+     *         in the same metric order as evaluateAll()
+     */
+    std::vector<MetricEvaluation> evaluateBatch(
+        const std::vector<std::string_view>& fragments,
+        ThreadPool& pool
+    ) const;
+    
+    /**
+     * @brief Evaluate all metrics for many code fragments in parallel
+     * @param fragments The code fragments to evaluate
+     * @param threadCount Number of worker threads, or 0 for one per hardware thread
+     * @return Evaluations laid out as in evaluateBatch(fragments, pool)
+     */
+    std::vector<MetricEvaluation> evaluateBatch(
+        const std::vector<std::string_view>& fragments,
+        std::size_t threadCount = 0
+    ) const;
+    
+    /**
+     * @brief Score many code fragments in parallel without formatting rationales
+     * @param fragments The code fragments to evaluate
+     * @param pool Thread pool to run the evaluations on
+     * @return One compact result per fragment, in input order
+     */
+    std::vector<MetricScores> evaluateBatchScores(
+        const std::vector<std::string_view>& fragments,
+        ThreadPool& pool
+    ) const;
+    
+    /**
+     * @brief Get the number of metrics evaluated per fragment
+     * @return Number of metric evaluators
+     */
+    std::size_t getMetricCount() const { return m_evaluators.size(); }
     
 private:
     std::vector<std::unique_ptr<MetricEvaluator>> m_evaluators; ///< All metric evaluators
@@ -8,42 +8,110 @@
 #define CCSL_PAYMENT_HPP
 
 #include <ccsl/license.hpp>
+#include <ccsl/transaction_store.hpp>
+#include <ccsl/payment_executor.hpp>
 #include <string>
 #include <vector>
 #include <chrono>
 #include <functional>
 #include <future>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include <utility>
 
 namespace ccsl {
 
+class PayoutEngine;
+
+/**
+ * @brief Callback type for payment verification
+ */
+using PaymentVerificationCallback = std::function<void(const PaymentTransaction&, bool)>;
+
 /**
- * @brief Structure representing a payment transaction
+ * @brief One output of a batched payment
  */
-struct PaymentTransaction {
-    std::string transactionId;        ///< Unique transaction ID
-    std::string sourceWallet;         ///< Source wallet address
+struct PaymentOutput {
+    /**
+     * @brief Constructor
+     * @param destinationWallet Destination wallet address
+     * @param amount Amount to send
+     * @param contributionId ID of the related code contribution
+     */
+    PaymentOutput(std::string destinationWallet, Satoshis amount, std::string contributionId);
+    
+    /**
+     * @brief Constructor for an amount in bitcoins
+     * @param destinationWallet Destination wallet address
+     * @param amount Amount in bitcoins, rounded to whole satoshis; an amount
+     *        Satoshis::tryFromBitcoins() rejects becomes 0 and the output is rejected when sent
+     * @param contributionId ID of the related code contribution
+     */
+    PaymentOutput(std::string destinationWallet, double amount, std::string contributionId);
+    
     std::string destinationWallet;    ///< Destination wallet address
-    double amount;                    ///< Amount in bitcoins
-    std::chrono::system_clock::time_point timestamp; ///< Transaction timestamp
+    Satoshis amount;                  ///< Amount to send
     std::string contributionId;       ///< ID of the related code contribution
-    bool verified;                    ///< Whether the transaction has been verified
 };
 
 /**
- * @brief Callback type for payment verification
+ * @brief Outcome of one output of a batched payment
  */
-using PaymentVerificationCallback = std::function<void(const PaymentTransaction&, bool)>;
+enum class PaymentOutputState {
+    VERIFIED,    ///< Included in the transaction and verified
+    UNVERIFIED,  ///< Included in the transaction but verification failed
+    REJECTED     ///< Left out of the transaction because the output was invalid
+};
+
+/**
+ * @brief Status of one output of a batched payment
+ */
+struct PaymentOutputResult {
+    std::string outputId;             ///< Transaction record ID ("<transactionId>:<index>"), empty if rejected
+    PaymentOutputState state;         ///< Outcome of the output
+    std::string error;                ///< Reason the output was rejected, empty otherwise
+};
+
+/**
+ * @brief Result of a batched payment
+ */
+struct PaymentBatchResult {
+    std::string transactionId;                ///< ID of the multi-output transaction
+    std::vector<PaymentOutputResult> outputs; ///< One status per requested output, in request order
+};
+
+/**
+ * @brief A batched payment that has been sent but not yet verified
+ */
+struct PaymentBatchSubmission {
+    std::string transactionId;                ///< ID of the multi-output transaction
+    std::vector<PaymentOutputResult> outputs; ///< Status when sent: UNVERIFIED if included, REJECTED otherwise
+    std::future<PaymentBatchResult> result;   ///< Per-output status once verified
+};
 
 /**
  * @brief Class for managing Bitcoin micropayments
+ *
+ * Transactions are kept in a TransactionStore that pending verifications
+ * share ownership of, so they can complete safely after the manager has
+ * been destroyed. Copies of a manager share the same store.
+ *
+ * Verifications are timers on a PaymentExecutor rather than threads, so
+ * the number of threads does not grow with the number of payments.
  */
 class BitcoinPaymentManager {
 public:
     /**
      * @brief Constructor
      * @param apiKey API key for the Bitcoin payment provider
+     * @param executor Executor that runs payment verifications, or null for
+     *        the shared PaymentExecutor::getDefault()
      */
-    explicit BitcoinPaymentManager(const std::string& apiKey);
+    explicit BitcoinPaymentManager(
+        const std::string& apiKey,
+        std::shared_ptr<PaymentExecutor> executor = nullptr
+    );
     
     /**
      * @brief Initialize the payment manager
@@ -55,10 +123,31 @@ public:
      * @brief Send a payment
      * @param sourceWallet Source wallet address
      * @param destinationWallet Destination wallet address
+     * @param amount Amount to pay
+     * @param contributionId ID of the related code contribution
+     * @param callback Callback function to be called when the payment is verified
+     * @return A future that will contain the transaction ID when resolved
+     * @throws std::invalid_argument if a wallet is invalid or the amount is not positive
+     * @note Blocks while the executor already holds its maximum number of
+     *       pending verifications
+     */
+    std::future<std::string> sendPayment(
+        const std::string& sourceWallet,
+        const std::string& destinationWallet,
+        Satoshis amount,
+        const std::string& contributionId,
+        PaymentVerificationCallback callback
+    );
+    
+    /**
+     * @brief Send a payment of an amount in bitcoins, rounded to whole satoshis
+     * @param sourceWallet Source wallet address
+     * @param destinationWallet Destination wallet address
      * @param amount Amount in bitcoins
      * @param contributionId ID of the related code contribution
      * @param callback Callback function to be called when the payment is verified
      * @return A future that will contain the transaction ID when resolved
+     * @throws std::invalid_argument if a wallet is invalid or the amount is not positive
      */
     std::future<std::string> sendPayment(
         const std::string& sourceWallet,
@@ -68,8 +157,52 @@ public:
         PaymentVerificationCallback callback
     );
     
+    /**
+     * @brief Send many payments as one multi-output transaction
+     *
+     * All valid outputs share one transaction ID and one verification, so a
+     * payout to hundreds of contributors costs a single network round trip.
+     * Each output is recorded as its own PaymentTransaction with the ID
+     * "<transactionId>:<index>", where index is the output's position in
+     * the request, and can be checked with verifyPayment(). Invalid outputs
+     * are reported as REJECTED instead of failing the whole batch.
+     *
+     * @param sourceWallet Source wallet address
+     * @param outputs Payments to include in the transaction
+     * @param callback Callback function called for each included output once verified
+     * @return A future that will contain the per-output status when resolved
+     * @throws std::invalid_argument if the source wallet is invalid or no output is valid
+     */
+    std::future<PaymentBatchResult> sendPaymentBatch(
+        const std::string& sourceWallet,
+        const std::vector<PaymentOutput>& outputs,
+        PaymentVerificationCallback callback = {}
+    );
+    
+    /**
+     * @brief Send many payments as one multi-output transaction, reporting rejections immediately
+     *
+     * Same as sendPaymentBatch(), but also returns which outputs were
+     * rejected, so a caller can act on them without waiting for the
+     * verification.
+     *
+     * @param sourceWallet Source wallet address
+     * @param outputs Payments to include in the transaction
+     * @param callback Callback function called for each included output once verified
+     * @return The per-output status when sent, and a future of the status once verified
+     * @throws std::invalid_argument if the source wallet is invalid or no output is valid
+     */
+    PaymentBatchSubmission submitPaymentBatch(
+        const std::string& sourceWallet,
+        const std::vector<PaymentOutput>& outputs,
+        PaymentVerificationCallback callback = {}
+    );
+    
     /**
      * @brief Verify a payment transaction
+     *
+     * Never blocks, not even while payments are being sent concurrently.
+     *
      * @param transactionId ID of the transaction to verify
      * @return True if the transaction is verified
      */
@@ -77,20 +210,53 @@ public:
     
     /**
      * @brief Get all transactions
-     * @return Vector of all payment transactions
+     * @return Snapshot of all payment transactions, in the order they were sent
      */
     std::vector<PaymentTransaction> getTransactions() const;
     
+    /**
+     * @brief Visit all transactions without copying them
+     *
+     * Never blocks, not even while payments are being sent concurrently.
+     *
+     * @param visit Called per transaction, in the order they were sent
+     */
+    void forEachTransaction(const TransactionVisitor& visit) const;
+    
     /**
      * @brief Get transactions for a specific contribution
+     *
+     * Never blocks, not even while payments are being sent concurrently.
+     *
      * @param contributionId ID of the contribution
-     * @return Vector of related payment transactions
+     * @return Snapshot of the related payment transactions
      */
     std::vector<PaymentTransaction> getTransactionsForContribution(const std::string& contributionId) const;
     
+    /**
+     * @brief Visit the transactions of a contribution without copying them
+     * @param contributionId ID of the contribution
+     * @param visit Called per related transaction, in the order they were sent
+     */
+    void forEachTransactionForContribution(const std::string& contributionId, const TransactionVisitor& visit) const;
+    
+    /**
+     * @brief Set how long a payment takes to be confirmed by the network
+     * @param delay Delay between sending a payment and verifying it
+     */
+    void setVerificationDelay(std::chrono::milliseconds delay) { m_verificationDelay = delay; }
+    
+    /**
+     * @brief Get how long a payment takes to be confirmed by the network
+     * @return Delay between sending a payment and verifying it
+     */
+    std::chrono::milliseconds getVerificationDelay() const { return m_verificationDelay; }
+    
 private:
     std::string m_apiKey;                            ///< API key for the Bitcoin payment provider
-    std::vector<PaymentTransaction> m_transactions;  ///< All payment transactions
+    std::shared_ptr<TransactionStore> m_transactions; ///< All payment transactions
+    std::shared_ptr<PaymentExecutor> m_executor;     ///< Runs payment verifications
+    std::chrono::milliseconds m_verificationDelay{2000}; ///< Simulated network confirmation delay
 };
 
 /**
@@ -116,6 +282,14 @@ public:
      * @param amount Amount to pay
      * @return True if payment was successful
      */
+    bool processPayment(BitcoinPaymentManager& paymentManager, Satoshis amount);
+    
+    /**
+     * @brief Process a subscription payment of an amount in bitcoins
+     * @param paymentManager Reference to the payment manager
+     * @param amount Amount to pay in bitcoins, rounded to whole satoshis
+     * @return True if payment was successful
+     */
     bool processPayment(BitcoinPaymentManager& paymentManager, double amount);
     
     /**
@@ -128,13 +302,19 @@ public:
      * @brief Get the contributor ID
      * @return String containing the contributor ID
      */
-    std::string getContributorId() const { return m_contributorId; }
+    const std::string& getContributorId() const { return m_contributorId.str(); }
+    
+    /**
+     * @brief Get the contributor ID as interned when the subscription was created
+     * @return The interned contributor ID
+     */
+    InternedString getInternedContributorId() const { return m_contributorId; }
     
     /**
      * @brief Get the wallet address
      * @return String containing the wallet address
      */
-    std::string getWalletAddress() const { return m_walletAddress; }
+    const std::string& getWalletAddress() const { return m_walletAddress; }
     
     /**
      * @brief Get the subscription period in days
@@ -148,15 +328,45 @@ public:
      */
     std::chrono::system_clock::time_point getNextPaymentDate() const { return m_nextPaymentDate; }
     
+    /**
+     * @brief Get the ID of the payment period that is due next
+     *
+     * Subscription payments record it as their contribution ID, so each
+     * period's payment can be found with getTransactionsForContribution().
+     *
+     * @return "<contributorId>:<next payment date in seconds since the epoch>"
+     */
+    std::string getPaymentPeriodId() const;
+    
+    /**
+     * @brief Set the next payment date, e.g. when restoring a saved subscription
+     * @param nextPaymentDate Time point of the next payment
+     */
+    void setNextPaymentDate(std::chrono::system_clock::time_point nextPaymentDate) { m_nextPaymentDate = nextPaymentDate; }
+    
 private:
-    std::string m_contributorId;                    ///< ID of the contributor
+    InternedString m_contributorId;                 ///< ID of the contributor
     std::string m_walletAddress;                    ///< Wallet address of the contributor
     int m_subscriptionPeriod;                       ///< Period in days between payments
     std::chrono::system_clock::time_point m_nextPaymentDate; ///< Next payment date
 };
 
+/**
+ * @brief Amount each due subscription is paid when no payout engine is set
+ */
+constexpr Satoshis kFlatRecurringPayment{100000};
+
 /**
  * @brief Class for managing automatic recurring payments
+ *
+ * Subscriptions are indexed by contributor ID and scheduled in a min-heap
+ * keyed on their next payment date, so a tick only touches the payments
+ * that are actually due. Heap entries of removed or replaced subscriptions
+ * are discarded lazily when they reach the top.
+ *
+ * All payments due in a tick are sent as one multi-output transaction.
+ * With a PayoutEngine each is the contributor's share of the budget;
+ * without one each is kFlatRecurringPayment.
  */
 class RecurringPaymentManager {
 public:
@@ -167,33 +377,127 @@ public:
     explicit RecurringPaymentManager(BitcoinPaymentManager& paymentManager);
     
     /**
-     * @brief Add a subscription
+     * @brief Add a subscription, replacing any existing one for the same contributor
+     *
+     * Runs in O(log n).
+     *
      * @param subscription The subscription to add
      */
     void addSubscription(const PaymentSubscription& subscription);
     
+    /**
+     * @brief Add a subscription by moving it in, replacing any existing one for the same contributor
+     * @param subscription The subscription to add
+     */
+    void addSubscription(PaymentSubscription&& subscription);
+    
+    /**
+     * @brief Construct a subscription and add it without copying
+     * @param args Arguments for the PaymentSubscription constructor
+     * @throws std::invalid_argument if the arguments are invalid
+     */
+    template <typename... Args>
+    void emplaceSubscription(Args&&... args) {
+        addSubscription(PaymentSubscription(std::forward<Args>(args)...));
+    }
+    
     /**
      * @brief Remove a subscription
+     *
+     * Runs in O(1); the scheduled entry is dropped when it comes due.
+     *
      * @param contributorId ID of the contributor
      * @return True if the subscription was removed
      */
     bool removeSubscription(const std::string& contributorId);
     
+    /**
+     * @brief Pay due subscriptions their share of a budget
+     * @param engine Engine computing the shares, or null to pay kFlatRecurringPayment;
+     *               it must stay valid while it is set
+     * @param budget What the whole license pays out per subscription period
+     * @throws std::invalid_argument if budget is negative
+     */
+    void setPayoutEngine(const PayoutEngine* engine, Satoshis budget);
+    
+    /**
+     * @brief Get the payout engine
+     * @return The engine, or null if payments are flat
+     */
+    const PayoutEngine* getPayoutEngine() const { return m_payoutEngine; }
+    
+    /**
+     * @brief Get the budget split by the payout engine
+     * @return Budget per subscription period
+     */
+    Satoshis getPayoutBudget() const { return m_payoutBudget; }
+    
     /**
      * @brief Process all due payments
      * @return Number of payments processed
      */
     int processDuePayments();
     
+    /**
+     * @brief Process the payments due at a given time
+     *
+     * Costs O(k log n) for k due payments, independent of how many
+     * subscriptions are not yet due. The payments go out in a single
+     * batch; paid subscriptions are next due one period after now. A
+     * contributor whose share rounds to nothing is skipped for the whole
+     * period and counted by getSkippedPayments(). A payment left out of the
+     * batch, or every payment if the batch cannot be sent, is not
+     * rescheduled and is retried on the next tick.
+     *
+     * @param now The current time
+     * @return Number of payments included in the batch
+     */
+    int processDuePayments(std::chrono::system_clock::time_point now);
+    
+    /**
+     * @brief Get the payments the last processDuePayments() skipped
+     * @return Number of due subscriptions whose share was zero
+     */
+    std::size_t getSkippedPayments() const { return m_skippedPayments; }
+    
+    /**
+     * @brief Find the subscription of a contributor
+     * @param contributorId ID of the contributor
+     * @return Pointer to the subscription, or null if there is none; valid
+     *         until the subscriptions are next modified
+     */
+    const PaymentSubscription* findSubscription(const std::string& contributorId) const;
+    
     /**
      * @brief Get all subscriptions
-     * @return Vector of all subscriptions
+     * @return Vector of all subscriptions, in no particular order
      */
     const std::vector<PaymentSubscription>& getSubscriptions() const { return m_subscriptions; }
     
 private:
+    struct Slot {
+        std::size_t position;    ///< Index into m_subscriptions
+        std::uint64_t generation; ///< Matches the live schedule entry
+    };
+    
+    struct ScheduleEntry {
+        std::chrono::system_clock::time_point due; ///< Next payment date when scheduled
+        std::string contributorId;                 ///< Subscription to pay
+        std::uint64_t generation;                  ///< Stale unless it matches the slot
+    };
+    
+    void schedule(const std::string& contributorId, std::chrono::system_clock::time_point due);
+    bool isStale(const ScheduleEntry& entry) const;
+    void trimSchedule();
+    
     BitcoinPaymentManager& m_paymentManager;         ///< Reference to the Bitcoin payment manager
     std::vector<PaymentSubscription> m_subscriptions; ///< All subscriptions
+    std::unordered_map<std::string, Slot> m_index;   ///< Subscription slot by contributor ID
+    std::vector<ScheduleEntry> m_schedule;           ///< Min-heap of entries by due date
+    std::uint64_t m_nextGeneration = 0;              ///< Source of schedule generations
+    const PayoutEngine* m_payoutEngine = nullptr;    ///< Computes payment amounts, null for flat payments
+    Satoshis m_payoutBudget;                         ///< Budget per period split by m_payoutEngine
+    std::size_t m_skippedPayments = 0;               ///< Zero-share payments skipped by the last tick
 };
 
 } // namespace ccsl
@@ -0,0 +1,131 @@
+/**
+ * @file payment_executor.hpp
+ * @brief Bounded, timer-driven executor for payment verification
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#ifndef CCSL_PAYMENT_EXECUTOR_HPP
+#define CCSL_PAYMENT_EXECUTOR_HPP
+
+#include <ccsl/thread_pool.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace ccsl {
+
+/**
+ * @brief Runs delayed tasks on a fixed number of threads
+ *
+ * One timer thread keeps the scheduled tasks in a min-heap by due time and
+ * hands each task to a small worker pool once it is due, so waiting for a
+ * network confirmation costs no thread at all. The number of tasks that
+ * are scheduled but not finished is bounded: schedule() blocks while the
+ * executor is full, which pushes back on producers instead of letting the
+ * backlog grow without limit.
+ *
+ * Tasks still waiting when the executor is destroyed are run immediately
+ * rather than dropped, so no promise a task would fulfill is abandoned.
+ */
+class PaymentExecutor {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Constructor
+     * @param workerCount Number of threads that run due tasks
+     * @param capacity Maximum number of scheduled but unfinished tasks
+     * @throws std::invalid_argument if workerCount or capacity is zero
+     */
+    explicit PaymentExecutor(std::size_t workerCount = 2, std::size_t capacity = 4096);
+
+    /**
+     * @brief Destructor; runs the remaining tasks and joins all threads
+     */
+    ~PaymentExecutor();
+
+    PaymentExecutor(const PaymentExecutor&) = delete;
+    PaymentExecutor& operator=(const PaymentExecutor&) = delete;
+
+    /**
+     * @brief Run a task after a delay, waiting while the executor is full
+     *
+     * Must not be called from one of the executor's own tasks, since a full
+     * executor could then wait on itself.
+     *
+     * @param delay Time to wait before the task becomes due
+     * @param task The task to run; exceptions it throws are logged
+     */
+    void schedule(Clock::duration delay, std::function<void()> task);
+
+    /**
+     * @brief Run a task after a delay unless the executor is full
+     * @param delay Time to wait before the task becomes due
+     * @param task The task to run; exceptions it throws are logged
+     * @return False if the executor is full and the task was not scheduled
+     */
+    bool trySchedule(Clock::duration delay, std::function<void()> task);
+
+    /**
+     * @brief Get the number of tasks scheduled but not yet finished
+     * @return Number of pending tasks
+     */
+    std::size_t getPendingCount() const;
+
+    /**
+     * @brief Get the maximum number of pending tasks
+     * @return The capacity
+     */
+    std::size_t getCapacity() const { return m_capacity; }
+
+    /**
+     * @brief Get the number of threads the executor uses
+     * @return Worker threads plus the timer thread
+     */
+    std::size_t getThreadCount() const { return m_workers.getThreadCount() + 1; }
+
+    /**
+     * @brief Get the executor shared by payment managers that are not given one
+     * @return The process-wide default executor
+     */
+    static std::shared_ptr<PaymentExecutor> getDefault();
+
+private:
+    struct Timer {
+        Clock::time_point due;       ///< When the task becomes due
+        std::uint64_t sequence;      ///< Keeps tasks with the same due time in order
+        std::function<void()> task;  ///< The task to run
+    };
+
+    struct LaterFirst {
+        bool operator()(const Timer& a, const Timer& b) const {
+            return a.due != b.due ? a.due > b.due : a.sequence > b.sequence;
+        }
+    };
+
+    void enqueue(Clock::duration delay, std::function<void()> task);
+    void dispatch(std::function<void()> task);
+    void timerLoop();
+
+    const std::size_t m_capacity;                                   ///< Maximum pending tasks
+    mutable std::mutex m_mutex;                                     ///< Guards everything below
+    std::condition_variable m_timerCondition;                       ///< Wakes the timer thread
+    std::condition_variable m_spaceCondition;                       ///< Signals free capacity
+    std::priority_queue<Timer, std::vector<Timer>, LaterFirst> m_timers; ///< Tasks not yet due
+    std::size_t m_pending = 0;                                      ///< Scheduled but unfinished tasks
+    std::uint64_t m_sequence = 0;                                   ///< Next timer sequence number
+    bool m_stopping = false;                                        ///< Set when shutting down
+    ThreadPool m_workers;                                           ///< Runs due tasks
+    std::thread m_timerThread;                                      ///< Waits for the next due task
+};
+
+} // namespace ccsl
+
+#endif // CCSL_PAYMENT_EXECUTOR_HPP
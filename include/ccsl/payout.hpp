@@ -0,0 +1,97 @@
+/**
+ * @file payout.hpp
+ * @brief Splitting a payout budget between contributors by contribution value
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#ifndef CCSL_PAYOUT_HPP
+#define CCSL_PAYOUT_HPP
+
+#include <ccsl/amount.hpp>
+#include <ccsl/license.hpp>
+#include <ccsl/payment.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ccsl {
+
+class ThreadPool;
+
+/**
+ * @brief A contributor's share of a payout
+ */
+struct Payout {
+    std::string contributorId;  ///< ID of the contributor
+    std::string walletAddress;  ///< Wallet the share is sent to
+    double value = 0.0;         ///< Weighted value of the contributor's contributions
+    Satoshis amount;            ///< Share of the budget, rounded down to whole satoshis
+};
+
+/**
+ * @brief Computes each contributor's share of a payout budget from a license
+ *
+ * A contributor's share is the budget times their fraction of the
+ * license's total weighted value. Both come from the totals the License
+ * keeps up to date, so computing a payout reads one cached total per
+ * recipient and never visits a contribution. The budget is split over all
+ * contributors, not just the recipients: the shares of contributors
+ * without a subscription, and the satoshis lost to rounding down, stay
+ * unpaid.
+ *
+ * With a thread pool the recipients are split into chunks computed in
+ * parallel. The engine only reads the license, which must outlive it and
+ * must not change while a payout is computed.
+ */
+class PayoutEngine {
+public:
+    /**
+     * @brief Constructor
+     * @param license License whose contribution values decide the shares
+     * @param pool Thread pool for large payouts, or null to compute on the calling thread
+     */
+    explicit PayoutEngine(const License& license, ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Compute the shares of a set of recipients
+     * @param recipients Subscriptions to pay, at most one per contributor
+     * @param budget Amount split over all of the license's contributors
+     * @return One payout per recipient, in recipient order; contributors without value get 0
+     * @throws std::invalid_argument if budget is negative
+     */
+    std::vector<Payout> computePayouts(const std::vector<PaymentSubscription>& recipients, Satoshis budget) const;
+
+    /**
+     * @brief Compute the shares of a set of recipients
+     * @param recipients Subscriptions to pay, at most one per contributor; none may be null
+     * @param budget Amount split over all of the license's contributors
+     * @return One payout per recipient, in recipient order; contributors without value get 0
+     * @throws std::invalid_argument if budget is negative
+     */
+    std::vector<Payout> computePayouts(const std::vector<const PaymentSubscription*>& recipients, Satoshis budget) const;
+
+    /**
+     * @brief Compute one contributor's share
+     * @param contributorId ID of the contributor
+     * @param budget Amount split over all of the license's contributors
+     * @return The share, or 0 if the contributor or the license has no value
+     */
+    Satoshis computeShare(const std::string& contributorId, Satoshis budget) const;
+
+    /**
+     * @brief Get the license the shares are computed from
+     * @return The license
+     */
+    const License& getLicense() const { return m_license; }
+
+private:
+    template <typename Recipients>
+    std::vector<Payout> compute(const Recipients& recipients, Satoshis budget) const;
+
+    const License& m_license; ///< Source of the contribution values
+    ThreadPool* m_pool;       ///< Pool for parallel payouts, may be null
+};
+
+} // namespace ccsl
+
+#endif // CCSL_PAYOUT_HPP
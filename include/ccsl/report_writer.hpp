@@ -0,0 +1,142 @@
+/**
+ * @file report_writer.hpp
+ * @brief Buffered text writer for streaming reports to a stream or callback
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#ifndef CCSL_REPORT_WRITER_HPP
+#define CCSL_REPORT_WRITER_HPP
+
+#include <ccsl/amount.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string_view>
+
+namespace ccsl {
+
+/**
+ * @brief Receives report text in chunks, in order
+ */
+using ReportSink = std::function<void(std::string_view)>;
+
+/**
+ * @brief Formats report text into a fixed buffer and hands it to a sink when full
+ *
+ * Numbers are formatted with std::to_chars, so writing a report allocates
+ * nothing beyond what the sink does. Text still buffered is flushed by
+ * flush() or the destructor.
+ */
+class ReportWriter {
+public:
+    /**
+     * @brief Create a writer that hands chunks to a callback
+     * @param sink The callback
+     */
+    explicit ReportWriter(ReportSink sink);
+
+    /**
+     * @brief Create a writer that writes to a stream
+     * @param out The stream; it must outlive the writer
+     */
+    explicit ReportWriter(std::ostream& out);
+
+    ~ReportWriter();
+
+    ReportWriter(const ReportWriter&) = delete;
+    ReportWriter& operator=(const ReportWriter&) = delete;
+
+    /**
+     * @brief Append text
+     * @param text The text
+     * @return This writer
+     */
+    ReportWriter& operator<<(std::string_view text);
+
+    /**
+     * @brief Append a single character
+     * @param c The character
+     * @return This writer
+     */
+    ReportWriter& operator<<(char c);
+
+    /**
+     * @brief Append an integer in decimal
+     * @param value The integer
+     * @return This writer
+     */
+    ReportWriter& operator<<(std::int64_t value);
+
+    /**
+     * @brief Append an integer in decimal
+     * @param value The integer
+     * @return This writer
+     */
+    ReportWriter& operator<<(int value) { return *this << static_cast<std::int64_t>(value); }
+
+    /**
+     * @brief Append an unsigned integer in decimal
+     * @param value The integer
+     * @return This writer
+     */
+    ReportWriter& operator<<(std::uint64_t value);
+
+    /**
+     * @brief Append a number as std::ostream does by default (6 significant digits)
+     * @param value The number
+     * @return This writer
+     */
+    ReportWriter& operator<<(double value);
+
+    /**
+     * @brief Append a number with a fixed number of decimals
+     * @param value The number
+     * @param decimals Digits after the decimal point, at most kMaxDecimals
+     * @return This writer
+     */
+    ReportWriter& writeFixed(double value, int decimals);
+
+    /**
+     * @brief Append a Bitcoin amount as formatBitcoinAmount() formats it
+     * @param amount The amount in bitcoins
+     * @return This writer
+     */
+    ReportWriter& writeBitcoinAmount(double amount) { return writeFixed(amount, 8); }
+
+    /**
+     * @brief Append an exact Bitcoin amount with 8 decimals
+     * @param amount The amount
+     * @return This writer
+     */
+    ReportWriter& writeBitcoinAmount(Satoshis amount);
+
+    /**
+     * @brief Hand all buffered text to the sink
+     */
+    void flush();
+
+    /**
+     * @brief Largest number of decimals writeFixed() writes
+     */
+    static constexpr int kMaxDecimals = 60;
+
+private:
+    static constexpr std::size_t kBufferSize = 4096;
+    // Room for any number: a double has up to 309 integer digits, plus sign, point and decimals
+    static constexpr std::size_t kMaxNumberSize = 400;
+
+    void reserveNumber() {
+        if (m_size + kMaxNumberSize > kBufferSize) {
+            flush();
+        }
+    }
+
+    ReportSink m_sink;                  ///< Where full buffers go
+    char m_buffer[kBufferSize];         ///< Text not yet handed to the sink
+    std::size_t m_size = 0;             ///< Bytes used in m_buffer
+};
+
+} // namespace ccsl
+
+#endif // CCSL_REPORT_WRITER_HPP
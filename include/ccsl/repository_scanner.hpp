@@ -0,0 +1,135 @@
+/**
+ * @file repository_scanner.hpp
+ * @brief Pipelined discovery, reading, evaluation and registration of a source tree
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#ifndef CCSL_REPOSITORY_SCANNER_HPP
+#define CCSL_REPOSITORY_SCANNER_HPP
+
+#include <ccsl/license.hpp>
+#include <ccsl/metrics.hpp>
+#include <ccsl/source_classifier.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ccsl {
+
+/**
+ * @brief Files processed so far by each stage of a scan
+ */
+struct ScanProgress {
+    std::size_t discovered = 0;  ///< Files found that match the options
+    std::size_t read = 0;        ///< Files mapped into memory
+    std::size_t evaluated = 0;   ///< Files scored
+    std::size_t registered = 0;  ///< Contributions accepted by the license
+    std::size_t rejected = 0;    ///< Contributions the license refused, e.g. overlapping ones
+    std::size_t skipped = 0;     ///< Empty files, files over the size limit and files the classifier rejects
+    std::size_t failed = 0;      ///< Files or directories that could not be read
+    std::uintmax_t bytes = 0;    ///< Bytes read
+};
+
+/**
+ * @brief Settings for a RepositoryScanner
+ */
+struct RepositoryScanOptions {
+    std::string contributor = "unknown";   ///< Contributor every file is attributed to
+    std::vector<std::string> extensions = {".c", ".cc", ".cpp", ".cxx", ".h", ".hh", ".hpp", ".hxx"}; ///< File extensions to scan; empty scans every regular file
+    std::uintmax_t maxFileSize = 64u << 20; ///< Larger files are skipped
+    std::size_t readThreads = 2;           ///< Threads mapping files into memory
+    std::size_t evaluateThreads = 0;       ///< Threads scoring files, or 0 for one per hardware thread
+    std::size_t queueCapacity = 64;        ///< Files each queue between stages holds at most
+    bool followSymlinks = false;           ///< Whether to descend into symlinked directories
+    bool classifyFiles = true;             ///< Whether to skip binary, minified and non-C-family files before scoring them
+    SourceClassifierOptions classifier;    ///< Limits for classifyFiles; with an empty extension list, no extension is rejected
+    std::function<void(const ScanProgress&)> onProgress; ///< Called from the registration thread after each contribution and once at the end
+};
+
+/**
+ * @brief Outcome of a scan
+ */
+struct RepositoryScanResult {
+    ScanProgress progress;                       ///< Final counts
+    std::vector<std::filesystem::path> failures; ///< Paths that could not be read
+    bool cancelled = false;                      ///< Whether cancel() stopped the scan early
+};
+
+/**
+ * @brief Scores every source file under a directory and registers it with a License
+ *
+ * A scan runs four stages connected by bounded queues: one thread walks
+ * the tree, readThreads threads map files into memory, evaluateThreads
+ * threads score them, and the calling thread registers the contributions,
+ * since License is not thread-safe. Files are read while others are scored, and
+ * the queues keep memory use bounded however large the tree is.
+ *
+ * Each file becomes one contribution spanning all of its lines (0-based),
+ * identified by its path relative to the root in generic form.
+ */
+class RepositoryScanner {
+public:
+    /**
+     * @brief Constructor
+     * @param options Settings for every scan
+     * @throws std::invalid_argument if the contributor is empty, or readThreads or queueCapacity is zero
+     */
+    explicit RepositoryScanner(RepositoryScanOptions options = {});
+
+    /**
+     * @brief Scan a directory tree and wait for the scan to finish
+     *
+     * Contributions are registered in no particular order. A scanner runs
+     * one scan at a time.
+     *
+     * @param root The directory to scan
+     * @param license Receives one contribution per scored file
+     * @return Counts and failures; a root that is not a directory counts as one failure
+     */
+    RepositoryScanResult scan(const std::filesystem::path& root, License& license);
+
+    /**
+     * @brief Stop the scan in progress as soon as possible
+     *
+     * Safe to call from any thread, including from the progress callback.
+     * Files already registered stay registered.
+     */
+    void cancel();
+
+    /**
+     * @brief Get the counts of the scan in progress, or of the last scan
+     * @return Counts so far
+     */
+    ScanProgress getProgress() const;
+
+private:
+    struct Counters {
+        std::atomic<std::size_t> discovered{0};
+        std::atomic<std::size_t> read{0};
+        std::atomic<std::size_t> evaluated{0};
+        std::atomic<std::size_t> registered{0};
+        std::atomic<std::size_t> rejected{0};
+        std::atomic<std::size_t> skipped{0};
+        std::atomic<std::size_t> failed{0};
+        std::atomic<std::uintmax_t> bytes{0};
+    };
+
+    bool matches(const std::filesystem::path& path) const;
+
+    RepositoryScanOptions m_options;       ///< Settings for every scan
+    SourceClassifier m_classifier;         ///< Rejects files not worth scoring; shared by the reading threads
+    MetricsEvaluator m_evaluator;          ///< Shared by the evaluation threads
+    Counters m_counters;                   ///< Counts of the current scan
+    std::atomic<bool> m_cancelled{false};  ///< Set by cancel()
+    std::function<void()> m_cancelQueues;  ///< Wakes the stages of the current scan; guarded by m_cancelMutex
+    mutable std::mutex m_cancelMutex;      ///< Guards m_cancelQueues
+};
+
+} // namespace ccsl
+
+#endif // CCSL_REPOSITORY_SCANNER_HPP
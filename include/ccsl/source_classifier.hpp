@@ -0,0 +1,117 @@
+/**
+ * @file source_classifier.hpp
+ * @brief Cheap check of whether a file is C-family source worth scoring
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#ifndef CCSL_SOURCE_CLASSIFIER_HPP
+#define CCSL_SOURCE_CLASSIFIER_HPP
+
+#include <cstddef>
+#include <string_view>
+
+namespace ccsl {
+
+/**
+ * @brief Language a file is written in, as far as the classifier can tell
+ */
+enum class SourceLanguage {
+    UNKNOWN, ///< No path, or an extension without a known language
+    C,       ///< C source or header
+    CPP      ///< C++ source or header
+};
+
+/**
+ * @brief What a scan should do with a file
+ */
+enum class SourceVerdict {
+    EVALUATE,     ///< Source the evaluators understand
+    NOT_C_FAMILY, ///< Written in a language the evaluators were not made for
+    BINARY,       ///< Holds NUL bytes, so it is not text
+    MINIFIED      ///< Lines too long for hand-written code, e.g. generated or minified
+};
+
+/**
+ * @brief Outcome of classifying a file
+ */
+struct SourceClassification {
+    SourceLanguage language = SourceLanguage::UNKNOWN; ///< Language from the extension
+    SourceVerdict verdict = SourceVerdict::EVALUATE;   ///< Whether to score the file
+    std::size_t lineCount = 0;   ///< Lines measured, 0 if the file was rejected before measuring
+    std::size_t longestLine = 0; ///< Length of the longest line in bytes
+    std::size_t longLines = 0;   ///< Lines longer than SourceClassifierOptions::longLineLength
+
+    /**
+     * @brief Check whether the file should be scored
+     * @return True if the verdict is EVALUATE
+     */
+    bool shouldEvaluate() const { return verdict == SourceVerdict::EVALUATE; }
+};
+
+/**
+ * @brief Limits that decide when a file is not worth scoring
+ */
+struct SourceClassifierOptions {
+    std::size_t binaryProbeBytes = 8192;  ///< Leading bytes searched for NUL, as git does
+    std::size_t maxLineLength = 4096;     ///< Any longer line marks the file as minified
+    std::size_t longLineLength = 300;     ///< Lines longer than this count as long
+    double maxLongLineFraction = 0.25;    ///< More long lines than this fraction marks the file as minified
+    bool requireKnownExtension = true;    ///< Whether a path with an unknown extension is NOT_C_FAMILY
+};
+
+/**
+ * @brief Decides, before any scoring, whether a file is C-family source
+ *
+ * Runs in front of the evaluators so inputs they were not written for,
+ * such as binaries, minified scripts or generated tables, cost a single
+ * memchr() pass instead of stalling a scan worker. Checks run from
+ * cheapest to dearest: the extension, NUL bytes in the first
+ * binaryProbeBytes, then the distribution of line lengths.
+ *
+ * C and C++ share one lexer, so every C-family file is scored with the
+ * same evaluators; the language is reported for callers who treat them
+ * differently. The classifier is immutable and may be shared by threads.
+ */
+class SourceClassifier {
+public:
+    /**
+     * @brief Constructor
+     * @param options Limits for every classification
+     */
+    explicit SourceClassifier(const SourceClassifierOptions& options = SourceClassifierOptions());
+
+    /**
+     * @brief Classify a file
+     * @param path Path or name of the file, used for its extension; may be empty
+     * @param contents Contents of the file
+     * @return The classification
+     */
+    SourceClassification classify(std::string_view path, std::string_view contents) const;
+
+    /**
+     * @brief Get the language an extension belongs to
+     * @param path Path or name of the file
+     * @return The language, or UNKNOWN if the extension is not a C-family one
+     */
+    static SourceLanguage languageOf(std::string_view path);
+
+    /**
+     * @brief Get the limits of the classifier
+     * @return The options
+     */
+    const SourceClassifierOptions& getOptions() const { return m_options; }
+
+private:
+    SourceClassifierOptions m_options; ///< Limits for every classification
+};
+
+/**
+ * @brief Get a short name for a verdict
+ * @param verdict The verdict
+ * @return Name such as "binary"
+ */
+const char* verdictName(SourceVerdict verdict);
+
+} // namespace ccsl
+
+#endif // CCSL_SOURCE_CLASSIFIER_HPP
@@ -0,0 +1,97 @@
+/**
+ * @file source_file.hpp
+ * @brief Memory-mapped source file with a line-offset index
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#ifndef CCSL_SOURCE_FILE_HPP
+#define CCSL_SOURCE_FILE_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ccsl {
+
+/**
+ * @brief Read-only view of a source file that is mapped into memory once
+ *
+ * The line-offset index is built when the file is opened, so any number of
+ * line ranges can be sliced out of it without rereading or copying. Views
+ * returned by the accessors stay valid for the lifetime of the SourceFile
+ * (moving it keeps them valid too).
+ */
+class SourceFile {
+public:
+    /**
+     * @brief Map a file into memory and index its lines
+     * @param filePath Path to the code file
+     * @return The opened file, or empty if it couldn't be read
+     */
+    static std::optional<SourceFile> open(const std::filesystem::path& filePath);
+
+    /**
+     * @brief Wrap text already held in memory
+     * @param contents The text to index; it is copied into the SourceFile
+     * @return The indexed file
+     */
+    static SourceFile fromString(std::string contents);
+
+    ~SourceFile();
+
+    SourceFile(SourceFile&& other) noexcept;
+    SourceFile& operator=(SourceFile&& other) noexcept;
+    SourceFile(const SourceFile&) = delete;
+    SourceFile& operator=(const SourceFile&) = delete;
+
+    /**
+     * @brief Get the whole file contents
+     * @return View of every byte of the file
+     */
+    std::string_view getContents() const { return std::string_view(m_data, m_size); }
+
+    /**
+     * @brief Get the number of lines in the file
+     *
+     * Lines are counted like std::getline does: a trailing newline does not
+     * start a new, empty line.
+     *
+     * @return Number of lines
+     */
+    std::size_t getLineCount() const { return m_lineOffsets.size(); }
+
+    /**
+     * @brief Get a single line without its newline
+     * @param line The line (0-based)
+     * @return View of the line, or empty if it is past the end of the file
+     */
+    std::string_view getLine(std::size_t line) const;
+
+    /**
+     * @brief Get a range of lines, including their newlines
+     * @param startLine Starting line (0-based)
+     * @param endLine Ending line (0-based, inclusive); clamped to the last line
+     * @return View of the lines, or empty if startLine is past the end of the file
+     */
+    std::string_view getLines(std::size_t startLine, std::size_t endLine) const;
+
+private:
+    SourceFile() = default;
+
+    void buildLineIndex();
+    void release();
+
+    const char* m_data = nullptr;           ///< First byte of the contents
+    std::size_t m_size = 0;                 ///< Number of bytes in the contents
+    void* m_mapping = nullptr;              ///< Mapped region, or null if not mapped
+    std::unique_ptr<char[]> m_buffer;       ///< Owned contents when not mapped
+    std::vector<std::size_t> m_lineOffsets; ///< Offset of the first byte of each line
+};
+
+} // namespace ccsl
+
+#endif // CCSL_SOURCE_FILE_HPP
@@ -0,0 +1,187 @@
+/**
+ * @file string_interner.hpp
+ * @brief Process-wide table of interned strings with 32-bit IDs
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#ifndef CCSL_STRING_INTERNER_HPP
+#define CCSL_STRING_INTERNER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+namespace ccsl {
+
+/**
+ * @brief Identifier of an interned string; 0 is always the empty string
+ */
+using StringId = std::uint32_t;
+
+/**
+ * @brief Stores each distinct string once and hands out dense 32-bit IDs
+ *
+ * Strings are never removed, and once interned they never move, so
+ * references returned by lookup() stay valid for the life of the process.
+ * lookup() takes no lock; intern() and find() share a reader-writer lock
+ * and only take it exclusively to add a new string. All member functions
+ * are thread-safe.
+ */
+class StringInterner {
+public:
+    /**
+     * @brief Get the interner shared by the whole library
+     * @return The process-wide interner
+     */
+    static StringInterner& get();
+
+    StringInterner();
+    ~StringInterner();
+
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    /**
+     * @brief Get the ID of a string, adding the string if it is new
+     * @param text The string
+     * @return Its ID
+     * @throws std::length_error if 2^32 strings are already interned
+     */
+    StringId intern(std::string_view text);
+
+    /**
+     * @brief Get the ID of a string without adding it
+     * @param text The string
+     * @return Its ID, or empty if it has not been interned
+     */
+    std::optional<StringId> find(std::string_view text) const;
+
+    /**
+     * @brief Get the string behind an ID
+     * @param id An ID returned by intern()
+     * @return The string, or the empty string if no string has this ID
+     */
+    const std::string& lookup(StringId id) const;
+
+    /**
+     * @brief Get the number of interned strings, including the empty string
+     * @return Number of strings
+     */
+    std::size_t size() const { return m_size.load(std::memory_order_acquire); }
+
+private:
+    // Block b holds kFirstBlockSize << b strings, so 23 blocks cover every 32-bit ID
+    static constexpr unsigned kFirstBlockBits = 10;
+    static constexpr std::size_t kFirstBlockSize = std::size_t(1) << kFirstBlockBits;
+    static constexpr std::size_t kBlockCount = 23;
+
+    std::string* slot(StringId id) const;
+
+    std::array<std::atomic<std::string*>, kBlockCount> m_blocks{};  ///< Storage; allocated on demand, never moved
+    std::atomic<std::size_t> m_size{0};                             ///< IDs handed out so far
+    mutable std::shared_mutex m_mutex;                              ///< Guards m_ids and additions
+    std::unordered_map<std::string_view, StringId> m_ids;           ///< Views into m_blocks, by content
+};
+
+/**
+ * @brief A string stored as its ID in the shared StringInterner
+ *
+ * Takes 4 bytes regardless of the string's length; copying, comparing and
+ * hashing are integer operations. It converts implicitly from and to
+ * strings, so it can replace a std::string field without changing callers.
+ * Constructing one from a string interns the string; use find() for
+ * lookups that should not add strings.
+ */
+class InternedString {
+public:
+    /**
+     * @brief The empty string
+     */
+    InternedString() = default;
+
+    /**
+     * @brief Intern a string
+     * @param text The string
+     */
+    InternedString(std::string_view text) : m_id(StringInterner::get().intern(text)) {}
+    InternedString(const std::string& text) : InternedString(std::string_view(text)) {}
+    InternedString(const char* text) : InternedString(std::string_view(text)) {}
+
+    /**
+     * @brief Look up a string without interning it
+     * @param text The string
+     * @return The interned string, or empty if the string has not been interned
+     */
+    static std::optional<InternedString> find(std::string_view text);
+
+    /**
+     * @brief Get the ID in the shared interner
+     * @return The ID
+     */
+    StringId getId() const { return m_id; }
+
+    /**
+     * @brief Get the string
+     * @return The string, valid for the life of the process
+     */
+    const std::string& str() const { return StringInterner::get().lookup(m_id); }
+
+    /**
+     * @brief Check whether this is the empty string
+     * @return True if the string is empty
+     */
+    bool empty() const { return m_id == 0; }
+
+    operator const std::string&() const { return str(); }
+
+    friend bool operator==(InternedString a, InternedString b) { return a.m_id == b.m_id; }
+    friend bool operator!=(InternedString a, InternedString b) { return a.m_id != b.m_id; }
+
+    // Comparing with plain text compares characters and interns nothing
+    template <typename Text, typename = std::enable_if_t<std::is_convertible_v<const Text&, std::string_view>>>
+    friend bool operator==(InternedString a, const Text& b) { return std::string_view(a.str()) == std::string_view(b); }
+    template <typename Text, typename = std::enable_if_t<std::is_convertible_v<const Text&, std::string_view>>>
+    friend bool operator==(const Text& a, InternedString b) { return b == a; }
+    template <typename Text, typename = std::enable_if_t<std::is_convertible_v<const Text&, std::string_view>>>
+    friend bool operator!=(InternedString a, const Text& b) { return !(a == b); }
+    template <typename Text, typename = std::enable_if_t<std::is_convertible_v<const Text&, std::string_view>>>
+    friend bool operator!=(const Text& a, InternedString b) { return !(b == a); }
+
+private:
+    explicit InternedString(StringId id, bool) : m_id(id) {}
+
+    StringId m_id = 0; ///< ID in the shared interner
+};
+
+/**
+ * @brief Write the string
+ * @param out The stream
+ * @param text The interned string
+ * @return The stream
+ */
+std::ostream& operator<<(std::ostream& out, InternedString text);
+
+} // namespace ccsl
+
+namespace std {
+
+/**
+ * @brief Hashes the ID, which is unique per string
+ */
+template <>
+struct hash<ccsl::InternedString> {
+    std::size_t operator()(ccsl::InternedString text) const noexcept { return text.getId(); }
+};
+
+} // namespace std
+
+#endif // CCSL_STRING_INTERNER_HPP
@@ -0,0 +1,92 @@
+/**
+ * @file thread_pool.hpp
+ * @brief Work-stealing thread pool used for parallel evaluation
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#ifndef CCSL_THREAD_POOL_HPP
+#define CCSL_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ccsl {
+
+/**
+ * @brief Fixed-size thread pool with per-worker queues and work stealing
+ *
+ * Each worker pops tasks from the back of its own queue and, when that is
+ * empty, steals from the front of the other workers' queues. Threads that
+ * wait on a parallelFor() help run queued tasks, so the pool can be used
+ * from inside its own tasks without deadlocking.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Constructor
+     * @param threadCount Number of worker threads, or 0 for one per hardware thread
+     */
+    explicit ThreadPool(std::size_t threadCount = 0);
+
+    /**
+     * @brief Destructor; runs the remaining queued tasks and joins all workers
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Get the number of worker threads
+     * @return Number of worker threads
+     */
+    std::size_t getThreadCount() const { return m_workers.size(); }
+
+    /**
+     * @brief Queue a task for execution on a worker thread
+     * @param task The task to run; it must not throw
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Run body(i) for every i in [0, count) and wait for completion
+     * @param count Number of iterations
+     * @param body Function called once per iteration, possibly concurrently
+     * @throws Rethrows the first exception thrown by body
+     */
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& body);
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;                        ///< Guards tasks
+        std::deque<std::function<void()>> tasks; ///< Queued tasks
+    };
+
+    /**
+     * @brief Run one queued task, preferring the given queue
+     * @param queueIndex Queue to pop from first before stealing
+     * @return True if a task was run
+     */
+    bool runPendingTask(std::size_t queueIndex);
+
+    void workerLoop(std::size_t queueIndex);
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues; ///< One queue per worker
+    std::vector<std::thread> m_workers;                 ///< Worker threads
+    std::mutex m_mutex;                                 ///< Guards sleeping and shutdown
+    std::condition_variable m_condition;                ///< Signals new work or shutdown
+    std::atomic<std::size_t> m_queued{0};               ///< Tasks queued but not yet started
+    std::atomic<std::size_t> m_nextQueue{0};            ///< Round-robin submission index
+    bool m_stopping = false;                            ///< Set when the pool is shutting down
+};
+
+} // namespace ccsl
+
+#endif // CCSL_THREAD_POOL_HPP
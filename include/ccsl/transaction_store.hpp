@@ -0,0 +1,144 @@
+/**
+ * @file transaction_store.hpp
+ * @brief Concurrent, append-only table of payment transactions
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#ifndef CCSL_TRANSACTION_STORE_HPP
+#define CCSL_TRANSACTION_STORE_HPP
+
+#include <ccsl/amount.hpp>
+#include <ccsl/string_interner.hpp>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace ccsl {
+
+/**
+ * @brief Structure representing a payment transaction
+ */
+struct PaymentTransaction {
+    std::string transactionId;        ///< Unique transaction ID
+    std::string sourceWallet;         ///< Source wallet address
+    std::string destinationWallet;    ///< Destination wallet address
+    Satoshis amount;                  ///< Amount paid
+    std::chrono::system_clock::time_point timestamp; ///< Transaction timestamp
+    InternedString contributionId;    ///< ID of the related code contribution
+    bool verified;                    ///< Whether the transaction has been verified
+};
+
+/**
+ * @brief Receives a stored transaction without copying it
+ *
+ * The verified argument is the current status; the transaction's own
+ * verified field holds the status it was stored with. Returning false
+ * stops the walk.
+ */
+using TransactionVisitor = std::function<bool(const PaymentTransaction& transaction, bool verified)>;
+
+/**
+ * @brief Thread-safe store of payment transactions with lock-free reads
+ *
+ * Transactions are never removed, which lets readers run without locks:
+ * lookups by transaction ID and by contribution ID walk hash chains that
+ * writers only ever extend, using acquire loads against the writers'
+ * release stores. Writers serialize on a mutex among themselves but never
+ * block readers. The verified flag is the only mutable field and is
+ * updated atomically in place.
+ *
+ * Lookups by transaction ID are O(1) on average; lookups by contribution
+ * are proportional to the number of matching transactions, and compare
+ * interned IDs rather than strings.
+ */
+class TransactionStore {
+public:
+    TransactionStore();
+    ~TransactionStore();
+
+    TransactionStore(const TransactionStore&) = delete;
+    TransactionStore& operator=(const TransactionStore&) = delete;
+
+    /**
+     * @brief Add a transaction
+     * @param transaction The transaction to add
+     * @return False if a transaction with the same ID is already stored
+     */
+    bool insert(const PaymentTransaction& transaction);
+
+    /**
+     * @brief Update the verification status of a transaction
+     * @param transactionId ID of the transaction
+     * @param verified New verification status
+     * @return False if no transaction has this ID
+     */
+    bool setVerified(const std::string& transactionId, bool verified);
+
+    /**
+     * @brief Get the verification status of a transaction
+     * @param transactionId ID of the transaction
+     * @return True if the transaction exists and is verified
+     */
+    bool isVerified(const std::string& transactionId) const;
+
+    /**
+     * @brief Look up a transaction by ID
+     * @param transactionId ID of the transaction
+     * @return Copy of the transaction, or empty if it is not stored
+     */
+    std::optional<PaymentTransaction> find(const std::string& transactionId) const;
+
+    /**
+     * @brief Get the transactions of a contribution
+     * @param contributionId ID of the contribution
+     * @return Copies of the matching transactions, in insertion order
+     */
+    std::vector<PaymentTransaction> findByContribution(const std::string& contributionId) const;
+
+    /**
+     * @brief Visit all transactions in place
+     * @param visit Called per transaction, in insertion order
+     */
+    void forEach(const TransactionVisitor& visit) const;
+
+    /**
+     * @brief Visit the transactions of a contribution in place
+     * @param contributionId ID of the contribution
+     * @param visit Called per matching transaction, in insertion order
+     */
+    void forEachByContribution(const std::string& contributionId, const TransactionVisitor& visit) const;
+
+    /**
+     * @brief Get all transactions
+     * @return Copies of every transaction, in insertion order
+     */
+    std::vector<PaymentTransaction> snapshot() const;
+
+    /**
+     * @brief Get the number of stored transactions
+     * @return Number of transactions
+     */
+    std::size_t size() const { return m_size.load(std::memory_order_acquire); }
+
+private:
+    struct Record;
+    template <typename Key>
+    struct Index;
+
+    std::mutex m_writeMutex;                          ///< Serializes writers
+    std::vector<std::unique_ptr<Record>> m_records;   ///< Owns the records; only writers touch it
+    std::atomic<const Record*> m_newest{nullptr};     ///< Most recently inserted record
+    std::atomic<std::size_t> m_size{0};               ///< Number of published records
+    std::unique_ptr<Index<std::string>> m_byId;       ///< Index by transaction ID
+    std::unique_ptr<Index<InternedString>> m_byContribution; ///< Index by contribution ID
+};
+
+} // namespace ccsl
+
+#endif // CCSL_TRANSACTION_STORE_HPP
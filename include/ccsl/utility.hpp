@@ -7,30 +7,80 @@
 #ifndef CCSL_UTILITY_HPP
 #define CCSL_UTILITY_HPP
 
+#include <array>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <cstdint>
 #include <optional>
+#include <unordered_map>
+#include <chrono>
 #include <filesystem>
+#include <ccsl/amount.hpp>
+#include <ccsl/source_file.hpp>
 
 namespace ccsl {
 
+/**
+ * @brief UUID layouts generateUUID() can produce
+ */
+enum class UUIDVersion {
+    V4 = 4, ///< 122 random bits
+    V7 = 7  ///< Unix time in milliseconds and sub-millisecond fraction, then random bits; sorts by creation time
+};
+
+/**
+ * @brief Canonical text form of a UUID, e.g. "0190f3c2-7a1e-7c3d-9f1b-3a5e0c6d2b48", without terminator
+ */
+using UUIDChars = std::array<char, 36>;
+
+/**
+ * @brief Generates a unique identifier without allocating
+ *
+ * Random bits come from a generator private to the calling thread, so
+ * concurrent calls need no locking. Version 7 identifiers generated by one
+ * thread are strictly increasing.
+ *
+ * @param version The UUID layout
+ * @return The UUID as 36 lower-case characters
+ */
+UUIDChars generateUUIDChars(UUIDVersion version = UUIDVersion::V4);
+
 /**
  * @brief Generates a unique identifier
+ * @param version The UUID layout
  * @return A string containing a UUID
  */
-std::string generateUUID();
+std::string generateUUID(UUIDVersion version = UUIDVersion::V4);
+
+/**
+ * @brief Calculates a 64-bit hash of a byte sequence
+ *
+ * Implements XXH64, so the value is stable across platforms, compilers and
+ * runs and can be persisted. The function does not allocate.
+ *
+ * @param data The bytes to hash
+ * @param seed Seed mixed into the hash
+ * @return The hash value
+ */
+std::uint64_t hashBytes(std::string_view data, std::uint64_t seed = 0);
 
 /**
  * @brief Calculates a hash value for a string
  * @param input The string to hash
- * @return A string containing the hash
+ * @return A string containing the hash as 16 hex digits, or empty for empty input
  */
-std::string calculateHash(const std::string& input);
+std::string calculateHash(std::string_view input);
 
 /**
  * @brief Validates a Bitcoin wallet address
+ *
+ * Checks the address with parseBitcoinAddress(). Recent results are kept in
+ * a small per-thread cache, so a wallet that is paid repeatedly is only
+ * decoded once.
+ *
  * @param address The wallet address to validate
- * @return True if the address is valid
+ * @return True if the address is a valid mainnet address
  */
 bool validateBitcoinAddress(const std::string& address);
 
@@ -41,8 +91,24 @@ bool validateBitcoinAddress(const std::string& address);
  */
 std::unordered_map<std::string, std::string> parseCodeMetadata(const std::filesystem::path& filePath);
 
+/**
+ * @brief Extracts metadata from an already opened code file
+ *
+ * Metadata is written as "* @key: value" in comments within the first 20
+ * lines of the file.
+ *
+ * @param file The code file
+ * @return A map of metadata keys to values
+ */
+std::unordered_map<std::string, std::string> parseCodeMetadata(const SourceFile& file);
+
 /**
  * @brief Reads code from a file
+ *
+ * The file is mapped and indexed on every call; when several ranges of the
+ * same file are needed, open it once as a SourceFile and slice it with
+ * SourceFile::getLines() instead.
+ *
  * @param filePath Path to the code file
  * @param startLine Starting line (0-based)
  * @param endLine Ending line (0-based)
@@ -70,6 +136,13 @@ double normalizeValue(double value, double min, double max);
  */
 std::string formatBitcoinAmount(double amount);
 
+/**
+ * @brief Formats an exact Bitcoin amount with 8 decimals
+ * @param amount The amount
+ * @return A string containing the formatted amount
+ */
+std::string formatBitcoinAmount(Satoshis amount);
+
 /**
  * @brief Formats a timestamp as a human-readable string
  * @param timestamp The timestamp to format
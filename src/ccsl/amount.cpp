@@ -0,0 +1,64 @@
+/**
+ * @file amount.cpp
+ * @brief Implementation of satoshi amount conversion and formatting
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/amount.hpp>
+#include <cmath>
+#include <ostream>
+#include <stdexcept>
+
+namespace ccsl {
+
+Satoshis Satoshis::fromBitcoins(double bitcoins) {
+    const double satoshis = std::round(bitcoins * kSatoshisPerBitcoin);
+    // 2^63 is exactly representable; anything at or beyond it does not fit
+    if (!std::isfinite(satoshis) || std::fabs(satoshis) >= 9223372036854775808.0) {
+        throw std::invalid_argument("Bitcoin amount is out of range");
+    }
+    return Satoshis(static_cast<std::int64_t>(satoshis));
+}
+
+std::optional<Satoshis> Satoshis::tryFromBitcoins(double bitcoins) {
+    const double satoshis = std::round(bitcoins * kSatoshisPerBitcoin);
+    // Comparisons with NaN are false, so NaN fails the first test
+    if (!(satoshis >= 1.0) || satoshis >= 9223372036854775808.0) {
+        return std::nullopt;
+    }
+    return Satoshis(static_cast<std::int64_t>(satoshis));
+}
+
+std::size_t formatSatoshis(Satoshis amount, char* buffer) {
+    const std::int64_t value = amount.getSatoshis();
+    // Negate in unsigned arithmetic so the minimum value is handled too
+    std::uint64_t magnitude = value < 0 ? 0 - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+
+    // Digits are produced right to left: 8 decimals, the point, then the whole bitcoins
+    char digits[kMaxBitcoinAmountChars];
+    std::size_t count = 0;
+    for (int i = 0; i < 8; i++) {
+        digits[count++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    }
+    digits[count++] = '.';
+    do {
+        digits[count++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) {
+        digits[count++] = '-';
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+        buffer[i] = digits[count - 1 - i];
+    }
+    return count;
+}
+
+std::ostream& operator<<(std::ostream& out, Satoshis amount) {
+    char buffer[kMaxBitcoinAmountChars];
+    return out.write(buffer, static_cast<std::streamsize>(formatSatoshis(amount, buffer)));
+}
+
+} // namespace ccsl
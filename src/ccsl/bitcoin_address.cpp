@@ -0,0 +1,294 @@
+/**
+ * @file bitcoin_address.cpp
+ * @brief Implementation of Bitcoin address decoding
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/bitcoin_address.hpp>
+#include <cstddef>
+#include <cstring>
+
+namespace ccsl {
+
+namespace {
+
+constexpr std::uint32_t kSha256Constants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+std::uint32_t rotr(std::uint32_t x, int k) { return (x >> k) | (x << (32 - k)); }
+
+void sha256Block(std::uint32_t state[8], const std::uint8_t* block) {
+    std::uint32_t w[64];
+    for (int i = 0; i < 16; i++) {
+        w[i] = static_cast<std::uint32_t>(block[4 * i]) << 24 | static_cast<std::uint32_t>(block[4 * i + 1]) << 16 |
+               static_cast<std::uint32_t>(block[4 * i + 2]) << 8 | block[4 * i + 3];
+    }
+    for (int i = 16; i < 64; i++) {
+        std::uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        std::uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    std::uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    std::uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; i++) {
+        std::uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + kSha256Constants[i] + w[i];
+        std::uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+// Digit value of each Base58 character, or -1
+constexpr std::array<std::int8_t, 128> kBase58Digits = [] {
+    constexpr char alphabet[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+    std::array<std::int8_t, 128> digits{};
+    for (auto& digit : digits) {
+        digit = -1;
+    }
+    for (int i = 0; i < 58; i++) {
+        digits[static_cast<std::size_t>(alphabet[i])] = static_cast<std::int8_t>(i);
+    }
+    return digits;
+}();
+
+// Value of each Bech32 character in either case, or -1
+constexpr std::array<std::int8_t, 128> kBech32Digits = [] {
+    constexpr char charset[] = "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
+    std::array<std::int8_t, 128> digits{};
+    for (auto& digit : digits) {
+        digit = -1;
+    }
+    for (int i = 0; i < 32; i++) {
+        digits[static_cast<std::size_t>(charset[i])] = static_cast<std::int8_t>(i);
+        digits[static_cast<std::size_t>(charset[i] - ('a' <= charset[i] && charset[i] <= 'z' ? 32 : 0))] =
+            static_cast<std::int8_t>(i);
+    }
+    return digits;
+}();
+
+constexpr std::uint32_t kBech32Constant = 1;
+constexpr std::uint32_t kBech32mConstant = 0x2bc830a3;
+
+// XOR of the BCH generator terms selected by each value of the top 5 checksum bits
+constexpr std::array<std::uint32_t, 32> kBech32Generators = [] {
+    constexpr std::uint32_t generator[5] = {0x3b6a57b2, 0x26508e6d, 0x1ea119fa, 0x3d4233dd, 0x2a1462b3};
+    std::array<std::uint32_t, 32> terms{};
+    for (std::uint32_t top = 0; top < 32; top++) {
+        for (int i = 0; i < 5; i++) {
+            if ((top >> i) & 1) {
+                terms[top] ^= generator[i];
+            }
+        }
+    }
+    return terms;
+}();
+
+std::uint32_t bech32Step(std::uint32_t checksum, std::uint32_t value) {
+    return (((checksum & 0x1ffffff) << 5) ^ value) ^ kBech32Generators[checksum >> 25];
+}
+
+// Base58Check with a 1-byte version and a 20-byte hash
+std::optional<BitcoinAddressType> parseBase58Address(std::string_view address) {
+    constexpr std::size_t kDecodedSize = 25;
+    if (address.size() < 26 || address.size() > 35) {
+        return std::nullopt;
+    }
+
+    std::uint8_t decoded[kDecodedSize] = {};
+    for (char c : address) {
+        const int digit = static_cast<unsigned char>(c) < 128 ? kBase58Digits[static_cast<unsigned char>(c)] : -1;
+        if (digit < 0) {
+            return std::nullopt;
+        }
+        std::uint32_t carry = static_cast<std::uint32_t>(digit);
+        for (std::size_t i = kDecodedSize; i-- > 0;) {
+            carry += 58u * decoded[i];
+            decoded[i] = static_cast<std::uint8_t>(carry);
+            carry >>= 8;
+        }
+        if (carry != 0) {
+            return std::nullopt;
+        }
+    }
+
+    // Each leading '1' encodes exactly one leading zero byte
+    std::size_t ones = 0;
+    while (ones < address.size() && address[ones] == '1') {
+        ones++;
+    }
+    std::size_t zeros = 0;
+    while (zeros < kDecodedSize && decoded[zeros] == 0) {
+        zeros++;
+    }
+    if (ones != zeros) {
+        return std::nullopt;
+    }
+
+    const Sha256Digest first = sha256(std::string_view(reinterpret_cast<const char*>(decoded), 21));
+    const Sha256Digest second = sha256(std::string_view(reinterpret_cast<const char*>(first.data()), first.size()));
+    if (std::memcmp(second.data(), decoded + 21, 4) != 0) {
+        return std::nullopt;
+    }
+
+    switch (decoded[0]) {
+        case 0x00: return BitcoinAddressType::P2PKH;
+        case 0x05: return BitcoinAddressType::P2SH;
+        default: return std::nullopt;
+    }
+}
+
+// Segwit address with the "bc" prefix (BIP 173 and BIP 350)
+std::optional<BitcoinAddressType> parseSegwitAddress(std::string_view address) {
+    if (address.size() < 14 || address.size() > 90) {
+        return std::nullopt;
+    }
+
+    bool lower = false;
+    bool upper = false;
+    for (char c : address) {
+        lower |= 'a' <= c && c <= 'z';
+        upper |= 'A' <= c && c <= 'Z';
+    }
+    if (lower && upper) {
+        return std::nullopt;
+    }
+
+    // Checksum over the expanded prefix "bc", then the data part
+    std::uint32_t checksum = 1;
+    for (std::uint32_t c : {'b', 'c'}) {
+        checksum = bech32Step(checksum, c >> 5);
+    }
+    checksum = bech32Step(checksum, 0);
+    for (std::uint32_t c : {'b', 'c'}) {
+        checksum = bech32Step(checksum, c & 31);
+    }
+
+    const std::string_view data = address.substr(3);
+    std::uint8_t program[40];
+    std::size_t programSize = 0;
+    std::uint32_t accumulator = 0;
+    int bits = 0;
+    int witnessVersion = -1;
+
+    for (std::size_t i = 0; i < data.size(); i++) {
+        const unsigned char c = static_cast<unsigned char>(data[i]);
+        const int value = c < 128 ? kBech32Digits[c] : -1;
+        if (value < 0) {
+            return std::nullopt;
+        }
+        checksum = bech32Step(checksum, static_cast<std::uint32_t>(value));
+
+        // The last six values are the checksum itself
+        if (i >= data.size() - 6) {
+            continue;
+        }
+        if (i == 0) {
+            witnessVersion = value;
+            continue;
+        }
+        accumulator = (accumulator << 5) | static_cast<std::uint32_t>(value);
+        bits += 5;
+        if (bits >= 8) {
+            bits -= 8;
+            if (programSize == sizeof(program)) {
+                return std::nullopt;
+            }
+            program[programSize++] = static_cast<std::uint8_t>(accumulator >> bits);
+        }
+    }
+
+    // Leftover padding must be shorter than a byte and all zero
+    if (witnessVersion < 0 || witnessVersion > 16 || bits >= 5 || (accumulator & ((1u << bits) - 1)) != 0) {
+        return std::nullopt;
+    }
+    if (programSize < 2) {
+        return std::nullopt;
+    }
+
+    if (witnessVersion == 0) {
+        if (checksum != kBech32Constant) {
+            return std::nullopt;
+        }
+        if (programSize == 20) {
+            return BitcoinAddressType::P2WPKH;
+        }
+        if (programSize == 32) {
+            return BitcoinAddressType::P2WSH;
+        }
+        return std::nullopt;
+    }
+
+    if (checksum != kBech32mConstant) {
+        return std::nullopt;
+    }
+    return witnessVersion == 1 && programSize == 32 ? BitcoinAddressType::P2TR : BitcoinAddressType::WITNESS_UNKNOWN;
+}
+
+} // namespace
+
+Sha256Digest sha256(std::string_view data) {
+    std::uint32_t state[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(data.data());
+    std::size_t remaining = data.size();
+    while (remaining >= 64) {
+        sha256Block(state, bytes);
+        bytes += 64;
+        remaining -= 64;
+    }
+
+    // Final one or two blocks: the tail, a 1 bit, zeros and the bit length
+    std::uint8_t tail[128] = {};
+    if (remaining > 0) {
+        std::memcpy(tail, bytes, remaining);
+    }
+    tail[remaining] = 0x80;
+    const std::size_t tailSize = remaining < 56 ? 64 : 128;
+    const std::uint64_t bitLength = static_cast<std::uint64_t>(data.size()) * 8;
+    for (int i = 0; i < 8; i++) {
+        tail[tailSize - 1 - i] = static_cast<std::uint8_t>(bitLength >> (8 * i));
+    }
+    sha256Block(state, tail);
+    if (tailSize == 128) {
+        sha256Block(state, tail + 64);
+    }
+
+    Sha256Digest digest;
+    for (int i = 0; i < 8; i++) {
+        digest[4 * i] = static_cast<std::uint8_t>(state[i] >> 24);
+        digest[4 * i + 1] = static_cast<std::uint8_t>(state[i] >> 16);
+        digest[4 * i + 2] = static_cast<std::uint8_t>(state[i] >> 8);
+        digest[4 * i + 3] = static_cast<std::uint8_t>(state[i]);
+    }
+    return digest;
+}
+
+std::optional<BitcoinAddressType> parseBitcoinAddress(std::string_view address) {
+    if (address.size() >= 3 && (address[0] == 'b' || address[0] == 'B') &&
+        (address[1] == 'c' || address[1] == 'C') && address[2] == '1') {
+        return parseSegwitAddress(address);
+    }
+    return parseBase58Address(address);
+}
+
+} // namespace ccsl
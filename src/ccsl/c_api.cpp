@@ -0,0 +1,187 @@
+/**
+ * @file c_api.cpp
+ * @brief Implementation of the C interface to the CCSL metric evaluators
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/c_api.h>
+#include <ccsl/metrics.hpp>
+#include <ccsl/source_classifier.hpp>
+#include <ccsl/source_file.hpp>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+struct ccsl_evaluator {
+    ccsl::MetricsEvaluator evaluator;
+};
+
+static_assert(CCSL_METRIC_COUNT == ccsl::kMetricTypeCount, "C metric count out of date");
+static_assert(CCSL_METRIC_COUNTS == std::tuple_size<ccsl::MetricCounts>::value, "C count slots out of date");
+static_assert(CCSL_SOURCE_EVALUATE == static_cast<int>(ccsl::SourceVerdict::EVALUATE) &&
+              CCSL_SOURCE_NOT_C_FAMILY == static_cast<int>(ccsl::SourceVerdict::NOT_C_FAMILY) &&
+              CCSL_SOURCE_BINARY == static_cast<int>(ccsl::SourceVerdict::BINARY) &&
+              CCSL_SOURCE_MINIFIED == static_cast<int>(ccsl::SourceVerdict::MINIFIED),
+              "C source verdicts out of date");
+
+namespace {
+
+void toC(const ccsl::MetricScores& from, ccsl_scores_t* to) {
+    for (std::size_t i = 0; i < ccsl::kMetricTypeCount; i++) {
+        to->values[i] = from.values[i];
+        for (std::size_t k = 0; k < CCSL_METRIC_COUNTS; k++) {
+            to->counts[i][k] = from.counts[i][k];
+        }
+    }
+    to->present = from.present;
+}
+
+ccsl::MetricScores fromC(const ccsl_scores_t* from) {
+    ccsl::MetricScores to;
+    for (std::size_t i = 0; i < ccsl::kMetricTypeCount; i++) {
+        to.values[i] = from->values[i];
+        for (std::size_t k = 0; k < CCSL_METRIC_COUNTS; k++) {
+            to.counts[i][k] = from->counts[i][k];
+        }
+    }
+    to.present = static_cast<std::uint8_t>(from->present);
+    return to;
+}
+
+bool validMetric(int metric) {
+    return metric >= 0 && static_cast<std::size_t>(metric) < ccsl::kMetricTypeCount;
+}
+
+const ccsl::SourceClassifier& defaultClassifier() {
+    static const ccsl::SourceClassifier classifier;
+    return classifier;
+}
+
+} // namespace
+
+// Exceptions must not cross into C, so every entry point catches them
+extern "C" {
+
+ccsl_evaluator_t* ccsl_evaluator_create(void) {
+    try {
+        return new ccsl_evaluator();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void ccsl_evaluator_destroy(ccsl_evaluator_t* evaluator) {
+    delete evaluator;
+}
+
+unsigned ccsl_evaluator_version(void) {
+    return ccsl::MetricsEvaluator::kVersion;
+}
+
+int ccsl_evaluate(const ccsl_evaluator_t* evaluator, const char* code, std::size_t length, ccsl_scores_t* scores) {
+    if (!evaluator || (!code && length > 0) || !scores) {
+        return -1;
+    }
+
+    try {
+        toC(evaluator->evaluator.evaluateScores(std::string_view(code, length)), scores);
+        return 0;
+    } catch (...) {
+        return -1;
+    }
+}
+
+int ccsl_evaluate_file(const ccsl_evaluator_t* evaluator, const char* path, ccsl_scores_t* scores) {
+    if (!evaluator || !path || !scores) {
+        return -1;
+    }
+
+    try {
+        std::optional<ccsl::SourceFile> file = ccsl::SourceFile::open(path);
+        if (!file) {
+            return -1;
+        }
+        toC(evaluator->evaluator.evaluateScores(file->getContents()), scores);
+        return 0;
+    } catch (...) {
+        return -1;
+    }
+}
+
+int ccsl_classify(const char* path, const char* code, std::size_t length) {
+    if (!code && length > 0) {
+        return -1;
+    }
+    const std::string_view name = path ? std::string_view(path) : std::string_view();
+    return static_cast<int>(defaultClassifier().classify(name, std::string_view(code, length)).verdict);
+}
+
+int ccsl_evaluate_source_file(const ccsl_evaluator_t* evaluator, const char* path, ccsl_scores_t* scores,
+                              int* verdict) {
+    if (!evaluator || !path || !scores) {
+        return -1;
+    }
+
+    try {
+        std::optional<ccsl::SourceFile> file = ccsl::SourceFile::open(path);
+        if (!file) {
+            return -1;
+        }
+        const ccsl::SourceVerdict result = defaultClassifier().classify(path, file->getContents()).verdict;
+        if (verdict) {
+            *verdict = static_cast<int>(result);
+        }
+        if (result != ccsl::SourceVerdict::EVALUATE) {
+            return 1;
+        }
+        toC(evaluator->evaluator.evaluateScores(file->getContents()), scores);
+        return 0;
+    } catch (...) {
+        return -1;
+    }
+}
+
+const char* ccsl_verdict_name(int verdict) {
+    if (verdict < CCSL_SOURCE_EVALUATE || verdict > CCSL_SOURCE_MINIFIED) {
+        return nullptr;
+    }
+    return ccsl::verdictName(static_cast<ccsl::SourceVerdict>(verdict));
+}
+
+std::size_t ccsl_format_rationale(const ccsl_evaluator_t* evaluator, const ccsl_scores_t* scores,
+                                  int metric, char* buffer, std::size_t size) {
+    if (size > 0) {
+        buffer[0] = '\0';
+    }
+    if (!evaluator || !scores || !validMetric(metric)) {
+        return 0;
+    }
+
+    try {
+        std::string rationale = evaluator->evaluator.formatRationale(
+            fromC(scores), static_cast<ccsl::MetricType>(metric));
+        if (size > 0) {
+            std::size_t copied = rationale.size() < size - 1 ? rationale.size() : size - 1;
+            std::memcpy(buffer, rationale.data(), copied);
+            buffer[copied] = '\0';
+        }
+        return rationale.size();
+    } catch (...) {
+        return 0;
+    }
+}
+
+double ccsl_scores_mean(const ccsl_scores_t* scores) {
+    return scores ? fromC(scores).mean() : 0.0;
+}
+
+const char* ccsl_metric_name(int metric) {
+    static const char* const names[] = {
+        "Impact", "Simplicity", "Cleanness", "Comment", "Creditability", "Novelty"
+    };
+    return validMetric(metric) ? names[metric] : nullptr;
+}
+
+} // extern "C"
@@ -0,0 +1,194 @@
+/**
+ * @file diff.cpp
+ * @brief Implementation of the unified diff parser
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/diff.hpp>
+#include <charconv>
+#include <stdexcept>
+
+namespace ccsl {
+
+namespace {
+
+bool startsWith(std::string_view text, std::string_view prefix) {
+    return text.substr(0, prefix.size()) == prefix;
+}
+
+/**
+ * @brief Take the next line off the front of the text, without its line ending
+ */
+std::string_view nextLine(std::string_view& text) {
+    const std::size_t newline = text.find('\n');
+    std::string_view line = text.substr(0, newline);
+    text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    return line;
+}
+
+/**
+ * @brief Turn a header path into a file path
+ * @param path Path from a "---", "+++" or "diff --git" line
+ * @param prefix The prefix git adds on this side, "a/" or "b/"
+ * @return The path, or empty for /dev/null
+ */
+std::string parsePath(std::string_view path, std::string_view prefix) {
+    // diff -u appends a tab and a timestamp
+    path = path.substr(0, path.find('\t'));
+    if (path == "/dev/null") {
+        return {};
+    }
+    if (startsWith(path, prefix)) {
+        path.remove_prefix(prefix.size());
+    }
+    return std::string(path);
+}
+
+/**
+ * @brief Parse "start[,count]" from the front of the text
+ */
+bool parseRange(std::string_view& text, int& start, int& count) {
+    const char* end = text.data() + text.size();
+    auto [next, error] = std::from_chars(text.data(), end, start);
+    if (error != std::errc() || start < 0) {
+        return false;
+    }
+    count = 1;
+    if (next != end && *next == ',') {
+        auto [afterCount, countError] = std::from_chars(next + 1, end, count);
+        if (countError != std::errc() || count < 0) {
+            return false;
+        }
+        next = afterCount;
+    }
+    text.remove_prefix(static_cast<std::size_t>(next - text.data()));
+    return true;
+}
+
+/**
+ * @brief Parse a hunk header and its body, appending one DiffHunk per changed block
+ * @param header The "@@ -a,b +c,d @@" line
+ * @param text The rest of the diff; the body is consumed from it
+ * @param hunks Receives the changed blocks
+ */
+void parseHunk(std::string_view header, std::string_view& text, std::vector<DiffHunk>& hunks) {
+    int oldStart = 0;
+    int oldCount = 0;
+    int newStart = 0;
+    int newCount = 0;
+    std::string_view rest = header.substr(4);
+    bool valid = startsWith(header, "@@ -") && parseRange(rest, oldStart, oldCount) && startsWith(rest, " +");
+    if (valid) {
+        rest.remove_prefix(2);
+        valid = parseRange(rest, newStart, newCount) && startsWith(rest, " @@");
+    }
+    if (!valid) {
+        throw std::invalid_argument("Malformed hunk header: " + std::string(header));
+    }
+
+    // Ranges are 1-based, except that an empty range names the line before it
+    int oldLine = oldCount == 0 ? oldStart : oldStart - 1;
+    int newLine = newCount == 0 ? newStart : newStart - 1;
+    if (oldLine < 0 || newLine < 0) {
+        throw std::invalid_argument("Malformed hunk header: " + std::string(header));
+    }
+
+    DiffHunk block;
+    bool inBlock = false;
+    auto startBlock = [&] {
+        if (!inBlock) {
+            block = DiffHunk{oldLine, 0, newLine, 0};
+            inBlock = true;
+        }
+    };
+    auto endBlock = [&] {
+        if (inBlock) {
+            hunks.push_back(block);
+            inBlock = false;
+        }
+    };
+
+    while (oldCount > 0 || newCount > 0) {
+        if (text.empty()) {
+            throw std::invalid_argument("Truncated hunk: " + std::string(header));
+        }
+        std::string_view line = nextLine(text);
+        // Some tools strip the space from empty context lines
+        const char kind = line.empty() ? ' ' : line[0];
+        if (kind == ' ' && oldCount > 0 && newCount > 0) {
+            endBlock();
+            oldCount--;
+            newCount--;
+            oldLine++;
+            newLine++;
+        } else if (kind == '-' && oldCount > 0) {
+            startBlock();
+            block.oldCount++;
+            oldCount--;
+            oldLine++;
+        } else if (kind == '+' && newCount > 0) {
+            startBlock();
+            block.newCount++;
+            newCount--;
+            newLine++;
+        } else if (kind != '\\') {
+            throw std::invalid_argument("Hunk does not match its header: " + std::string(header));
+        }
+    }
+    endBlock();
+}
+
+} // namespace
+
+std::vector<FileDiff> parseUnifiedDiff(std::string_view text) {
+    std::vector<FileDiff> files;
+    // Set once a file's "+++" line or first hunk is seen; a later "---" starts the next file
+    bool inBody = false;
+
+    while (!text.empty()) {
+        std::string_view line = nextLine(text);
+
+        if (startsWith(line, "diff --git ")) {
+            std::string_view paths = line.substr(11);
+            const std::size_t split = paths.rfind(" b/");
+            files.emplace_back();
+            if (split != std::string_view::npos) {
+                files.back().oldPath = parsePath(paths.substr(0, split), "a/");
+                files.back().newPath = parsePath(paths.substr(split + 1), "b/");
+            }
+            inBody = false;
+        } else if (startsWith(line, "--- ")) {
+            if (files.empty() || inBody) {
+                files.emplace_back();
+                inBody = false;
+            }
+            files.back().oldPath = parsePath(line.substr(4), "a/");
+        } else if (files.empty()) {
+            // Anything before the first file header, e.g. a commit message
+            continue;
+        } else if (startsWith(line, "+++ ")) {
+            files.back().newPath = parsePath(line.substr(4), "b/");
+            inBody = true;
+        } else if (startsWith(line, "@@ ")) {
+            parseHunk(line, text, files.back().hunks);
+            inBody = true;
+        } else if (inBody) {
+            continue;
+        } else if (startsWith(line, "rename from ")) {
+            files.back().oldPath = std::string(line.substr(12));
+        } else if (startsWith(line, "rename to ")) {
+            files.back().newPath = std::string(line.substr(10));
+        } else if (startsWith(line, "new file mode")) {
+            files.back().oldPath.clear();
+        } else if (startsWith(line, "deleted file mode")) {
+            files.back().newPath.clear();
+        }
+    }
+
+    return files;
+}
+
+} // namespace ccsl
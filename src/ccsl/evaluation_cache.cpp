@@ -0,0 +1,216 @@
+/**
+ * @file evaluation_cache.cpp
+ * @brief Implementation of the content-addressed evaluation cache
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/evaluation_cache.hpp>
+#include <ccsl/utility.hpp>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <system_error>
+#include <tuple>
+
+namespace ccsl {
+
+namespace {
+
+// File layout: header, then one fixed-size record per entry. Values are
+// stored in host byte order; the magic doubles as an endianness check.
+constexpr char kMagic[8] = {'C', 'C', 'S', 'L', 'E', 'V', 'C', '1'};
+constexpr std::uint32_t kByteOrderMark = 0x01020304;
+
+constexpr std::size_t kRecordSize =
+    sizeof(std::uint64_t) * 2 + sizeof(std::uint8_t) +
+    sizeof(double) * kMetricTypeCount * (1 + std::tuple_size<MetricCounts>::value);
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t byteOrder;
+    std::uint32_t evaluatorVersion;
+    std::uint32_t recordSize;
+    std::uint32_t reserved;
+    std::uint64_t entryCount;
+};
+
+template<typename T>
+char* put(char* out, const T& value) {
+    std::memcpy(out, &value, sizeof(T));
+    return out + sizeof(T);
+}
+
+template<typename T>
+const char* get(const char* in, T& value) {
+    std::memcpy(&value, in, sizeof(T));
+    return in + sizeof(T);
+}
+
+} // namespace
+
+EvaluationCache::EvaluationCache(std::uint32_t evaluatorVersion)
+    : m_evaluatorVersion(evaluatorVersion) {
+}
+
+std::uint64_t EvaluationCache::keyOf(std::string_view code) const {
+    return hashBytes(code, m_evaluatorVersion);
+}
+
+MetricScores EvaluationCache::evaluateScores(const MetricsEvaluator& evaluator, std::string_view code) {
+    if (std::optional<MetricScores> cached = find(code)) {
+        return *cached;
+    }
+
+    MetricScores scores = evaluator.evaluateScores(code);
+    insert(code, scores);
+    return scores;
+}
+
+std::vector<MetricEvaluation> EvaluationCache::evaluateAll(const MetricsEvaluator& evaluator, std::string_view code) {
+    return evaluator.toEvaluations(evaluateScores(evaluator, code));
+}
+
+std::optional<MetricScores> EvaluationCache::find(std::string_view code) const {
+    const std::uint64_t key = keyOf(code);
+
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end() && it->second.length == code.size()) {
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return it->second.scores;
+        }
+    }
+
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return std::nullopt;
+}
+
+void EvaluationCache::insert(std::string_view code, const MetricScores& scores) {
+    const std::uint64_t key = keyOf(code);
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_entries[key] = Entry{code.size(), scores};
+}
+
+bool EvaluationCache::load(const std::filesystem::path& filePath) {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    FileHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.byteOrder != kByteOrderMark ||
+        header.evaluatorVersion != m_evaluatorVersion ||
+        header.recordSize != kRecordSize) {
+        return false;
+    }
+
+    // Read everything before touching the entries so a truncated file is ignored
+    std::vector<char> records;
+    if (header.entryCount > 0) {
+        std::error_code error;
+        const std::uintmax_t fileSize = std::filesystem::file_size(filePath, error);
+        if (error || header.entryCount > (fileSize - sizeof(header)) / kRecordSize) {
+            return false;
+        }
+        records.resize(static_cast<std::size_t>(header.entryCount) * kRecordSize);
+        if (!file.read(records.data(), static_cast<std::streamsize>(records.size()))) {
+            return false;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_entries.reserve(m_entries.size() + static_cast<std::size_t>(header.entryCount));
+
+    const char* in = records.data();
+    for (std::uint64_t i = 0; i < header.entryCount; i++) {
+        std::uint64_t key;
+        Entry entry;
+        in = get(in, key);
+        in = get(in, entry.length);
+        in = get(in, entry.scores.present);
+        for (double& value : entry.scores.values) {
+            in = get(in, value);
+        }
+        for (MetricCounts& counts : entry.scores.counts) {
+            for (double& count : counts) {
+                in = get(in, count);
+            }
+        }
+        m_entries.emplace(key, entry);
+    }
+
+    return true;
+}
+
+bool EvaluationCache::save(const std::filesystem::path& filePath) const {
+    std::vector<char> buffer;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+        FileHeader header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.byteOrder = kByteOrderMark;
+        header.evaluatorVersion = m_evaluatorVersion;
+        header.recordSize = static_cast<std::uint32_t>(kRecordSize);
+        header.entryCount = m_entries.size();
+
+        buffer.resize(sizeof(header) + m_entries.size() * kRecordSize);
+        char* out = put(buffer.data(), header);
+        for (const auto& [key, entry] : m_entries) {
+            out = put(out, key);
+            out = put(out, entry.length);
+            out = put(out, entry.scores.present);
+            for (double value : entry.scores.values) {
+                out = put(out, value);
+            }
+            for (const MetricCounts& counts : entry.scores.counts) {
+                for (double count : counts) {
+                    out = put(out, count);
+                }
+            }
+        }
+    }
+
+    std::filesystem::path tempPath = filePath;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open() ||
+            !file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+            return false;
+        }
+        file.close();
+        if (!file) {
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, filePath, error);
+    if (error) {
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    return true;
+}
+
+void EvaluationCache::clear() {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_entries.clear();
+    m_hits.store(0, std::memory_order_relaxed);
+    m_misses.store(0, std::memory_order_relaxed);
+}
+
+std::size_t EvaluationCache::size() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+} // namespace ccsl
@@ -0,0 +1,77 @@
+/**
+ * @file incremental_scorer.cpp
+ * @brief Implementation of diff-driven incremental scoring
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/incremental_scorer.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace ccsl {
+
+IncrementalScorer::IncrementalScorer(OverlapPolicy policy, EvaluationCache* cache)
+    : m_policy(policy),
+      m_cache(cache)
+{
+}
+
+IncrementalResult IncrementalScorer::apply(
+    License& license,
+    const std::vector<FileDiff>& diffs,
+    const std::string& contributor,
+    const SourceProvider& sources
+) const {
+    if (contributor.empty()) {
+        throw std::invalid_argument("Contributor name cannot be empty");
+    }
+
+    IncrementalResult result;
+    for (const FileDiff& diff : diffs) {
+        const DiffEffect effect = license.applyDiff(diff, m_policy);
+        result.files++;
+        result.shifted += effect.shifted;
+        result.removed += effect.removed;
+        if (effect.dirtyRanges.empty()) {
+            continue;
+        }
+
+        std::optional<SourceFile> source = sources(diff.newPath);
+        if (!source) {
+            result.missingFiles.push_back(diff.newPath);
+            continue;
+        }
+
+        const int lineCount = static_cast<int>(source->getLineCount());
+        for (auto [start, end] : effect.dirtyRanges) {
+            // The checkout may not match the diff exactly; score what is there
+            if (start >= lineCount) {
+                break;
+            }
+            end = std::min(end, lineCount - 1);
+
+            std::string_view code = source->getLines(static_cast<std::size_t>(start), static_cast<std::size_t>(end));
+            CodeContribution contribution(contributor, diff.newPath, start, end);
+            contribution.setMetricScores(m_cache ? m_cache->evaluateScores(m_evaluator, code)
+                                                 : m_evaluator.evaluateScores(code));
+            result.scoredLines += static_cast<std::size_t>(end - start + 1);
+            if (license.registerContribution(contribution)) {
+                result.added++;
+            }
+        }
+    }
+
+    return result;
+}
+
+IncrementalResult IncrementalScorer::apply(
+    License& license,
+    std::string_view diffText,
+    const std::string& contributor,
+    const std::filesystem::path& root
+) const {
+    return apply(license, parseUnifiedDiff(diffText), contributor,
+                 [&root](const std::string& path) { return SourceFile::open(root / path); });
+}
+
+} // namespace ccsl
@@ -0,0 +1,262 @@
+/**
+ * @file instrumentation.cpp
+ * @brief Implementation of the instrumentation registry and exporters
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/instrumentation.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
+
+#if CCSL_INSTRUMENTATION
+namespace {
+
+// Plain per-thread counter; read only by the thread that owns it
+thread_local std::uint64_t t_allocations = 0;
+
+void* countedAllocate(std::size_t size) noexcept {
+    t_allocations++;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+} // namespace
+
+// Counting replacements for the global allocation functions. Every
+// unaligned form is replaced so allocations and deallocations always pair up.
+void* operator new(std::size_t size) {
+    for (;;) {
+        if (void* p = countedAllocate(size)) {
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return ::operator new(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return ::operator new(size, std::nothrow);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+#endif
+
+namespace ccsl {
+
+namespace {
+
+constexpr const char* kProbeNames[kProbeCount] = {
+    "scan_source",
+    "evaluate_impact",
+    "evaluate_simplicity",
+    "evaluate_cleanness",
+    "evaluate_comment",
+    "evaluate_creditability",
+    "evaluate_novelty",
+    "read_code_from_file",
+    "register_contribution",
+    "send_payment"
+};
+
+std::size_t latencyBucket(std::uint64_t nanoseconds) {
+    std::size_t bucket = 0;
+    while (bucket < kLatencyBounds.size() && nanoseconds > kLatencyBounds[bucket]) {
+        bucket++;
+    }
+    return bucket;
+}
+
+std::uint64_t threadNumber() {
+    static std::atomic<std::uint64_t> next{1};
+    thread_local const std::uint64_t number = next.fetch_add(1, std::memory_order_relaxed);
+    return number;
+}
+
+// Nanoseconds as seconds without trailing zeros, e.g. 2500 -> 2.5e-06
+std::string seconds(std::uint64_t nanoseconds) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.9g", static_cast<double>(nanoseconds) / 1e9);
+    return buffer;
+}
+
+// Nanoseconds as the microseconds Chrome traces use
+std::string microseconds(std::uint64_t nanoseconds) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%llu.%03llu",
+                  static_cast<unsigned long long>(nanoseconds / 1000),
+                  static_cast<unsigned long long>(nanoseconds % 1000));
+    return buffer;
+}
+
+} // namespace
+
+const char* probeName(Probe probe) {
+    std::size_t index = static_cast<std::size_t>(probe);
+    return index < kProbeCount ? kProbeNames[index] : "unknown";
+}
+
+Instrumentation::Instrumentation() : m_epoch(std::chrono::steady_clock::now()) {}
+
+Instrumentation& Instrumentation::get() {
+    static Instrumentation instance;
+    return instance;
+}
+
+void Instrumentation::record(Probe probe, std::chrono::steady_clock::time_point start,
+                             std::uint64_t nanoseconds, std::uint64_t bytes, std::uint64_t allocations) {
+    Counters& counters = m_counters[static_cast<std::size_t>(probe)];
+    counters.calls.fetch_add(1, std::memory_order_relaxed);
+    counters.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    counters.allocations.fetch_add(allocations, std::memory_order_relaxed);
+    counters.latency[latencyBucket(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+
+    if (!m_tracing.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    std::chrono::nanoseconds offset = start > m_epoch ? start - m_epoch : std::chrono::nanoseconds(0);
+    std::lock_guard<std::mutex> lock(m_traceMutex);
+    if (m_events.size() < m_maxEvents) {
+        m_events.push_back({probe, static_cast<std::uint64_t>(offset.count()), nanoseconds,
+                            bytes, allocations, threadNumber()});
+    }
+}
+
+ProbeStats Instrumentation::getStats(Probe probe) const {
+    const Counters& counters = m_counters[static_cast<std::size_t>(probe)];
+    ProbeStats stats;
+    stats.calls = counters.calls.load(std::memory_order_relaxed);
+    stats.nanoseconds = counters.nanoseconds.load(std::memory_order_relaxed);
+    stats.bytes = counters.bytes.load(std::memory_order_relaxed);
+    stats.allocations = counters.allocations.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < stats.latency.size(); i++) {
+        stats.latency[i] = counters.latency[i].load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+void Instrumentation::reset() {
+    for (Counters& counters : m_counters) {
+        counters.calls.store(0, std::memory_order_relaxed);
+        counters.nanoseconds.store(0, std::memory_order_relaxed);
+        counters.bytes.store(0, std::memory_order_relaxed);
+        counters.allocations.store(0, std::memory_order_relaxed);
+        for (auto& bucket : counters.latency) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_traceMutex);
+    m_events.clear();
+}
+
+void Instrumentation::setTracing(bool enabled, std::size_t maxEvents) {
+    std::lock_guard<std::mutex> lock(m_traceMutex);
+    m_maxEvents = maxEvents;
+    m_tracing.store(enabled, std::memory_order_relaxed);
+}
+
+std::size_t Instrumentation::getTraceEventCount() const {
+    std::lock_guard<std::mutex> lock(m_traceMutex);
+    return m_events.size();
+}
+
+std::string Instrumentation::toPrometheus() const {
+    std::ostringstream out;
+
+    out << "# HELP ccsl_call_duration_seconds Latency of instrumented calls.\n"
+        << "# TYPE ccsl_call_duration_seconds histogram\n";
+    for (std::size_t i = 0; i < kProbeCount; i++) {
+        const ProbeStats stats = getStats(static_cast<Probe>(i));
+        const std::string label = std::string("probe=\"") + kProbeNames[i] + "\"";
+
+        // Prometheus buckets are cumulative
+        std::uint64_t cumulative = 0;
+        for (std::size_t bucket = 0; bucket < kLatencyBounds.size(); bucket++) {
+            cumulative += stats.latency[bucket];
+            out << "ccsl_call_duration_seconds_bucket{" << label << ",le=\""
+                << seconds(kLatencyBounds[bucket]) << "\"} " << cumulative << "\n";
+        }
+        cumulative += stats.latency.back();
+        out << "ccsl_call_duration_seconds_bucket{" << label << ",le=\"+Inf\"} " << cumulative << "\n"
+            << "ccsl_call_duration_seconds_sum{" << label << "} " << seconds(stats.nanoseconds) << "\n"
+            << "ccsl_call_duration_seconds_count{" << label << "} " << cumulative << "\n";
+    }
+
+    out << "# HELP ccsl_processed_bytes_total Bytes processed by instrumented calls.\n"
+        << "# TYPE ccsl_processed_bytes_total counter\n";
+    for (std::size_t i = 0; i < kProbeCount; i++) {
+        out << "ccsl_processed_bytes_total{probe=\"" << kProbeNames[i] << "\"} "
+            << getStats(static_cast<Probe>(i)).bytes << "\n";
+    }
+
+    out << "# HELP ccsl_allocations_total Heap allocations made during instrumented calls.\n"
+        << "# TYPE ccsl_allocations_total counter\n";
+    for (std::size_t i = 0; i < kProbeCount; i++) {
+        out << "ccsl_allocations_total{probe=\"" << kProbeNames[i] << "\"} "
+            << getStats(static_cast<Probe>(i)).allocations << "\n";
+    }
+
+    return out.str();
+}
+
+std::string Instrumentation::toChromeTrace() const {
+    std::ostringstream out;
+    out << "{\"traceEvents\":[";
+
+    std::lock_guard<std::mutex> lock(m_traceMutex);
+    for (std::size_t i = 0; i < m_events.size(); i++) {
+        const TraceEvent& event = m_events[i];
+        out << (i == 0 ? "\n" : ",\n")
+            << "{\"name\":\"" << probeName(event.probe) << "\",\"cat\":\"ccsl\",\"ph\":\"X\""
+            << ",\"ts\":" << microseconds(event.startNanoseconds)
+            << ",\"dur\":" << microseconds(event.nanoseconds)
+            << ",\"pid\":1,\"tid\":" << event.thread
+            << ",\"args\":{\"bytes\":" << event.bytes << ",\"allocations\":" << event.allocations << "}}";
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    return out.str();
+}
+
+bool Instrumentation::writeChromeTrace(const std::filesystem::path& filePath) const {
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file << toChromeTrace();
+    return static_cast<bool>(file);
+}
+
+std::uint64_t Instrumentation::getThreadAllocations() {
+#if CCSL_INSTRUMENTATION
+    return t_allocations;
+#else
+    return 0;
+#endif
+}
+
+} // namespace ccsl
@@ -0,0 +1,530 @@
+/**
+ * @file lexer.cpp
+ * @brief Implementation of the single-pass source lexer
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/lexer.hpp>
+#include <ccsl/keyword_matcher.hpp>
+#include <ccsl/instrumentation.hpp>
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CCSL_LEXER_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define CCSL_LEXER_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace ccsl {
+
+namespace {
+
+/**
+ * @brief Keyword classes recognized on word tokens
+ */
+enum class WordClass {
+    NONE,
+    CONTROL,        ///< if, for, while, switch
+    TEST,           ///< Testing indicators
+    ADVANCED,       ///< Advanced language features
+    STRUCTURED,     ///< First half of "structured binding"
+    BINDING,        ///< Second half of "structured binding"
+    DESIGN_PATTERN  ///< Design pattern names
+};
+
+bool isWordChar(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           (c >= '0' && c <= '9') || c == '_';
+}
+
+bool isSpace(unsigned char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+bool isDigit(unsigned char c) {
+    return c >= '0' && c <= '9';
+}
+
+bool isSymbol(unsigned char c) {
+    static const std::string_view symbols = "+-*/=<>!&|^~%?:;[](){}";
+    return c != '\0' && symbols.find(static_cast<char>(c)) != std::string_view::npos;
+}
+
+bool isReferenceTerminator(unsigned char c) {
+    return isSpace(c) || c == '"' || c == '\'' || c == '<' || c == '>';
+}
+
+bool startsWith(std::string_view code, std::size_t pos, std::string_view prefix) {
+    return code.substr(pos, prefix.size()) == prefix;
+}
+
+constexpr KeywordEntry<WordClass> kKeywords[] = {
+    {"if", WordClass::CONTROL}, {"for", WordClass::CONTROL},
+    {"while", WordClass::CONTROL}, {"switch", WordClass::CONTROL},
+
+    {"test", WordClass::TEST}, {"assert", WordClass::TEST},
+    {"expect", WordClass::TEST}, {"should", WordClass::TEST},
+    {"mock", WordClass::TEST}, {"stub", WordClass::TEST},
+    {"spy", WordClass::TEST},
+
+    {"template", WordClass::ADVANCED}, {"constexpr", WordClass::ADVANCED},
+    {"decltype", WordClass::ADVANCED}, {"concept", WordClass::ADVANCED},
+    {"requires", WordClass::ADVANCED}, {"noexcept", WordClass::ADVANCED},
+    {"auto", WordClass::ADVANCED}, {"lambda", WordClass::ADVANCED},
+    {"fold", WordClass::ADVANCED}, {"structured", WordClass::STRUCTURED},
+    {"binding", WordClass::BINDING},
+
+    {"Factory", WordClass::DESIGN_PATTERN}, {"Builder", WordClass::DESIGN_PATTERN},
+    {"Singleton", WordClass::DESIGN_PATTERN}, {"Adapter", WordClass::DESIGN_PATTERN},
+    {"Bridge", WordClass::DESIGN_PATTERN}, {"Composite", WordClass::DESIGN_PATTERN},
+    {"Decorator", WordClass::DESIGN_PATTERN}, {"Facade", WordClass::DESIGN_PATTERN},
+    {"Proxy", WordClass::DESIGN_PATTERN}, {"Observer", WordClass::DESIGN_PATTERN},
+    {"Strategy", WordClass::DESIGN_PATTERN}, {"Command", WordClass::DESIGN_PATTERN},
+    {"State", WordClass::DESIGN_PATTERN}, {"Visitor", WordClass::DESIGN_PATTERN},
+    {"Interpreter", WordClass::DESIGN_PATTERN}, {"Iterator", WordClass::DESIGN_PATTERN},
+    {"Mediator", WordClass::DESIGN_PATTERN}, {"Memento", WordClass::DESIGN_PATTERN},
+    {"Prototype", WordClass::DESIGN_PATTERN}
+};
+
+// Built during compilation; lookups never allocate or backtrack
+constexpr auto kKeywordMatcher = makeKeywordMatcher(kKeywords);
+
+static_assert(kKeywordMatcher.find("while") == WordClass::CONTROL, "keyword table is broken");
+static_assert(kKeywordMatcher.find("Prototype") == WordClass::DESIGN_PATTERN, "keyword table is broken");
+static_assert(kKeywordMatcher.find("whilst") == WordClass::NONE, "keyword table is broken");
+
+/**
+ * @brief Check for a documentation tag following an '@' at position pos
+ */
+bool isDocTag(std::string_view code, std::size_t pos) {
+    static const std::string_view tags[] = {
+        "param", "return", "throw", "see", "link", "since", "version", "author", "deprecated"
+    };
+
+    for (const auto& tag : tags) {
+        if (startsWith(code, pos + 1, tag)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Match a URL or standard reference starting at position pos
+ * @return One past the end of the match, or npos if there is none
+ */
+std::size_t matchReference(std::string_view code, std::size_t pos) {
+    const std::size_t n = code.size();
+
+    // (http|https)://[^\s"'<>]+
+    std::size_t p = std::string_view::npos;
+    if (startsWith(code, pos, "http://")) {
+        p = pos + 7;
+    } else if (startsWith(code, pos, "https://")) {
+        p = pos + 8;
+    }
+    if (p != std::string_view::npos) {
+        if (p >= n || isReferenceTerminator(code[p])) {
+            return std::string_view::npos;
+        }
+        while (p < n && !isReferenceTerminator(code[p])) {
+            p++;
+        }
+        return p;
+    }
+
+    // (RFC|IEEE|ISO)[- ][0-9]+
+    for (std::string_view standard : {"RFC", "IEEE", "ISO"}) {
+        if (!startsWith(code, pos, standard)) {
+            continue;
+        }
+        p = pos + standard.size();
+        if (p + 1 < n && (code[p] == '-' || code[p] == ' ') && isDigit(code[p + 1])) {
+            p += 2;
+            while (p < n && isDigit(code[p])) {
+                p++;
+            }
+            return p;
+        }
+    }
+
+    return std::string_view::npos;
+}
+
+/**
+ * @brief Nibble tables of the bytes the scan may skip in bulk
+ *
+ * Inside a word, a word character only matters if it can start a
+ * reference ('h', 'R', 'I') or a complexity annotation ('O'). Past the
+ * indentation, a space, tab or '\r' after another one changes nothing.
+ * Every other byte is one the scan loop has to see.
+ *
+ * A byte c is quiet for a run class if (lo[c & 15] & hi[c >> 4] & class)
+ * is non-zero, which takes two byte shuffles per vector. Each high nibble
+ * of a quiet byte has a bit of its own, so the tables are exact.
+ */
+struct RunTables {
+    std::uint8_t lo[16] = {};
+    std::uint8_t hi[16] = {};
+    std::uint8_t byte[256] = {};
+};
+
+constexpr std::uint8_t kWordRun = 0x1f;  ///< High nibbles 3 to 7
+constexpr std::uint8_t kSpaceRun = 0x60; ///< High nibbles 0 and 2
+
+constexpr bool isQuietWordChar(unsigned c) {
+    const bool word = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    return word && c != 'h' && c != 'R' && c != 'I' && c != 'O';
+}
+
+constexpr bool isQuietSpace(unsigned c) {
+    // '\v' and '\f' are spaces, but they make a line non-blank
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+constexpr std::uint8_t runBit(unsigned hiNibble) {
+    return hiNibble == 0 ? 0x20 : hiNibble == 2 ? 0x40 :
+           hiNibble >= 3 && hiNibble <= 7 ? static_cast<std::uint8_t>(1u << (hiNibble - 3)) : 0;
+}
+
+constexpr RunTables makeRunTables() {
+    RunTables tables;
+    for (unsigned c = 0; c < 128; c++) {
+        if (isQuietWordChar(c) || isQuietSpace(c)) {
+            tables.hi[c >> 4] = runBit(c >> 4);
+            tables.lo[c & 15] |= runBit(c >> 4);
+        }
+    }
+    for (unsigned c = 0; c < 256; c++) {
+        tables.byte[c] = tables.lo[c & 15] & tables.hi[c >> 4];
+    }
+    return tables;
+}
+
+constexpr RunTables kRunTables = makeRunTables();
+
+static_assert(kRunTables.byte['x'] & kWordRun, "run tables are broken");
+static_assert(!(kRunTables.byte['h'] & kWordRun) && !(kRunTables.byte['O'] & kWordRun), "run tables are broken");
+static_assert(!(kRunTables.byte[' '] & kWordRun) && (kRunTables.byte[' '] & kSpaceRun), "run tables are broken");
+static_assert(!(kRunTables.byte['\n'] & kSpaceRun) && !(kRunTables.byte[0xe0] & (kWordRun | kSpaceRun)),
+              "run tables are broken");
+
+using RunSkipper = std::size_t (*)(const char* code, std::size_t i, std::size_t n, std::uint8_t run);
+
+// Each skipper returns the first position from i on that is not quiet for run
+std::size_t skipRunScalar(const char* code, std::size_t i, std::size_t n, std::uint8_t run) {
+    while (i < n && (kRunTables.byte[static_cast<unsigned char>(code[i])] & run)) {
+        i++;
+    }
+    return i;
+}
+
+#if defined(CCSL_LEXER_X86)
+// SSE2 has no byte shuffle, so the vector skippers need SSSE3 or AVX2
+__attribute__((target("ssse3")))
+std::size_t skipRunSsse3(const char* code, std::size_t i, std::size_t n, std::uint8_t run) {
+    const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kRunTables.lo));
+    const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kRunTables.hi));
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    const __m128i runMask = _mm_set1_epi8(static_cast<char>(run));
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(code + i));
+        const __m128i quiet = _mm_and_si128(
+            _mm_and_si128(_mm_shuffle_epi8(lo, _mm_and_si128(bytes, nibble)),
+                          _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble))),
+            runMask);
+        const unsigned loud = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(quiet, zero)));
+        if (loud != 0) {
+            return i + static_cast<std::size_t>(__builtin_ctz(loud));
+        }
+    }
+    return skipRunScalar(code, i, n, run);
+}
+
+__attribute__((target("avx2")))
+std::size_t skipRunAvx2(const char* code, std::size_t i, std::size_t n, std::uint8_t run) {
+    const __m256i lo = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(kRunTables.lo)));
+    const __m256i hi = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(kRunTables.hi)));
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    const __m256i runMask = _mm256_set1_epi8(static_cast<char>(run));
+    const __m256i zero = _mm256_setzero_si256();
+    for (; i + 32 <= n; i += 32) {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(code + i));
+        const __m256i quiet = _mm256_and_si256(
+            _mm256_and_si256(_mm256_shuffle_epi8(lo, _mm256_and_si256(bytes, nibble)),
+                             _mm256_shuffle_epi8(hi, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibble))),
+            runMask);
+        const unsigned loud = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(quiet, zero)));
+        if (loud != 0) {
+            return i + static_cast<std::size_t>(__builtin_ctz(loud));
+        }
+    }
+    return skipRunScalar(code, i, n, run);
+}
+#endif
+
+#if defined(CCSL_LEXER_NEON)
+std::size_t skipRunNeon(const char* code, std::size_t i, std::size_t n, std::uint8_t run) {
+    const uint8x16_t lo = vld1q_u8(kRunTables.lo);
+    const uint8x16_t hi = vld1q_u8(kRunTables.hi);
+    const uint8x16_t nibble = vdupq_n_u8(0x0f);
+    const uint8x16_t runMask = vdupq_n_u8(run);
+    for (; i + 16 <= n; i += 16) {
+        const uint8x16_t bytes = vld1q_u8(reinterpret_cast<const std::uint8_t*>(code + i));
+        const uint8x16_t quiet = vandq_u8(vandq_u8(vqtbl1q_u8(lo, vandq_u8(bytes, nibble)),
+                                                   vqtbl1q_u8(hi, vshrq_n_u8(bytes, 4))), runMask);
+        // NEON has no movemask; narrowing leaves four bits per byte
+        const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(vceqzq_u8(quiet)), 4);
+        const std::uint64_t loud = vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+        if (loud != 0) {
+            return i + static_cast<std::size_t>(__builtin_ctzll(loud) / 4);
+        }
+    }
+    return skipRunScalar(code, i, n, run);
+}
+#endif
+
+RunSkipper selectRunSkipper() {
+#if defined(CCSL_LEXER_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return skipRunAvx2;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        return skipRunSsse3;
+    }
+#elif defined(CCSL_LEXER_NEON)
+    return skipRunNeon;
+#endif
+    return skipRunScalar;
+}
+
+} // namespace
+
+SourceSummary scanSource(std::string_view code) {
+    CCSL_PROBE(probe, Probe::SCAN_SOURCE, code.size());
+    SourceSummary summary;
+    summary.byteCount = code.size();
+
+    const std::size_t n = code.size();
+    constexpr std::size_t npos = std::string_view::npos;
+    static const RunSkipper skipRun = selectRunSkipper();
+
+    // Current line state
+    LineSummary line;
+    bool indentDone = false;
+    bool indentHasTab = false;
+    bool indentHasSpace = false;
+    int blockCommentStarts = 0;   // Word starts up to the "/*" marker
+    int lineCommentStarts = 0;    // Word starts up to the "//" marker
+    bool lineCommentNext = false; // Whether the character after "//" starts a word
+
+    // Token state
+    std::size_t wordStart = npos;
+    bool pendingCall = false;       // Word seen, waiting for '('
+    bool pendingControl = false;    // Control keyword seen, waiting for '('
+    bool pendingStructured = false; // "structured" seen, waiting for "binding"
+    bool structuredGap = false;     // Whitespace seen after "structured"
+    bool bindingCandidate = false;  // Current word follows "structured" and whitespace
+    bool pendingBrace = false;      // ')' seen, waiting for '{'
+    bool pendingComplexity = false; // "O(" seen, waiting for ')'
+    std::size_t referenceEnd = 0;   // End of the last matched reference
+    int braceDepth = 0;
+
+    auto finishLine = [&](std::size_t end) {
+        line.length = end - line.offset;
+        line.mixedIndent = indentHasTab && indentHasSpace;
+        if (line.blockCommentOpen != npos) {
+            line.wordsFromBlockComment = line.words - blockCommentStarts + 1;
+        }
+        if (line.lineComment != npos) {
+            line.wordsAfterLineComment = line.words - lineCommentStarts + (lineCommentNext ? 1 : 0);
+        }
+        summary.lines.push_back(line);
+
+        line = LineSummary();
+        line.offset = end + 1;
+        indentDone = false;
+        indentHasTab = false;
+        indentHasSpace = false;
+        lineCommentNext = false;
+    };
+
+    auto emitWord = [&](std::size_t end) {
+        const std::string_view word = code.substr(wordStart, end - wordStart);
+        summary.identifiers++;
+
+        pendingControl = false;
+        const WordClass wordClass = kKeywordMatcher.find(word);
+        switch (wordClass) {
+            case WordClass::CONTROL:
+                pendingControl = true;
+                break;
+            case WordClass::TEST:
+                summary.testIndicators++;
+                break;
+            case WordClass::ADVANCED:
+                summary.advancedFeatures++;
+                break;
+            case WordClass::STRUCTURED:
+                pendingStructured = true;
+                structuredGap = false;
+                break;
+            case WordClass::DESIGN_PATTERN:
+                summary.designPatterns++;
+                break;
+            case WordClass::BINDING:
+            case WordClass::NONE:
+                break;
+        }
+
+        if (bindingCandidate && wordClass == WordClass::BINDING) {
+            summary.advancedFeatures++;
+        }
+        bindingCandidate = false;
+        pendingCall = true;
+        wordStart = npos;
+    };
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const unsigned char c = static_cast<unsigned char>(code[i]);
+        const bool space = isSpace(c);
+
+        // Word tokens
+        if (isWordChar(c)) {
+            if (wordStart == npos) {
+                wordStart = i;
+                bindingCandidate = pendingStructured && structuredGap;
+                pendingStructured = false;
+                pendingCall = false;
+                pendingControl = false;
+            }
+        } else {
+            if (wordStart != npos) {
+                emitWord(i);
+            }
+
+            if (space) {
+                structuredGap = true;
+            } else {
+                pendingStructured = false;
+                if (pendingCall && c == '(') {
+                    summary.callSites++;
+                    if (pendingControl) {
+                        summary.controlStatements++;
+                    }
+                }
+                pendingCall = false;
+                pendingControl = false;
+            }
+        }
+
+        // References, documentation tags and complexity annotations
+        if (i >= referenceEnd && (c == 'h' || c == 'R' || c == 'I')) {
+            std::size_t end = matchReference(code, i);
+            if (end != npos) {
+                summary.references++;
+                referenceEnd = end;
+            }
+        }
+
+        if (c == '@' && isDocTag(code, i)) {
+            summary.docTags++;
+        }
+
+        if (pendingComplexity) {
+            if (c == ')') {
+                summary.complexityAnnotations++;
+                pendingComplexity = false;
+            }
+        } else if (c == 'O' && i + 1 < n && code[i + 1] == '(') {
+            pendingComplexity = true;
+        }
+
+        // Symbols and braces
+        if (isSymbol(c)) {
+            summary.symbols++;
+        }
+
+        if (c == '{') {
+            braceDepth++;
+            summary.maxBraceDepth = std::max(summary.maxBraceDepth, braceDepth);
+        } else if (c == '}') {
+            braceDepth = std::max(0, braceDepth - 1);
+        }
+
+        if (pendingBrace && !space) {
+            if (c == '{') {
+                summary.closeParenBraces++;
+            }
+            pendingBrace = false;
+        }
+        if (c == ')') {
+            pendingBrace = true;
+        }
+
+        // Lines
+        if (c == '\n') {
+            finishLine(i);
+            continue;
+        }
+
+        if (c != ' ' && c != '\t' && c != '\r') {
+            line.blank = false;
+        }
+
+        if (!indentDone) {
+            if (c == ' ' || c == '\t') {
+                if (line.indentLength == 0) {
+                    line.indentChar = static_cast<char>(c);
+                }
+                line.indentLength++;
+                (c == '\t' ? indentHasTab : indentHasSpace) = true;
+            } else {
+                indentDone = true;
+            }
+        }
+
+        const bool hasPrev = i > line.offset;
+        const unsigned char prev = hasPrev ? static_cast<unsigned char>(code[i - 1]) : '\0';
+        if (hasPrev && c == '*' && prev == '/' && line.blockCommentOpen == npos) {
+            line.blockCommentOpen = i - 1 - line.offset;
+            blockCommentStarts = line.words;
+        }
+        if (hasPrev && c == '/' && prev == '*' && line.blockCommentClose == npos) {
+            line.blockCommentClose = i - 1 - line.offset;
+        }
+        if (hasPrev && c == '/' && prev == '/' && line.lineComment == npos) {
+            line.lineComment = i - 1 - line.offset;
+            lineCommentStarts = line.words;
+            lineCommentNext = i + 1 < n && !isSpace(static_cast<unsigned char>(code[i + 1]));
+        }
+
+        if (!space && (!hasPrev || isSpace(prev))) {
+            line.words++;
+        }
+
+        // The rest of a run of quiet bytes would leave every counter as it
+        // is, so jump to the first byte that is not; short runs stay scalar
+        const std::uint8_t run = !indentDone ? 0 : isWordChar(c) ? kWordRun : space ? kSpaceRun : 0;
+        if (run && i + 2 < n && (kRunTables.byte[static_cast<unsigned char>(code[i + 1])] & run) &&
+            (kRunTables.byte[static_cast<unsigned char>(code[i + 2])] & run)) {
+            i = skipRun(code.data(), i + 3, n, run) - 1;
+        }
+    }
+
+    if (wordStart != npos) {
+        emitWord(n);
+    }
+    if (line.offset < n) {
+        finishLine(n);
+    }
+
+    return summary;
+}
+
+} // namespace ccsl
@@ -6,21 +6,77 @@
 
 #include <ccsl/license.hpp>
 #include <ccsl/utility.hpp>
+#include <ccsl/instrumentation.hpp>
 #include <iostream>
 #include <algorithm>
-#include <sstream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
 
 namespace ccsl {
 
+namespace {
+
+/**
+ * @brief Find where a line range goes among the ranges of a file
+ * @param ranges Disjoint ranges of the file, keyed by start line
+ * @return Insertion hint for the range, or nothing if it overlaps a range
+ */
+template <typename Ranges>
+std::optional<typename Ranges::const_iterator> findFreeSlot(const Ranges& ranges, int lineStart, int lineEnd) {
+    // Only the last range starting at or before lineEnd can overlap: the
+    // ranges are disjoint, so it also has the largest end of those candidates.
+    // Without an overlap no range starts within the new one, so this is
+    // also where lineStart would be inserted
+    auto slot = ranges.upper_bound(lineEnd);
+    if (slot != ranges.begin() && std::prev(slot)->second.lineEnd >= lineStart) {
+        return std::nullopt;
+    }
+    return slot;
+}
+
+} // namespace
+
+void MetricScores::set(MetricType type, double value, const MetricCounts& rawCounts) {
+    const std::size_t index = metricIndex(type);
+    values[index] = value;
+    counts[index] = rawCounts;
+    present |= static_cast<std::uint8_t>(1u << index);
+}
+
+std::size_t MetricScores::size() const {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < kMetricTypeCount; i++) {
+        count += (present >> i) & 1u;
+    }
+    return count;
+}
+
+double MetricScores::mean() const {
+    std::size_t count = 0;
+    double sum = 0.0;
+    for (std::size_t i = 0; i < kMetricTypeCount; i++) {
+        if ((present >> i) & 1u) {
+            sum += values[i];
+            count++;
+        }
+    }
+    
+    return count > 0 ? sum / count : 0.0;
+}
+
 CodeContribution::CodeContribution(
     const std::string& contributor,
     const std::string& fileId,
     int lineStart,
-    int lineEnd
+    int lineEnd,
+    const allocator_type& allocator
 ) : m_contributor(contributor),
     m_fileId(fileId),
     m_lineStart(lineStart),
-    m_lineEnd(lineEnd)
+    m_lineEnd(lineEnd),
+    m_evaluations(allocator)
 {
     // Validate input parameters
     if (lineStart > lineEnd) {
@@ -36,6 +92,26 @@ CodeContribution::CodeContribution(
     }
 }
 
+CodeContribution::CodeContribution(const CodeContribution& other, const allocator_type& allocator)
+    : m_contributor(other.m_contributor),
+      m_fileId(other.m_fileId),
+      m_lineStart(other.m_lineStart),
+      m_lineEnd(other.m_lineEnd),
+      m_evaluations(other.m_evaluations, allocator),
+      m_scores(other.m_scores)
+{
+}
+
+CodeContribution::CodeContribution(CodeContribution&& other, const allocator_type& allocator)
+    : m_contributor(other.m_contributor),
+      m_fileId(other.m_fileId),
+      m_lineStart(other.m_lineStart),
+      m_lineEnd(other.m_lineEnd),
+      m_evaluations(std::move(other.m_evaluations), allocator),
+      m_scores(other.m_scores)
+{
+}
+
 void CodeContribution::addMetricEvaluation(const MetricEvaluation& evaluation) {
     // Check if this metric type already exists, and replace it if so
     auto it = std::find_if(m_evaluations.begin(), m_evaluations.end(),
@@ -48,20 +124,28 @@ void CodeContribution::addMetricEvaluation(const MetricEvaluation& evaluation) {
     } else {
         m_evaluations.push_back(evaluation);
     }
+    
+    m_scores.set(evaluation.type, evaluation.value);
 }
 
-double CodeContribution::calculateValue() const {
-    if (m_evaluations.empty()) {
-        return 0.0;
-    }
+void CodeContribution::setMetricScores(const MetricScores& scores) {
+    // Drop detailed evaluations that the new scores supersede
+    m_evaluations.erase(
+        std::remove_if(m_evaluations.begin(), m_evaluations.end(),
+                       [&scores](const MetricEvaluation& e) { return scores.has(e.type); }),
+        m_evaluations.end());
     
-    // Calculate the average of all metric values
-    double sum = 0.0;
-    for (const auto& eval : m_evaluations) {
-        sum += eval.value;
+    for (std::size_t i = 0; i < kMetricTypeCount; i++) {
+        const MetricType type = static_cast<MetricType>(i);
+        if (scores.has(type)) {
+            m_scores.set(type, scores.values[i], scores.counts[i]);
+        }
     }
-    
-    return sum / m_evaluations.size();
+}
+
+double CodeContribution::calculateValue() const {
+    // Calculate the average of all metric values
+    return m_scores.mean();
 }
 
 PaymentManager::PaymentManager(const std::string& walletAddress)
@@ -73,50 +157,90 @@ PaymentManager::PaymentManager(const std::string& walletAddress)
     }
 }
 
-bool PaymentManager::recordPayment(const CodeContribution& contribution, double amount) {
-    if (amount <= 0) {
+bool PaymentManager::recordPayment(const CodeContribution& contribution, Satoshis amount) {
+    if (amount <= Satoshis(0)) {
         std::cerr << "Payment amount must be greater than zero" << std::endl;
         return false;
     }
     
+    // The grand total bounds every contributor's total, so checking it alone prevents overflow
+    Satoshis total = m_total;
+    if (!total.tryAdd(amount)) {
+        std::cerr << "Payment total would overflow" << std::endl;
+        return false;
+    }
+    
     // Record the payment
-    const std::string contributor = contribution.getContributor();
-    m_payments[contributor] += amount;
+    m_payments[contribution.getInternedContributor()] += amount;
+    m_total = total;
     return true;
 }
 
+bool PaymentManager::recordPayment(const CodeContribution& contribution, double amount) {
+    const std::optional<Satoshis> satoshis = Satoshis::tryFromBitcoins(amount);
+    if (!satoshis) {
+        std::cerr << "Payment amount must be a positive number of satoshis within range" << std::endl;
+        return false;
+    }
+    return recordPayment(contribution, *satoshis);
+}
+
 double PaymentManager::getTotalPaymentsForContributor(const std::string& contributor) const {
-    auto it = m_payments.find(contributor);
-    if (it != m_payments.end()) {
-        return it->second;
+    return getContributorTotal(contributor).toBitcoins();
+}
+
+Satoshis PaymentManager::getContributorTotal(const std::string& contributor) const {
+    // A name that was never interned cannot have been paid, and is not interned now
+    std::optional<InternedString> name = InternedString::find(contributor);
+    if (name) {
+        auto it = m_payments.find(*name);
+        if (it != m_payments.end()) {
+            return it->second;
+        }
     }
-    return 0.0;
+    return Satoshis(0);
 }
 
 std::string PaymentManager::generatePaymentReport() const {
-    std::stringstream report;
-    report << "Payment Report\n";
-    report << "==============\n\n";
-    report << "Wallet Address: " << m_walletAddress << "\n\n";
-    report << "Contributor Payments:\n";
+    std::string report;
+    writePaymentReport([&report](std::string_view chunk) { report += chunk; });
+    return report;
+}
+
+void PaymentManager::writePaymentReport(std::ostream& out) const {
+    ReportWriter writer(out);
+    writeReport(writer);
+}
+
+void PaymentManager::writePaymentReport(const ReportSink& sink) const {
+    ReportWriter writer(sink);
+    writeReport(writer);
+}
+
+void PaymentManager::writeReport(ReportWriter& writer) const {
+    writer << "Payment Report\n"
+           << "==============\n\n"
+           << "Wallet Address: " << m_walletAddress << "\n\n"
+           << "Contributor Payments:\n";
     
     for (const auto& [contributor, amount] : m_payments) {
-        report << contributor << ": " << formatBitcoinAmount(amount) << " BTC\n";
+        writer << contributor.str() << ": ";
+        writer.writeBitcoinAmount(amount) << " BTC\n";
     }
     
-    double total = 0.0;
-    for (const auto& [_, amount] : m_payments) {
-        total += amount;
-    }
-    
-    report << "\nTotal Payments: " << formatBitcoinAmount(total) << " BTC\n";
-    
-    return report.str();
+    writer << "\nTotal Payments: ";
+    writer.writeBitcoinAmount(m_total) << " BTC\n";
 }
 
-License::License(const std::string& projectName, const std::string& licenseKey)
+License::License(const std::string& projectName, const std::string& licenseKey,
+                 std::pmr::memory_resource* resource)
     : m_projectName(projectName),
       m_licenseKey(licenseKey),
+      m_contributions(resource),
+      m_lineIndex(resource),
+      m_scoreMatrix(MetricWeights(), resource),
+      m_contributorValues(resource),
+      m_fileValues(resource),
       m_paymentManager("1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa")  // Default Bitcoin address
 {
     // Validate input parameters
@@ -129,27 +253,365 @@ License::License(const std::string& projectName, const std::string& licenseKey)
     }
 }
 
-bool License::registerContribution(const CodeContribution& contribution) {
+bool License::indexContribution(const CodeContribution& contribution, std::size_t index) {
+    CCSL_PROBE(probe, Probe::REGISTER_CONTRIBUTION, 0);
+    
     // Check if a contribution for the same file and line range already exists
-    auto it = std::find_if(m_contributions.begin(), m_contributions.end(),
-                          [&contribution](const CodeContribution& c) {
-                              auto [start, end] = c.getLineRange();
-                              auto [newStart, newEnd] = contribution.getLineRange();
-                              
-                              return c.getFileId() == contribution.getFileId() &&
-                                     ((newStart >= start && newStart <= end) ||
-                                      (newEnd >= start && newEnd <= end));
-                          });
+    auto [start, end] = contribution.getLineRange();
+    LineRanges& ranges = m_lineIndex[contribution.getInternedFileId()];
     
-    if (it != m_contributions.end()) {
+    auto slot = findFreeSlot(ranges, start, end);
+    if (!slot) {
         std::cerr << "A contribution already exists for this file and line range" << std::endl;
         return false;
     }
     
+    ranges.emplace_hint(*slot, start, IndexedRange{end, index});
+    return true;
+}
+
+bool License::indexLastContribution() {
+    if (!indexContribution(m_contributions.back(), m_contributions.size() - 1)) {
+        m_contributions.pop_back();
+        return false;
+    }
+    addValue(m_contributions.size() - 1);
+    return true;
+}
+
+bool License::registerContribution(const CodeContribution& contribution) {
+    if (!indexContribution(contribution, m_contributions.size())) {
+        return false;
+    }
     m_contributions.push_back(contribution);
+    addValue(m_contributions.size() - 1);
     return true;
 }
 
+bool License::registerContribution(CodeContribution&& contribution) {
+    if (!indexContribution(contribution, m_contributions.size())) {
+        return false;
+    }
+    m_contributions.push_back(std::move(contribution));
+    addValue(m_contributions.size() - 1);
+    return true;
+}
+
+std::size_t License::registerContributions(const std::vector<CodeContribution>& contributions) {
+    std::vector<const CodeContribution*> order;
+    order.reserve(contributions.size());
+    for (const auto& contribution : contributions) {
+        order.push_back(&contribution);
+    }
+    return registerSorted(order);
+}
+
+std::size_t License::registerContributions(std::vector<CodeContribution>&& contributions) {
+    std::vector<CodeContribution*> order;
+    order.reserve(contributions.size());
+    for (auto& contribution : contributions) {
+        order.push_back(&contribution);
+    }
+    return registerSorted(order);
+}
+
+template <typename Contribution>
+std::size_t License::registerSorted(std::vector<Contribution*>& order) {
+    // Sort by file and start line so each file is swept once, in line order;
+    // files are ordered by interned ID, which only has to group them
+    std::stable_sort(order.begin(), order.end(),
+                     [](const CodeContribution* a, const CodeContribution* b) {
+                         StringId fileA = a->getInternedFileId().getId();
+                         StringId fileB = b->getInternedFileId().getId();
+                         return fileA != fileB ? fileA < fileB : a->getLineRange().first < b->getLineRange().first;
+                     });
+    
+    m_contributions.reserve(m_contributions.size() + order.size());
+    m_scoreMatrix.reserve(m_contributions.size() + order.size());
+    
+    std::size_t registered = 0;
+    InternedString currentFile;
+    LineRanges* ranges = nullptr;
+    
+    for (Contribution* contribution : order) {
+        if (!ranges || contribution->getInternedFileId() != currentFile) {
+            currentFile = contribution->getInternedFileId();
+            ranges = &m_lineIndex[currentFile];
+        }
+        
+        auto [start, end] = contribution->getLineRange();
+        auto slot = findFreeSlot(*ranges, start, end);
+        if (!slot) {
+            continue;
+        }
+        
+        ranges->emplace_hint(*slot, start, IndexedRange{end, m_contributions.size()});
+        if constexpr (std::is_const_v<Contribution>) {
+            m_contributions.push_back(*contribution);
+        } else {
+            m_contributions.push_back(std::move(*contribution));
+        }
+        addValue(m_contributions.size() - 1);
+        registered++;
+    }
+    
+    if (registered < order.size()) {
+        std::cerr << (order.size() - registered)
+                  << " contributions overlap existing contributions and were skipped" << std::endl;
+    }
+    
+    return registered;
+}
+
+DiffEffect License::applyDiff(const FileDiff& diff, OverlapPolicy policy) {
+    DiffEffect effect;
+    const std::string& oldPath = diff.isNew() ? diff.newPath : diff.oldPath;
+    if (oldPath.empty()) {
+        return effect;
+    }
+    
+    // A path that was never interned has no contributions to look up
+    const std::optional<InternedString> oldId = InternedString::find(oldPath);
+    
+    std::vector<DiffHunk> hunks = diff.hunks;
+    std::sort(hunks.begin(), hunks.end(),
+              [](const DiffHunk& a, const DiffHunk& b) { return a.oldStart < b.oldStart; });
+    
+    std::vector<std::size_t> removed;
+    auto removeFile = [&](const std::optional<InternedString>& fileId) {
+        if (!fileId) {
+            return;
+        }
+        auto file = m_lineIndex.find(*fileId);
+        if (file != m_lineIndex.end()) {
+            for (const auto& [start, entry] : file->second) {
+                removed.push_back(entry.contribution);
+            }
+            m_lineIndex.erase(file);
+        }
+    };
+    
+    if (diff.isDeleted()) {
+        removeFile(oldId);
+        effect.removed = removed.size();
+        removeContributions(removed);
+        return effect;
+    }
+    
+    const InternedString newId = diff.newPath;
+    
+    // A new file, or a rename, replaces whatever was registered under the new path
+    if (diff.isNew() || newId != oldId) {
+        removeFile(newId);
+    }
+    
+    LineRanges updated(m_lineIndex.get_allocator().resource());
+    auto file = oldId ? m_lineIndex.find(*oldId) : m_lineIndex.end();
+    if (file != m_lineIndex.end()) {
+        // Sweep contributions and blocks together, both in line order; delta
+        // is the line shift caused by the blocks passed so far
+        std::size_t next = 0;
+        int delta = 0;
+        for (const auto& [start, entry] : file->second) {
+            const int end = entry.lineEnd;
+            while (next < hunks.size() &&
+                   (hunks[next].oldCount > 0 ? hunks[next].oldStart + hunks[next].oldCount <= start
+                                             : hunks[next].oldStart <= start)) {
+                delta += hunks[next].newCount - hunks[next].oldCount;
+                next++;
+            }
+            
+            if (next < hunks.size() && hunks[next].oldStart <= end) {
+                removed.push_back(entry.contribution);
+                if (policy == OverlapPolicy::MERGE) {
+                    // Find where the contribution's last line ends up; the
+                    // blocks from next up to last all touch it
+                    std::size_t last = next;
+                    int lastDelta = delta;
+                    while (last + 1 < hunks.size() && hunks[last + 1].oldStart <= end) {
+                        lastDelta += hunks[last].newCount - hunks[last].oldCount;
+                        last++;
+                    }
+                    const DiffHunk& block = hunks[last];
+                    const int newStart = std::min(start, hunks[next].oldStart) + delta;
+                    const int newEnd = end >= block.oldStart + block.oldCount
+                        ? end + lastDelta + block.newCount - block.oldCount
+                        : block.newStart + block.newCount - 1;
+                    if (newStart <= newEnd) {
+                        effect.dirtyRanges.emplace_back(newStart, newEnd);
+                    }
+                }
+                continue;
+            }
+            
+            CodeContribution& contribution = m_contributions[entry.contribution];
+            if (delta != 0) {
+                contribution.m_lineStart += delta;
+                contribution.m_lineEnd += delta;
+                effect.shifted++;
+            }
+            if (newId != oldId) {
+                // The contribution's value follows it to the new path
+                const double value = m_scoreMatrix.getValue(entry.contribution);
+                subtractValue(m_fileValues, contribution.m_fileId, value);
+                ValueTotal& total = m_fileValues[newId];
+                total.value += value;
+                total.contributions++;
+                contribution.m_fileId = newId;
+            }
+            updated.emplace_hint(updated.end(), start + delta, IndexedRange{end + delta, entry.contribution});
+        }
+        m_lineIndex.erase(file);
+    }
+    m_lineIndex[newId] = std::move(updated);
+    
+    for (const DiffHunk& hunk : hunks) {
+        if (hunk.newCount > 0) {
+            effect.dirtyRanges.emplace_back(hunk.newStart, hunk.newStart + hunk.newCount - 1);
+        }
+    }
+    
+    // Merged ranges can overlap the blocks and each other; join them
+    std::sort(effect.dirtyRanges.begin(), effect.dirtyRanges.end());
+    std::size_t joined = 0;
+    for (const auto& range : effect.dirtyRanges) {
+        if (joined > 0 && range.first <= effect.dirtyRanges[joined - 1].second) {
+            effect.dirtyRanges[joined - 1].second = std::max(effect.dirtyRanges[joined - 1].second, range.second);
+        } else {
+            effect.dirtyRanges[joined++] = range;
+        }
+    }
+    effect.dirtyRanges.resize(joined);
+    
+    effect.removed = removed.size();
+    removeContributions(removed);
+    return effect;
+}
+
+void License::removeContributions(std::vector<std::size_t>& indices) {
+    // Fill each hole with the last contribution; going from the highest
+    // index down, the one moved is never itself waiting to be removed
+    std::sort(indices.begin(), indices.end(), std::greater<std::size_t>());
+    for (std::size_t index : indices) {
+        const CodeContribution& removed = m_contributions[index];
+        const double value = m_scoreMatrix.getValue(index);
+        subtractValue(m_contributorValues, removed.getInternedContributor(), value);
+        subtractValue(m_fileValues, removed.getInternedFileId(), value);
+        m_totalValue = m_contributions.size() > 1 ? m_totalValue - value : 0.0;
+        m_scoreMatrix.removeSwap(index);
+        
+        const std::size_t last = m_contributions.size() - 1;
+        if (index != last) {
+            m_contributions[index] = std::move(m_contributions[last]);
+            const CodeContribution& moved = m_contributions[index];
+            m_lineIndex[moved.getInternedFileId()].find(moved.getLineRange().first)->second.contribution = index;
+        }
+        m_contributions.pop_back();
+    }
+}
+
+void License::addValue(std::size_t index) {
+    const CodeContribution& contribution = m_contributions[index];
+    const double value = m_scoreMatrix.append(contribution.getMetricScores());
+    
+    ValueTotal& byContributor = m_contributorValues[contribution.getInternedContributor()];
+    byContributor.value += value;
+    byContributor.contributions++;
+    ValueTotal& byFile = m_fileValues[contribution.getInternedFileId()];
+    byFile.value += value;
+    byFile.contributions++;
+    m_totalValue += value;
+}
+
+void License::subtractValue(ValueTotals& totals, InternedString key, double value) {
+    // Dropping a total with its last contribution keeps rounding left over
+    // from the subtractions from showing up as a tiny nonzero value
+    auto it = totals.find(key);
+    if (--it->second.contributions == 0) {
+        totals.erase(it);
+    } else {
+        it->second.value -= value;
+    }
+}
+
+void License::rebuildValues() {
+    // Sums in registration order, as registering one by one would
+    m_contributorValues.clear();
+    m_fileValues.clear();
+    m_totalValue = 0.0;
+    for (std::size_t i = 0; i < m_contributions.size(); i++) {
+        const CodeContribution& contribution = m_contributions[i];
+        const double value = m_scoreMatrix.getValue(i);
+        ValueTotal& byContributor = m_contributorValues[contribution.getInternedContributor()];
+        byContributor.value += value;
+        byContributor.contributions++;
+        ValueTotal& byFile = m_fileValues[contribution.getInternedFileId()];
+        byFile.value += value;
+        byFile.contributions++;
+        m_totalValue += value;
+    }
+}
+
+void License::setMetricWeights(const MetricWeights& weights) {
+    m_scoreMatrix.setWeights(weights);
+    rebuildValues();
+}
+
+double License::getContributionValue(std::size_t index) const {
+    if (index >= m_contributions.size()) {
+        throw std::out_of_range("Contribution index out of range");
+    }
+    return m_scoreMatrix.getValue(index);
+}
+
+namespace {
+
+template <typename Totals>
+double findTotal(const Totals& totals, InternedString key) {
+    auto it = totals.find(key);
+    return it != totals.end() ? it->second.value : 0.0;
+}
+
+template <typename Totals>
+double findTotal(const Totals& totals, const std::string& key) {
+    // A name that was never interned has no contributions
+    std::optional<InternedString> interned = InternedString::find(key);
+    return interned ? findTotal(totals, *interned) : 0.0;
+}
+
+template <typename Totals>
+std::vector<std::pair<std::string, double>> sortedTotals(const Totals& totals) {
+    std::vector<std::pair<std::string, double>> result;
+    result.reserve(totals.size());
+    for (const auto& [key, total] : totals) {
+        result.emplace_back(key.str(), total.value);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+} // namespace
+
+double License::getContributorValue(const std::string& contributor) const {
+    return findTotal(m_contributorValues, contributor);
+}
+
+double License::getInternedContributorValue(InternedString contributor) const {
+    return findTotal(m_contributorValues, contributor);
+}
+
+double License::getFileValue(const std::string& fileId) const {
+    return findTotal(m_fileValues, fileId);
+}
+
+std::vector<std::pair<std::string, double>> License::getContributorValues() const {
+    return sortedTotals(m_contributorValues);
+}
+
+std::vector<std::pair<std::string, double>> License::getFileValues() const {
+    return sortedTotals(m_fileValues);
+}
+
 bool License::validate() const {
     // Simple validation logic for now
     if (m_projectName.empty() || m_licenseKey.empty()) {
@@ -166,23 +628,38 @@ bool License::validate() const {
 }
 
 std::string License::getLicenseInfo() const {
-    std::stringstream info;
-    info << "CCSL License Information\n";
-    info << "=======================\n\n";
-    info << "Project: " << m_projectName << "\n";
-    info << "License Key: " << m_licenseKey << "\n";
-    info << "Validation Status: " << (validate() ? "Valid" : "Invalid") << "\n\n";
-    
-    info << "Registered Contributions:\n";
-    for (const auto& contribution : m_contributions) {
-        info << "  Contributor: " << contribution.getContributor() << "\n";
-        info << "  File: " << contribution.getFileId() << "\n";
-        info << "  Lines: " << contribution.getLineRange().first << "-" 
-             << contribution.getLineRange().second << "\n";
-        info << "  Value: " << contribution.calculateValue() << "\n\n";
-    }
-    
-    return info.str();
+    std::string info;
+    writeLicenseInfo([&info](std::string_view chunk) { info += chunk; });
+    return info;
+}
+
+void License::writeLicenseInfo(std::ostream& out) const {
+    ReportWriter writer(out);
+    writeInfo(writer);
+}
+
+void License::writeLicenseInfo(const ReportSink& sink) const {
+    ReportWriter writer(sink);
+    writeInfo(writer);
+}
+
+void License::writeInfo(ReportWriter& writer) const {
+    writer << "CCSL License Information\n"
+           << "=======================\n\n"
+           << "Project: " << m_projectName << "\n"
+           << "License Key: " << m_licenseKey << "\n"
+           << "Validation Status: " << (validate() ? "Valid" : "Invalid") << "\n\n"
+           << "Registered Contributions:\n";
+    
+    // Values come from the cache, weighted with the project's weights
+    for (std::size_t i = 0; i < m_contributions.size(); i++) {
+        const CodeContribution& contribution = m_contributions[i];
+        const auto [start, end] = contribution.getLineRange();
+        writer << "  Contributor: " << contribution.getContributor() << "\n"
+               << "  File: " << contribution.getFileId() << "\n"
+               << "  Lines: " << start << "-" << end << "\n"
+               << "  Value: " << m_scoreMatrix.getValue(i) << "\n\n";
+    }
 }
 
 } // namespace ccsl
\ No newline at end of file
@@ -0,0 +1,499 @@
+/**
+ * @file license_snapshot.cpp
+ * @brief Implementation of the memory-mappable License snapshot
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/license_snapshot.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CCSL_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ccsl {
+
+namespace {
+
+// File layout: header, contribution records, file index, line ranges,
+// payments, then the string table. Every record is a multiple of 8 bytes
+// and has explicit padding, so the sections stay aligned in the mapping
+// and no byte of the file is left uninitialized.
+constexpr char kMagic[8] = {'C', 'C', 'S', 'L', 'S', 'N', 'A', 'P'};
+constexpr std::uint32_t kByteOrderMark = 0x01020304;
+
+struct Section {
+    std::uint64_t offset; ///< Byte offset of the first record
+    std::uint64_t count;  ///< Number of records, or bytes for the string table
+};
+
+} // namespace
+
+struct LicenseSnapshot::StringRef {
+    std::uint32_t offset; ///< Byte offset in the string table
+    std::uint32_t length; ///< Length in bytes
+};
+
+struct LicenseSnapshot::Header {
+    char magic[8];
+    std::uint32_t byteOrder;
+    std::uint32_t version;
+    std::uint32_t headerSize;
+    std::uint32_t contributionSize;
+    std::uint64_t fileSize;
+    StringRef projectName;
+    StringRef licenseKey;
+    Section contributions;
+    Section files;
+    Section ranges;
+    Section payments;
+    Section strings;
+    std::int64_t totalPayments;
+};
+
+struct LicenseSnapshot::ContributionRecord {
+    StringRef contributor;
+    StringRef fileId;
+    std::int32_t lineStart;
+    std::int32_t lineEnd;
+    std::uint8_t present;
+    std::uint8_t reserved[7];
+    double values[kMetricTypeCount];
+    double counts[kMetricTypeCount][std::tuple_size<MetricCounts>::value];
+};
+
+struct LicenseSnapshot::FileRecord {
+    StringRef fileId;
+    std::uint32_t firstRange; ///< Index of the file's first line range
+    std::uint32_t rangeCount; ///< Number of line ranges of the file
+};
+
+struct LicenseSnapshot::RangeRecord {
+    std::int32_t lineStart;
+    std::int32_t lineEnd;
+    std::uint32_t contribution; ///< Index of the contribution record
+    std::uint32_t reserved;
+};
+
+struct LicenseSnapshot::PaymentRecord {
+    StringRef contributor;
+    std::int64_t satoshis;
+};
+
+bool LicenseSnapshot::write(const License& license, const std::filesystem::path& filePath) {
+    // Any change to these sizes is a format change and needs a new kVersion
+    static_assert(sizeof(Header) == 136, "Snapshot header layout changed");
+    static_assert(sizeof(ContributionRecord) == 224, "Contribution record layout changed");
+    static_assert(sizeof(FileRecord) == 16, "File record layout changed");
+    static_assert(sizeof(RangeRecord) == 16, "Range record layout changed");
+    static_assert(sizeof(PaymentRecord) == 16, "Payment record layout changed");
+
+    constexpr std::uint64_t kMaxCount = std::numeric_limits<std::uint32_t>::max();
+
+    // Contributors and file IDs repeat across records, so each is stored once
+    std::string strings;
+    std::unordered_map<std::string_view, StringRef> interned;
+    bool tooLarge = false;
+    auto intern = [&](std::string_view text) {
+        auto found = interned.find(text);
+        if (found != interned.end()) {
+            return found->second;
+        }
+        if (strings.size() + text.size() > kMaxCount) {
+            tooLarge = true;
+            return StringRef{0, 0};
+        }
+        StringRef ref{static_cast<std::uint32_t>(strings.size()), static_cast<std::uint32_t>(text.size())};
+        strings += text;
+        // The views point into the license, which outlives the table
+        interned.emplace(text, ref);
+        return ref;
+    };
+
+    const License::ContributionList& contributions = license.m_contributions;
+    if (contributions.size() > kMaxCount) {
+        return false;
+    }
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.byteOrder = kByteOrderMark;
+    header.version = kVersion;
+    header.headerSize = sizeof(Header);
+    header.contributionSize = sizeof(ContributionRecord);
+    header.projectName = intern(license.m_projectName);
+    header.licenseKey = intern(license.m_licenseKey);
+    header.totalPayments = license.m_paymentManager.m_total.getSatoshis();
+
+    std::vector<ContributionRecord> contributionRecords(contributions.size());
+    for (std::size_t i = 0; i < contributions.size(); i++) {
+        const CodeContribution& contribution = contributions[i];
+        ContributionRecord& record = contributionRecords[i];
+        record.contributor = intern(contribution.getContributor());
+        record.fileId = intern(contribution.getFileId());
+        record.lineStart = contribution.getLineRange().first;
+        record.lineEnd = contribution.getLineRange().second;
+        const MetricScores& scores = contribution.getMetricScores();
+        record.present = scores.present;
+        for (std::size_t m = 0; m < kMetricTypeCount; m++) {
+            record.values[m] = scores.values[m];
+            std::copy(scores.counts[m].begin(), scores.counts[m].end(), record.counts[m]);
+        }
+    }
+
+    // Files are sorted by name so open() can binary search them
+    std::vector<const std::pair<const InternedString, License::LineRanges>*> files;
+    for (const auto& file : license.m_lineIndex) {
+        if (!file.second.empty()) {
+            files.push_back(&file);
+        }
+    }
+    std::sort(files.begin(), files.end(), [](const auto* a, const auto* b) { return a->first.str() < b->first.str(); });
+
+    std::vector<FileRecord> fileRecords;
+    std::vector<RangeRecord> rangeRecords;
+    fileRecords.reserve(files.size());
+    rangeRecords.reserve(contributions.size());
+    for (const auto* file : files) {
+        fileRecords.push_back({intern(file->first.str()), static_cast<std::uint32_t>(rangeRecords.size()),
+                               static_cast<std::uint32_t>(file->second.size())});
+        for (const auto& [start, entry] : file->second) {
+            rangeRecords.push_back({start, entry.lineEnd, static_cast<std::uint32_t>(entry.contribution), 0});
+        }
+    }
+
+    std::vector<PaymentRecord> paymentRecords;
+    std::vector<std::pair<std::string_view, Satoshis>> payments;
+    payments.reserve(license.m_paymentManager.m_payments.size());
+    for (const auto& [contributor, amount] : license.m_paymentManager.m_payments) {
+        payments.emplace_back(contributor.str(), amount);
+    }
+    std::sort(payments.begin(), payments.end());
+    paymentRecords.reserve(payments.size());
+    for (const auto& [contributor, amount] : payments) {
+        paymentRecords.push_back({intern(contributor), amount.getSatoshis()});
+    }
+
+    if (tooLarge) {
+        return false;
+    }
+
+    std::uint64_t offset = sizeof(Header);
+    auto place = [&offset](Section& section, std::size_t count, std::size_t recordSize) {
+        section.offset = offset;
+        section.count = count;
+        offset += static_cast<std::uint64_t>(count) * recordSize;
+    };
+    place(header.contributions, contributionRecords.size(), sizeof(ContributionRecord));
+    place(header.files, fileRecords.size(), sizeof(FileRecord));
+    place(header.ranges, rangeRecords.size(), sizeof(RangeRecord));
+    place(header.payments, paymentRecords.size(), sizeof(PaymentRecord));
+    place(header.strings, strings.size(), 1);
+    header.fileSize = offset;
+
+    std::filesystem::path tempPath = filePath;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        auto put = [&file](const void* data, std::size_t size) {
+            file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        };
+        put(&header, sizeof(header));
+        put(contributionRecords.data(), contributionRecords.size() * sizeof(ContributionRecord));
+        put(fileRecords.data(), fileRecords.size() * sizeof(FileRecord));
+        put(rangeRecords.data(), rangeRecords.size() * sizeof(RangeRecord));
+        put(paymentRecords.data(), paymentRecords.size() * sizeof(PaymentRecord));
+        put(strings.data(), strings.size());
+        file.close();
+        if (!file) {
+            std::error_code error;
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, filePath, error);
+    if (error) {
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    return true;
+}
+
+std::optional<LicenseSnapshot> LicenseSnapshot::open(const std::filesystem::path& filePath) {
+    LicenseSnapshot snapshot;
+
+#ifdef CCSL_HAVE_MMAP
+    int fd = ::open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return std::nullopt;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) ||
+        static_cast<std::uintmax_t>(info.st_size) < sizeof(Header)) {
+        ::close(fd);
+        return std::nullopt;
+    }
+
+    // A shared read-only mapping lets every process use the same page cache
+    void* mapping = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return std::nullopt;
+    }
+    snapshot.m_mapping = mapping;
+    snapshot.m_data = static_cast<const char*>(mapping);
+    snapshot.m_size = static_cast<std::size_t>(info.st_size);
+#else
+    std::ifstream stream(filePath, std::ios::binary | std::ios::ate);
+    if (!stream.is_open()) {
+        return std::nullopt;
+    }
+
+    const std::streamsize size = stream.tellg();
+    if (size < static_cast<std::streamsize>(sizeof(Header))) {
+        return std::nullopt;
+    }
+    stream.seekg(0);
+    // Held as 64-bit words so the records are as aligned as in a mapping
+    snapshot.m_buffer = std::make_unique<std::uint64_t[]>((static_cast<std::size_t>(size) + 7) / 8);
+    if (!stream.read(reinterpret_cast<char*>(snapshot.m_buffer.get()), size)) {
+        return std::nullopt;
+    }
+    snapshot.m_data = reinterpret_cast<const char*>(snapshot.m_buffer.get());
+    snapshot.m_size = static_cast<std::size_t>(size);
+#endif
+
+    // Only the header and section bounds are checked; records are read in place
+    const Header& header = snapshot.header();
+    auto fits = [&snapshot](const Section& section, std::size_t recordSize) {
+        return section.offset % alignof(std::uint64_t) == 0 && section.offset <= snapshot.m_size &&
+               section.count <= (snapshot.m_size - section.offset) / recordSize;
+    };
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.byteOrder != kByteOrderMark ||
+        header.version != kVersion ||
+        header.headerSize != sizeof(Header) ||
+        header.contributionSize != sizeof(ContributionRecord) ||
+        header.fileSize != snapshot.m_size ||
+        !fits(header.contributions, sizeof(ContributionRecord)) ||
+        !fits(header.files, sizeof(FileRecord)) ||
+        !fits(header.ranges, sizeof(RangeRecord)) ||
+        !fits(header.payments, sizeof(PaymentRecord)) ||
+        header.strings.offset > snapshot.m_size ||
+        header.strings.count > snapshot.m_size - header.strings.offset) {
+        return std::nullopt;
+    }
+
+    return snapshot;
+}
+
+LicenseSnapshot::~LicenseSnapshot() {
+    release();
+}
+
+LicenseSnapshot::LicenseSnapshot(LicenseSnapshot&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)),
+      m_size(std::exchange(other.m_size, 0)),
+      m_mapping(std::exchange(other.m_mapping, nullptr)),
+      m_buffer(std::move(other.m_buffer)) {
+}
+
+LicenseSnapshot& LicenseSnapshot::operator=(LicenseSnapshot&& other) noexcept {
+    if (this != &other) {
+        release();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+        m_buffer = std::move(other.m_buffer);
+    }
+    return *this;
+}
+
+void LicenseSnapshot::release() {
+#ifdef CCSL_HAVE_MMAP
+    if (m_mapping) {
+        ::munmap(m_mapping, m_size);
+    }
+#endif
+    m_mapping = nullptr;
+    m_data = nullptr;
+    m_size = 0;
+    m_buffer.reset();
+}
+
+const LicenseSnapshot::Header& LicenseSnapshot::header() const {
+    return *section<Header>(0);
+}
+
+std::string_view LicenseSnapshot::stringAt(const StringRef& ref) const {
+    // A damaged reference reads as an empty string rather than out of bounds
+    const Section& strings = header().strings;
+    if (ref.offset > strings.count || ref.length > strings.count - ref.offset) {
+        return {};
+    }
+    return std::string_view(m_data + strings.offset + ref.offset, ref.length);
+}
+
+std::string_view LicenseSnapshot::getProjectName() const {
+    return stringAt(header().projectName);
+}
+
+std::string_view LicenseSnapshot::getLicenseKey() const {
+    return stringAt(header().licenseKey);
+}
+
+std::size_t LicenseSnapshot::getContributionCount() const {
+    return static_cast<std::size_t>(header().contributions.count);
+}
+
+SnapshotContribution LicenseSnapshot::toContribution(const ContributionRecord& record) const {
+    SnapshotContribution contribution;
+    contribution.contributor = stringAt(record.contributor);
+    contribution.fileId = stringAt(record.fileId);
+    contribution.lineStart = record.lineStart;
+    contribution.lineEnd = record.lineEnd;
+    contribution.scores.present = record.present;
+    for (std::size_t m = 0; m < kMetricTypeCount; m++) {
+        contribution.scores.values[m] = record.values[m];
+        std::copy(std::begin(record.counts[m]), std::end(record.counts[m]), contribution.scores.counts[m].begin());
+    }
+    return contribution;
+}
+
+SnapshotContribution LicenseSnapshot::getContribution(std::size_t index) const {
+    if (index >= getContributionCount()) {
+        throw std::out_of_range("Contribution index is out of range");
+    }
+    return toContribution(section<ContributionRecord>(header().contributions.offset)[index]);
+}
+
+const LicenseSnapshot::FileRecord* LicenseSnapshot::findFile(std::string_view fileId) const {
+    const Header& h = header();
+    const FileRecord* first = section<FileRecord>(h.files.offset);
+    const FileRecord* last = first + h.files.count;
+    const FileRecord* file = std::lower_bound(first, last, fileId, [this](const FileRecord& record, std::string_view id) {
+        return stringAt(record.fileId) < id;
+    });
+    if (file == last || stringAt(file->fileId) != fileId ||
+        file->firstRange > h.ranges.count || file->rangeCount > h.ranges.count - file->firstRange) {
+        return nullptr;
+    }
+    return file;
+}
+
+const LicenseSnapshot::RangeRecord* LicenseSnapshot::findRange(const FileRecord& file, int line) const {
+    // Ranges are disjoint and sorted, so only the last one starting at or
+    // before the line can contain it
+    const RangeRecord* first = section<RangeRecord>(header().ranges.offset) + file.firstRange;
+    const RangeRecord* last = first + file.rangeCount;
+    const RangeRecord* range = std::upper_bound(first, last, line, [](int value, const RangeRecord& record) {
+        return value < record.lineStart;
+    });
+    if (range == first) {
+        return nullptr;
+    }
+    --range;
+    return range;
+}
+
+std::optional<SnapshotContribution> LicenseSnapshot::findContribution(std::string_view fileId, int line) const {
+    const FileRecord* file = findFile(fileId);
+    if (!file) {
+        return std::nullopt;
+    }
+    const RangeRecord* range = findRange(*file, line);
+    if (!range || range->lineEnd < line || range->contribution >= getContributionCount()) {
+        return std::nullopt;
+    }
+    return toContribution(section<ContributionRecord>(header().contributions.offset)[range->contribution]);
+}
+
+bool LicenseSnapshot::overlaps(std::string_view fileId, int lineStart, int lineEnd) const {
+    const FileRecord* file = findFile(fileId);
+    if (!file) {
+        return false;
+    }
+    const RangeRecord* range = findRange(*file, lineEnd);
+    return range && range->lineEnd >= lineStart;
+}
+
+Satoshis LicenseSnapshot::getContributorTotal(std::string_view contributor) const {
+    const Header& h = header();
+    const PaymentRecord* first = section<PaymentRecord>(h.payments.offset);
+    const PaymentRecord* last = first + h.payments.count;
+    const PaymentRecord* payment = std::lower_bound(first, last, contributor, [this](const PaymentRecord& record, std::string_view name) {
+        return stringAt(record.contributor) < name;
+    });
+    if (payment == last || stringAt(payment->contributor) != contributor) {
+        return Satoshis(0);
+    }
+    return Satoshis(payment->satoshis);
+}
+
+Satoshis LicenseSnapshot::getTotalPayments() const {
+    return Satoshis(header().totalPayments);
+}
+
+License LicenseSnapshot::toLicense() const {
+    const Header& h = header();
+    License license{std::string(getProjectName()), std::string(getLicenseKey())};
+
+    const ContributionRecord* records = section<ContributionRecord>(h.contributions.offset);
+    license.m_contributions.reserve(getContributionCount());
+    license.m_scoreMatrix.reserve(getContributionCount());
+    for (std::size_t i = 0; i < getContributionCount(); i++) {
+        const SnapshotContribution view = toContribution(records[i]);
+        CodeContribution contribution(std::string(view.contributor), std::string(view.fileId),
+                                      view.lineStart, view.lineEnd);
+        contribution.setMetricScores(view.scores);
+        license.m_contributions.push_back(std::move(contribution));
+        license.addValue(i);
+    }
+
+    // The ranges are already sorted, so each one is appended at the end of its map
+    const FileRecord* files = section<FileRecord>(h.files.offset);
+    const RangeRecord* ranges = section<RangeRecord>(h.ranges.offset);
+    for (std::size_t f = 0; f < h.files.count; f++) {
+        const FileRecord& file = files[f];
+        if (file.firstRange > h.ranges.count || file.rangeCount > h.ranges.count - file.firstRange) {
+            continue;
+        }
+        License::LineRanges& index = license.m_lineIndex[InternedString(stringAt(file.fileId))];
+        for (std::uint64_t r = file.firstRange; r < std::uint64_t(file.firstRange) + file.rangeCount; r++) {
+            if (ranges[r].contribution < getContributionCount()) {
+                index.emplace_hint(index.end(), ranges[r].lineStart,
+                                   License::IndexedRange{ranges[r].lineEnd, ranges[r].contribution});
+            }
+        }
+    }
+
+    const PaymentRecord* payments = section<PaymentRecord>(h.payments.offset);
+    for (std::size_t p = 0; p < h.payments.count; p++) {
+        license.m_paymentManager.m_payments.emplace(InternedString(stringAt(payments[p].contributor)),
+                                                    Satoshis(payments[p].satoshis));
+    }
+    license.m_paymentManager.m_total = Satoshis(h.totalPayments);
+
+    return license;
+}
+
+} // namespace ccsl
@@ -5,46 +5,51 @@
  */
 
 #include <ccsl/metrics.hpp>
+#include <ccsl/instrumentation.hpp>
 #include <ccsl/utility.hpp>
 #include <algorithm>
-#include <regex>
 #include <cmath>
 
 namespace ccsl {
 
-// Impact Evaluator Implementation
-MetricEvaluation ImpactEvaluator::evaluate(const std::string& code) const {
+// MetricEvaluator Implementation
+MetricEvaluation MetricEvaluator::evaluate(std::string_view code) const {
+    return evaluate(scanSource(code));
+}
+
+MetricEvaluation MetricEvaluator::evaluate(const SourceSummary& summary) const {
     MetricEvaluation result;
-    result.type = MetricType::IMPACT;
-    
+    MetricCounts counts{};
+    result.type = getType();
+    {
+        CCSL_PROBE(probe, evaluateProbe(result.type), summary.byteCount);
+        result.value = score(summary, counts);
+    }
+    result.rationale = formatRationale(counts);
+    return result;
+}
+
+// Impact Evaluator Implementation
+double ImpactEvaluator::score(const SourceSummary& summary, MetricCounts& counts) const {
     // Simple implementation: count function calls and control structures
     // as indicators of impact
-    int functionCalls = 0;
-    int controlStructures = 0;
-    
-    // Count function calls (simplified)
-    std::regex functionRegex(R"(\b\w+\s*\()");
-    auto functionBegin = std::sregex_iterator(code.begin(), code.end(), functionRegex);
-    auto functionEnd = std::sregex_iterator();
-    functionCalls = std::distance(functionBegin, functionEnd);
-    
-    // Count control structures (if, for, while, switch)
-    std::regex controlRegex(R"(\b(if|for|while|switch)\s*\()");
-    auto controlBegin = std::sregex_iterator(code.begin(), code.end(), controlRegex);
-    auto controlEnd = std::sregex_iterator();
-    controlStructures = std::distance(controlBegin, controlEnd);
+    int functionCalls = summary.callSites;
+    int controlStructures = summary.controlStatements;
     
     // Normalize score between 0 and 1
     // Higher impact is indicated by more function calls and control structures
     const int maxExpectedCount = 20; // arbitrary threshold
     double rawScore = (functionCalls + controlStructures) / static_cast<double>(maxExpectedCount);
-    result.value = std::min(1.0, std::max(0.0, rawScore));
-    
-    result.rationale = "Impact score based on " + std::to_string(functionCalls) + 
-                      " function calls and " + std::to_string(controlStructures) + 
-                      " control structures.";
+    double value = std::min(1.0, std::max(0.0, rawScore));
     
-    return result;
+    counts = {static_cast<double>(functionCalls), static_cast<double>(controlStructures), 0.0};
+    return value;
+}
+
+std::string ImpactEvaluator::formatRationale(const MetricCounts& counts) const {
+    return "Impact score based on " + std::to_string(static_cast<int>(counts[0])) + 
+           " function calls and " + std::to_string(static_cast<int>(counts[1])) + 
+           " control structures.";
 }
 
 std::string ImpactEvaluator::getDescription() const {
@@ -52,51 +57,29 @@ std::string ImpactEvaluator::getDescription() const {
 }
 
 // Simplicity Evaluator Implementation
-MetricEvaluation SimplicityEvaluator::evaluate(const std::string& code) const {
-    MetricEvaluation result;
-    result.type = MetricType::SIMPLICITY;
-    
+double SimplicityEvaluator::score(const SourceSummary& summary, MetricCounts& counts) const {
     // Simple implementation: examine line length, nesting depth, and symbol density
     
     // Average line length
-    std::istringstream stream(code);
-    std::string line;
     int totalLines = 0;
     int totalLineLength = 0;
-    int maxNestingDepth = 0;
-    int currentNestingDepth = 0;
+    int maxNestingDepth = summary.maxBraceDepth;
     
-    while (std::getline(stream, line)) {
+    for (const auto& line : summary.lines) {
         // Skip empty lines
-        if (line.empty() || line.find_first_not_of(" \t\r\n") == std::string::npos) {
+        if (line.blank) {
             continue;
         }
         
         totalLines++;
-        totalLineLength += line.length();
-        
-        // Calculate nesting depth
-        for (char c : line) {
-            if (c == '{') {
-                currentNestingDepth++;
-                maxNestingDepth = std::max(maxNestingDepth, currentNestingDepth);
-            } else if (c == '}') {
-                currentNestingDepth = std::max(0, currentNestingDepth - 1);
-            }
-        }
+        totalLineLength += line.length;
     }
     
     double avgLineLength = totalLines > 0 ? totalLineLength / static_cast<double>(totalLines) : 0;
     
     // Symbol density (rough calculation)
-    int symbolCount = 0;
-    std::string symbols = "+-*/=<>!&|^~%?:;[](){}";
-    for (char c : code) {
-        if (symbols.find(c) != std::string::npos) {
-            symbolCount++;
-        }
-    }
-    double symbolDensity = code.length() > 0 ? symbolCount / static_cast<double>(code.length()) : 0;
+    int symbolCount = summary.symbols;
+    double symbolDensity = summary.byteCount > 0 ? symbolCount / static_cast<double>(summary.byteCount) : 0;
     
     // Calculate simplicity score (higher score = more simple)
     // Ideal: short lines, low nesting depth, moderate symbol density
@@ -104,14 +87,17 @@ MetricEvaluation SimplicityEvaluator::evaluate(const std::string& code) const {
     double nestingScore = std::max(0.0, 1.0 - (maxNestingDepth / 5.0));
     double symbolScore = std::max(0.0, 1.0 - std::abs(symbolDensity - 0.1) / 0.1);
     
-    result.value = (lineScore + nestingScore + symbolScore) / 3.0;
-    result.value = std::min(1.0, std::max(0.0, result.value));
+    double value = (lineScore + nestingScore + symbolScore) / 3.0;
+    value = std::min(1.0, std::max(0.0, value));
     
-    result.rationale = "Simplicity score based on average line length (" + 
-                      std::to_string(avgLineLength) + " chars), nesting depth (" + 
-                      std::to_string(maxNestingDepth) + "), and symbol density.";
-    
-    return result;
+    counts = {avgLineLength, static_cast<double>(maxNestingDepth), symbolDensity};
+    return value;
+}
+
+std::string SimplicityEvaluator::formatRationale(const MetricCounts& counts) const {
+    return "Simplicity score based on average line length (" + 
+           std::to_string(counts[0]) + " chars), nesting depth (" + 
+           std::to_string(static_cast<int>(counts[1])) + "), and symbol density.";
 }
 
 std::string SimplicityEvaluator::getDescription() const {
@@ -119,74 +105,46 @@ std::string SimplicityEvaluator::getDescription() const {
 }
 
 // Cleanness Evaluator Implementation
-MetricEvaluation CleanessEvaluator::evaluate(const std::string& code) const {
-    MetricEvaluation result;
-    result.type = MetricType::CLEANNESS;
-    
+double CleanessEvaluator::score(const SourceSummary& summary, MetricCounts& counts) const {
     // Simple implementation: examine whitespace consistency, indentation, and bracket style
     
     // Check for consistent indentation
-    std::istringstream stream(code);
-    std::string line;
-    int totalLines = 0;
+    int totalLines = static_cast<int>(summary.lines.size());
     int indentedLines = 0;
     int emptyLines = 0;
     bool hasInconsistentIndentation = false;
-    std::string prevIndent;
+    const LineSummary* prevLine = nullptr;
     
-    while (std::getline(stream, line)) {
-        totalLines++;
-        
+    for (const auto& line : summary.lines) {
         // Skip empty lines
-        if (line.empty() || line.find_first_not_of(" \t\r\n") == std::string::npos) {
+        if (line.blank) {
             emptyLines++;
             continue;
         }
         
-        // Extract indentation
-        std::string indent;
-        size_t firstNonWhitespace = line.find_first_not_of(" \t");
-        if (firstNonWhitespace != std::string::npos) {
-            indent = line.substr(0, firstNonWhitespace);
-        }
-        
         // Check for mixed spaces and tabs
-        bool hasTabs = indent.find('\t') != std::string::npos;
-        bool hasSpaces = indent.find(' ') != std::string::npos;
-        if (hasTabs && hasSpaces) {
+        if (line.mixedIndent) {
             hasInconsistentIndentation = true;
         }
         
-        if (!indent.empty()) {
+        if (line.indentLength > 0) {
             indentedLines++;
             
             // Check if indentation is consistent with previous line
-            if (!prevIndent.empty() && 
-                (prevIndent.length() > 0 && indent.length() > 0) &&
-                ((prevIndent[0] == ' ' && indent[0] == '\t') || 
-                 (prevIndent[0] == '\t' && indent[0] == ' '))) {
+            if (prevLine && prevLine->indentLength > 0 &&
+                prevLine->indentChar != line.indentChar) {
                 hasInconsistentIndentation = true;
             }
         }
         
-        prevIndent = indent;
+        prevLine = &line;
     }
     
-    // Check for consistent bracket style
-    int sameLine = 0;
-    int nextLine = 0;
-    
-    std::regex sameBraceRegex(R"(\)\s*\{)");
-    auto sameBraceBegin = std::sregex_iterator(code.begin(), code.end(), sameBraceRegex);
-    auto sameBraceEnd = std::sregex_iterator();
-    sameLine = std::distance(sameBraceBegin, sameBraceEnd);
-    
-    std::regex nextBraceRegex(R"(\)\s*$[\r\n]\s*\{)");
-    auto nextBraceBegin = std::sregex_iterator(code.begin(), code.end(), nextBraceRegex);
-    auto nextBraceEnd = std::sregex_iterator();
-    nextLine = std::distance(nextBraceBegin, nextBraceEnd);
-    
-    bool consistentBraceStyle = (sameLine == 0 || nextLine == 0) && (sameLine + nextLine > 0);
+    // Check for consistent bracket style. A ')' followed by '{' counts
+    // whether or not a line break separates them, so a fragment is
+    // considered consistent as soon as it opens any block this way.
+    int closeParenBraces = summary.closeParenBraces;
+    bool consistentBraceStyle = closeParenBraces > 0;
     
     // Calculate cleanness score
     double indentScore = hasInconsistentIndentation ? 0.0 : 1.0;
@@ -194,12 +152,15 @@ MetricEvaluation CleanessEvaluator::evaluate(const std::string& code) const {
     double whitespaceProportion = totalLines > 0 ? static_cast<double>(emptyLines) / totalLines : 0;
     double whitespaceScore = std::min(1.0, std::max(0.0, 1.0 - std::abs(whitespaceProportion - 0.2) / 0.2));
     
-    result.value = (indentScore * 0.5) + (braceScore * 0.3) + (whitespaceScore * 0.2);
-    result.value = std::min(1.0, std::max(0.0, result.value));
+    double value = (indentScore * 0.5) + (braceScore * 0.3) + (whitespaceScore * 0.2);
+    value = std::min(1.0, std::max(0.0, value));
     
-    result.rationale = "Cleanness score based on indentation consistency, brace style consistency, and whitespace usage.";
-    
-    return result;
+    counts = {indentScore, braceScore, whitespaceScore};
+    return value;
+}
+
+std::string CleanessEvaluator::formatRationale(const MetricCounts&) const {
+    return "Cleanness score based on indentation consistency, brace style consistency, and whitespace usage.";
 }
 
 std::string CleanessEvaluator::getDescription() const {
@@ -207,60 +168,45 @@ std::string CleanessEvaluator::getDescription() const {
 }
 
 // Comment Evaluator Implementation
-MetricEvaluation CommentEvaluator::evaluate(const std::string& code) const {
-    MetricEvaluation result;
-    result.type = MetricType::COMMENT;
-    
+double CommentEvaluator::score(const SourceSummary& summary, MetricCounts& counts) const {
     // Simple implementation: examine comment density and quality
     
-    // Count lines of code and lines of comments
-    std::istringstream stream(code);
-    std::string line;
-    int totalLines = 0;
+    // Count lines of comments and the words they contain
+    int totalLines = static_cast<int>(summary.lines.size());
     int commentLines = 0;
-    int codeLines = 0;
+    int commentWords = 0;
     bool inMultilineComment = false;
     
-    // Extract comment text for quality analysis
-    std::vector<std::string> comments;
-    
-    while (std::getline(stream, line)) {
-        totalLines++;
-        
+    for (const auto& line : summary.lines) {
         // Skip empty lines
-        if (line.empty() || line.find_first_not_of(" \t\r\n") == std::string::npos) {
+        if (line.blank) {
             continue;
         }
         
         // Check for multiline comments
-        size_t startComment = line.find("/*");
-        size_t endComment = line.find("*/");
+        size_t startComment = line.blockCommentOpen;
+        size_t endComment = line.blockCommentClose;
         
         if (inMultilineComment) {
             commentLines++;
-            comments.push_back(line);
+            commentWords += line.words;
             
             if (endComment != std::string::npos) {
                 inMultilineComment = false;
             }
         } else if (startComment != std::string::npos) {
             commentLines++;
-            comments.push_back(line.substr(startComment));
+            commentWords += line.wordsFromBlockComment;
             
             if (endComment != std::string::npos && endComment > startComment) {
                 inMultilineComment = false;
             } else {
                 inMultilineComment = true;
             }
-        } else {
-            // Check for single-line comments
-            size_t lineComment = line.find("//");
-            if (lineComment != std::string::npos) {
-                commentLines++;
-                comments.push_back(line.substr(lineComment + 2));
-            } else {
-                codeLines++;
-            }
+        } else if (line.lineComment != std::string::npos) {
+            // Single-line comment
+            commentLines++;
+            commentWords += line.wordsAfterLineComment;
         }
     }
     
@@ -268,18 +214,7 @@ MetricEvaluation CommentEvaluator::evaluate(const std::string& code) const {
     double commentDensity = totalLines > 0 ? static_cast<double>(commentLines) / totalLines : 0;
     
     // Simple quality analysis - longer comments are generally better
-    double avgCommentLength = 0;
-    int commentWords = 0;
-    for (const auto& comment : comments) {
-        // Count words (simplified)
-        std::istringstream wordStream(comment);
-        std::string word;
-        while (wordStream >> word) {
-            commentWords++;
-        }
-    }
-    
-    avgCommentLength = comments.size() > 0 ? static_cast<double>(commentWords) / comments.size() : 0;
+    double avgCommentLength = commentLines > 0 ? static_cast<double>(commentWords) / commentLines : 0;
     
     // Ideal comment density around 25-30%
     double densityScore = std::max(0.0, 1.0 - std::abs(commentDensity - 0.3) / 0.3);
@@ -288,13 +223,16 @@ MetricEvaluation CommentEvaluator::evaluate(const std::string& code) const {
     double lengthScore = std::min(1.0, avgCommentLength / 8.0);
     
     // Calculate overall comment score
-    result.value = (densityScore * 0.6) + (lengthScore * 0.4);
-    result.value = std::min(1.0, std::max(0.0, result.value));
+    double value = (densityScore * 0.6) + (lengthScore * 0.4);
+    value = std::min(1.0, std::max(0.0, value));
     
-    result.rationale = "Comment score based on density (" + std::to_string(commentDensity * 100) + 
-                       "%) and average length (" + std::to_string(avgCommentLength) + " words).";
-    
-    return result;
+    counts = {commentDensity, avgCommentLength, static_cast<double>(commentLines)};
+    return value;
+}
+
+std::string CommentEvaluator::formatRationale(const MetricCounts& counts) const {
+    return "Comment score based on density (" + std::to_string(counts[0] * 100) + 
+           "%) and average length (" + std::to_string(counts[1]) + " words).";
 }
 
 std::string CommentEvaluator::getDescription() const {
@@ -302,44 +240,30 @@ std::string CommentEvaluator::getDescription() const {
 }
 
 // Creditability Evaluator Implementation
-MetricEvaluation CreditabilityEvaluator::evaluate(const std::string& code) const {
-    MetricEvaluation result;
-    result.type = MetricType::CREDITABILITY;
-    
+double CreditabilityEvaluator::score(const SourceSummary& summary, MetricCounts& counts) const {
     // Simple implementation: look for evidence of testing, documentation, and references
-    
-    // Look for testing indicators
-    std::regex testRegex(R"(\b(test|assert|expect|should|mock|stub|spy)\b)");
-    auto testBegin = std::sregex_iterator(code.begin(), code.end(), testRegex);
-    auto testEnd = std::sregex_iterator();
-    int testIndicators = std::distance(testBegin, testEnd);
-    
-    // Look for documentation indicators
-    std::regex docRegex(R"(\@(param|return|throws?|see|link|since|version|author|deprecated))");
-    auto docBegin = std::sregex_iterator(code.begin(), code.end(), docRegex);
-    auto docEnd = std::sregex_iterator();
-    int docIndicators = std::distance(docBegin, docEnd);
-    
-    // Look for references to external resources
-    std::regex refRegex(R"((http|https)://[^\s"'<>]+|(RFC|IEEE|ISO)[- ][0-9]+)");
-    auto refBegin = std::sregex_iterator(code.begin(), code.end(), refRegex);
-    auto refEnd = std::sregex_iterator();
-    int refIndicators = std::distance(refBegin, refEnd);
+    int testIndicators = summary.testIndicators;
+    int docIndicators = summary.docTags;
+    int refIndicators = summary.references;
     
     // Calculate creditability score
     double testScore = std::min(1.0, testIndicators / 5.0);
     double docScore = std::min(1.0, docIndicators / 10.0);
     double refScore = std::min(1.0, refIndicators / 2.0);
     
-    result.value = (testScore * 0.4) + (docScore * 0.4) + (refScore * 0.2);
-    result.value = std::min(1.0, std::max(0.0, result.value));
-    
-    result.rationale = "Creditability score based on evidence of testing (" + 
-                       std::to_string(testIndicators) + "), documentation (" + 
-                       std::to_string(docIndicators) + "), and references (" + 
-                       std::to_string(refIndicators) + ").";
+    double value = (testScore * 0.4) + (docScore * 0.4) + (refScore * 0.2);
+    value = std::min(1.0, std::max(0.0, value));
     
-    return result;
+    counts = {static_cast<double>(testIndicators), static_cast<double>(docIndicators),
+              static_cast<double>(refIndicators)};
+    return value;
+}
+
+std::string CreditabilityEvaluator::formatRationale(const MetricCounts& counts) const {
+    return "Creditability score based on evidence of testing (" + 
+           std::to_string(static_cast<int>(counts[0])) + "), documentation (" + 
+           std::to_string(static_cast<int>(counts[1])) + "), and references (" + 
+           std::to_string(static_cast<int>(counts[2])) + ").";
 }
 
 std::string CreditabilityEvaluator::getDescription() const {
@@ -347,44 +271,30 @@ std::string CreditabilityEvaluator::getDescription() const {
 }
 
 // Novelty Evaluator Implementation
-MetricEvaluation NoveltyEvaluator::evaluate(const std::string& code) const {
-    MetricEvaluation result;
-    result.type = MetricType::NOVELTY;
-    
+double NoveltyEvaluator::score(const SourceSummary& summary, MetricCounts& counts) const {
     // Simple implementation: look for unusual patterns, advanced features, and creativity indicators
-    
-    // Look for advanced language features
-    std::regex advancedRegex(R"(\b(template|constexpr|decltype|concept|requires|noexcept|auto|lambda|fold|structured\s+binding)\b)");
-    auto advancedBegin = std::sregex_iterator(code.begin(), code.end(), advancedRegex);
-    auto advancedEnd = std::sregex_iterator();
-    int advancedFeatures = std::distance(advancedBegin, advancedEnd);
-    
-    // Look for design pattern indicators
-    std::regex patternRegex(R"(\b(Factory|Builder|Singleton|Adapter|Bridge|Composite|Decorator|Facade|Proxy|Observer|Strategy|Command|State|Visitor|Interpreter|Iterator|Mediator|Memento|Prototype)\b)");
-    auto patternBegin = std::sregex_iterator(code.begin(), code.end(), patternRegex);
-    auto patternEnd = std::sregex_iterator();
-    int patternIndicators = std::distance(patternBegin, patternEnd);
-    
-    // Look for algorithm complexity comments
-    std::regex complexityRegex(R"(O\([^\)]*\))");
-    auto complexityBegin = std::sregex_iterator(code.begin(), code.end(), complexityRegex);
-    auto complexityEnd = std::sregex_iterator();
-    int complexityIndicators = std::distance(complexityBegin, complexityEnd);
+    int advancedFeatures = summary.advancedFeatures;
+    int patternIndicators = summary.designPatterns;
+    int complexityIndicators = summary.complexityAnnotations;
     
     // Calculate novelty score
     double advancedScore = std::min(1.0, advancedFeatures / 3.0);
     double patternScore = std::min(1.0, patternIndicators / 2.0);
     double complexityScore = std::min(1.0, complexityIndicators / 1.0);
     
-    result.value = (advancedScore * 0.4) + (patternScore * 0.4) + (complexityScore * 0.2);
-    result.value = std::min(1.0, std::max(0.0, result.value));
-    
-    result.rationale = "Novelty score based on advanced language features (" + 
-                       std::to_string(advancedFeatures) + "), design patterns (" + 
-                       std::to_string(patternIndicators) + "), and algorithm analysis (" + 
-                       std::to_string(complexityIndicators) + ").";
+    double value = (advancedScore * 0.4) + (patternScore * 0.4) + (complexityScore * 0.2);
+    value = std::min(1.0, std::max(0.0, value));
     
-    return result;
+    counts = {static_cast<double>(advancedFeatures), static_cast<double>(patternIndicators),
+              static_cast<double>(complexityIndicators)};
+    return value;
+}
+
+std::string NoveltyEvaluator::formatRationale(const MetricCounts& counts) const {
+    return "Novelty score based on advanced language features (" + 
+           std::to_string(static_cast<int>(counts[0])) + "), design patterns (" + 
+           std::to_string(static_cast<int>(counts[1])) + "), and algorithm analysis (" + 
+           std::to_string(static_cast<int>(counts[2])) + ").";
 }
 
 std::string NoveltyEvaluator::getDescription() const {
@@ -427,29 +337,129 @@ MetricsEvaluator::MetricsEvaluator() {
     m_evaluators = MetricEvaluatorFactory::createAll();
 }
 
-std::vector<MetricEvaluation> MetricsEvaluator::evaluateAll(const std::string& code) const {
+std::vector<MetricEvaluation> MetricsEvaluator::evaluateAll(std::string_view code) const {
     std::vector<MetricEvaluation> results;
+    results.reserve(m_evaluators.size());
+    
+    // Scan the fragment once and let every evaluator work from the summary
+    const SourceSummary summary = scanSource(code);
+    for (const auto& evaluator : m_evaluators) {
+        results.push_back(evaluator->evaluate(summary));
+    }
     
+    return results;
+}
+
+std::pmr::vector<MetricEvaluation> MetricsEvaluator::evaluateAll(std::string_view code,
+                                                                 std::pmr::memory_resource* resource) const {
+    std::pmr::vector<MetricEvaluation> results(resource);
+    results.reserve(m_evaluators.size());
+    
+    const SourceSummary summary = scanSource(code);
     for (const auto& evaluator : m_evaluators) {
-        results.push_back(evaluator->evaluate(code));
+        results.push_back(evaluator->evaluate(summary));
     }
     
     return results;
 }
 
-double MetricsEvaluator::calculateValue(const std::string& code) const {
-    auto evaluations = evaluateAll(code);
+std::vector<MetricEvaluation> MetricsEvaluator::evaluateBatch(
+    const std::vector<std::string_view>& fragments,
+    ThreadPool& pool
+) const {
+    const std::size_t metricCount = m_evaluators.size();
+    std::vector<MetricEvaluation> results(fragments.size() * metricCount);
+    
+    // Each fragment writes its own row, so no synchronization is needed
+    pool.parallelFor(fragments.size(), [&](std::size_t fragment) {
+        const SourceSummary summary = scanSource(fragments[fragment]);
+        for (std::size_t metric = 0; metric < metricCount; metric++) {
+            results[fragment * metricCount + metric] = m_evaluators[metric]->evaluate(summary);
+        }
+    });
+    
+    return results;
+}
+
+std::vector<MetricEvaluation> MetricsEvaluator::evaluateBatch(
+    const std::vector<std::string_view>& fragments,
+    std::size_t threadCount
+) const {
+    ThreadPool pool(threadCount);
+    return evaluateBatch(fragments, pool);
+}
+
+std::vector<MetricScores> MetricsEvaluator::evaluateBatchScores(
+    const std::vector<std::string_view>& fragments,
+    ThreadPool& pool
+) const {
+    std::vector<MetricScores> results(fragments.size());
+    
+    pool.parallelFor(fragments.size(), [&](std::size_t fragment) {
+        const SourceSummary summary = scanSource(fragments[fragment]);
+        for (const auto& evaluator : m_evaluators) {
+            MetricCounts counts{};
+            double value;
+            {
+                CCSL_PROBE(probe, evaluateProbe(evaluator->getType()), summary.byteCount);
+                value = evaluator->score(summary, counts);
+            }
+            results[fragment].set(evaluator->getType(), value, counts);
+        }
+    });
+    
+    return results;
+}
+
+MetricScores MetricsEvaluator::evaluateScores(std::string_view code) const {
+    MetricScores scores;
+    
+    const SourceSummary summary = scanSource(code);
+    for (const auto& evaluator : m_evaluators) {
+        MetricCounts counts{};
+        double value;
+        {
+            CCSL_PROBE(probe, evaluateProbe(evaluator->getType()), summary.byteCount);
+            value = evaluator->score(summary, counts);
+        }
+        scores.set(evaluator->getType(), value, counts);
+    }
+    
+    return scores;
+}
+
+std::string MetricsEvaluator::formatRationale(const MetricScores& scores, MetricType type) const {
+    if (!scores.has(type)) {
+        return "";
+    }
     
-    if (evaluations.empty()) {
-        return 0.0;
+    for (const auto& evaluator : m_evaluators) {
+        if (evaluator->getType() == type) {
+            return evaluator->formatRationale(scores.counts[metricIndex(type)]);
+        }
     }
     
-    double sum = 0.0;
-    for (const auto& eval : evaluations) {
-        sum += eval.value;
+    return "";
+}
+
+std::vector<MetricEvaluation> MetricsEvaluator::toEvaluations(const MetricScores& scores) const {
+    std::vector<MetricEvaluation> evaluations;
+    evaluations.reserve(scores.size());
+    
+    for (const auto& evaluator : m_evaluators) {
+        const MetricType type = evaluator->getType();
+        if (scores.has(type)) {
+            evaluations.push_back({type, scores.get(type),
+                                   evaluator->formatRationale(scores.counts[metricIndex(type)])});
+        }
     }
     
-    return sum / evaluations.size();
+    return evaluations;
+}
+
+double MetricsEvaluator::calculateValue(std::string_view code) const {
+    // Only the values are needed, so skip formatting rationales
+    return evaluateScores(code).mean();
 }
 
 } // namespace ccsl
\ No newline at end of file
@@ -5,18 +5,47 @@
  */
 
 #include <ccsl/payment.hpp>
+#include <ccsl/payout.hpp>
 #include <ccsl/utility.hpp>
+#include <ccsl/instrumentation.hpp>
 #include <iostream>
 #include <algorithm>
 #include <chrono>
-#include <thread>
 #include <stdexcept>
+#include <unordered_set>
 
 namespace ccsl {
 
+namespace {
+
+// Source wallet of subscription payments until they are funded by a real wallet
+const char* const kSubscriptionSourceWallet = "1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa";
+
+// Reported for every bitcoin amount Satoshis::tryFromBitcoins() rejects
+const char* const kInvalidAmount = "Payment amount must be a positive number of satoshis within range";
+
+} // namespace
+
+PaymentOutput::PaymentOutput(std::string destinationWallet, Satoshis amount, std::string contributionId)
+    : destinationWallet(std::move(destinationWallet)),
+      amount(amount),
+      contributionId(std::move(contributionId))
+{
+}
+
+PaymentOutput::PaymentOutput(std::string destinationWallet, double amount, std::string contributionId)
+    : PaymentOutput(std::move(destinationWallet), Satoshis::tryFromBitcoins(amount).value_or(Satoshis(0)),
+                    std::move(contributionId))
+{
+}
+
 // BitcoinPaymentManager Implementation
-BitcoinPaymentManager::BitcoinPaymentManager(const std::string& apiKey)
-    : m_apiKey(apiKey)
+BitcoinPaymentManager::BitcoinPaymentManager(
+    const std::string& apiKey,
+    std::shared_ptr<PaymentExecutor> executor
+) : m_apiKey(apiKey),
+    m_transactions(std::make_shared<TransactionStore>()),
+    m_executor(executor ? std::move(executor) : PaymentExecutor::getDefault())
 {
     if (apiKey.empty()) {
         throw std::invalid_argument("API key cannot be empty");
@@ -36,6 +65,22 @@ std::future<std::string> BitcoinPaymentManager::sendPayment(
     const std::string& contributionId,
     PaymentVerificationCallback callback
 ) {
+    const std::optional<Satoshis> satoshis = Satoshis::tryFromBitcoins(amount);
+    if (!satoshis) {
+        throw std::invalid_argument(kInvalidAmount);
+    }
+    return sendPayment(sourceWallet, destinationWallet, *satoshis, contributionId, std::move(callback));
+}
+
+std::future<std::string> BitcoinPaymentManager::sendPayment(
+    const std::string& sourceWallet,
+    const std::string& destinationWallet,
+    Satoshis amount,
+    const std::string& contributionId,
+    PaymentVerificationCallback callback
+) {
+    CCSL_PROBE(probe, Probe::SEND_PAYMENT, 0);
+    
     // Validate input parameters
     if (!validateBitcoinAddress(sourceWallet)) {
         throw std::invalid_argument("Invalid source wallet address");
@@ -45,20 +90,20 @@ std::future<std::string> BitcoinPaymentManager::sendPayment(
         throw std::invalid_argument("Invalid destination wallet address");
     }
     
-    if (amount <= 0) {
+    if (amount <= Satoshis(0)) {
         throw std::invalid_argument("Payment amount must be greater than zero");
     }
     
     // Create a promise to return the transaction ID asynchronously
-    std::promise<std::string> promise;
-    std::future<std::string> future = promise.get_future();
+    auto promise = std::make_shared<std::promise<std::string>>();
+    std::future<std::string> future = promise->get_future();
     
     // In a real implementation, this would communicate with a Bitcoin payment API
     // For now, we'll simulate the payment process
     
     // Create a transaction record
     PaymentTransaction transaction;
-    transaction.transactionId = generateUUID();
+    transaction.transactionId = generateUUID(UUIDVersion::V7);
     transaction.sourceWallet = sourceWallet;
     transaction.destinationWallet = destinationWallet;
     transaction.amount = amount;
@@ -67,67 +112,161 @@ std::future<std::string> BitcoinPaymentManager::sendPayment(
     transaction.verified = false;
     
     // Store the transaction
-    m_transactions.push_back(transaction);
+    m_transactions->insert(transaction);
     
-    // Start a background thread to simulate transaction verification
-    std::thread([this, transaction, callback, promise = std::move(promise)]() mutable {
-        // Simulate network delay
-        std::this_thread::sleep_for(std::chrono::seconds(2));
-        
+    // Schedule the verification once the simulated network delay has
+    // passed; it holds the store rather than this, which may be gone by then
+    // The lambda owns the only other copy of the transaction and takes over
+    // the callback and promise
+    m_executor->schedule(m_verificationDelay, [store = m_transactions, transaction = std::move(transaction),
+                                               callback = std::move(callback), promise = std::move(promise)]() mutable {
         // Simulate verification (always succeeds in this implementation)
         bool verified = true;
         
         // Update the transaction status
-        auto it = std::find_if(m_transactions.begin(), m_transactions.end(),
-                              [&transaction](const PaymentTransaction& t) {
-                                  return t.transactionId == transaction.transactionId;
-                              });
-        
-        if (it != m_transactions.end()) {
-            it->verified = verified;
-        }
+        store->setVerified(transaction.transactionId, verified);
+        transaction.verified = verified;
         
-        // Call the callback if provided
-        if (callback) {
-            callback(transaction, verified);
+        // Call the callback if provided, then fulfill the promise with the
+        // transaction ID; a throwing callback fails the future instead
+        try {
+            if (callback) {
+                callback(transaction, verified);
+            }
+            promise->set_value(transaction.transactionId);
+        } catch (...) {
+            promise->set_exception(std::current_exception());
         }
-        
-        // Fulfill the promise with the transaction ID
-        promise.set_value(transaction.transactionId);
-    }).detach();
+    });
     
     return future;
 }
 
-bool BitcoinPaymentManager::verifyPayment(const std::string& transactionId) {
-    // Find the transaction
-    auto it = std::find_if(m_transactions.begin(), m_transactions.end(),
-                          [&transactionId](const PaymentTransaction& t) {
-                              return t.transactionId == transactionId;
-                          });
+std::future<PaymentBatchResult> BitcoinPaymentManager::sendPaymentBatch(
+    const std::string& sourceWallet,
+    const std::vector<PaymentOutput>& outputs,
+    PaymentVerificationCallback callback
+) {
+    return submitPaymentBatch(sourceWallet, outputs, std::move(callback)).result;
+}
+
+PaymentBatchSubmission BitcoinPaymentManager::submitPaymentBatch(
+    const std::string& sourceWallet,
+    const std::vector<PaymentOutput>& outputs,
+    PaymentVerificationCallback callback
+) {
+    // Validate input parameters
+    if (!validateBitcoinAddress(sourceWallet)) {
+        throw std::invalid_argument("Invalid source wallet address");
+    }
     
-    // Return verification status
-    if (it != m_transactions.end()) {
-        return it->verified;
+    PaymentBatchResult result;
+    result.transactionId = generateUUID(UUIDVersion::V7);
+    result.outputs.resize(outputs.size());
+    
+    // Record every valid output under the shared transaction ID
+    const auto timestamp = std::chrono::system_clock::now();
+    std::vector<PaymentTransaction> included;
+    std::vector<std::size_t> includedIndices;
+    included.reserve(outputs.size());
+    includedIndices.reserve(outputs.size());
+    
+    for (std::size_t i = 0; i < outputs.size(); i++) {
+        const PaymentOutput& output = outputs[i];
+        PaymentOutputResult& status = result.outputs[i];
+        status.state = PaymentOutputState::REJECTED;
+        
+        if (!validateBitcoinAddress(output.destinationWallet)) {
+            status.error = "Invalid destination wallet address";
+            continue;
+        }
+        
+        if (output.amount <= Satoshis(0)) {
+            status.error = kInvalidAmount;
+            continue;
+        }
+        
+        PaymentTransaction transaction;
+        transaction.transactionId = result.transactionId + ":" + std::to_string(i);
+        transaction.sourceWallet = sourceWallet;
+        transaction.destinationWallet = output.destinationWallet;
+        transaction.amount = output.amount;
+        transaction.timestamp = timestamp;
+        transaction.contributionId = output.contributionId;
+        transaction.verified = false;
+        
+        status.outputId = transaction.transactionId;
+        status.state = PaymentOutputState::UNVERIFIED;
+        included.push_back(std::move(transaction));
+        includedIndices.push_back(i);
+    }
+    
+    if (included.empty()) {
+        throw std::invalid_argument("Payment batch contains no valid outputs");
     }
     
-    // Transaction not found
-    return false;
+    for (const auto& transaction : included) {
+        m_transactions->insert(transaction);
+    }
+    
+    auto promise = std::make_shared<std::promise<PaymentBatchResult>>();
+    PaymentBatchSubmission submission;
+    submission.transactionId = result.transactionId;
+    submission.outputs = result.outputs;
+    submission.result = promise->get_future();
+    
+    // The whole transaction is confirmed by a single verification
+    m_executor->schedule(m_verificationDelay, [store = m_transactions, included = std::move(included),
+                                               includedIndices = std::move(includedIndices),
+                                               result = std::move(result), callback = std::move(callback),
+                                               promise = std::move(promise)]() mutable {
+        // Simulate verification (always succeeds in this implementation)
+        bool verified = true;
+        
+        for (std::size_t i = 0; i < included.size(); i++) {
+            store->setVerified(included[i].transactionId, verified);
+            included[i].verified = verified;
+            result.outputs[includedIndices[i]].state =
+                verified ? PaymentOutputState::VERIFIED : PaymentOutputState::UNVERIFIED;
+        }
+        
+        // Report every output before fulfilling the promise; a throwing
+        // callback fails the future instead
+        try {
+            if (callback) {
+                for (const auto& transaction : included) {
+                    callback(transaction, verified);
+                }
+            }
+            promise->set_value(std::move(result));
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    
+    return submission;
+}
+
+bool BitcoinPaymentManager::verifyPayment(const std::string& transactionId) {
+    // Unknown transactions are reported as unverified
+    return m_transactions->isVerified(transactionId);
 }
 
 std::vector<PaymentTransaction> BitcoinPaymentManager::getTransactions() const {
-    return m_transactions;
+    return m_transactions->snapshot();
 }
 
 std::vector<PaymentTransaction> BitcoinPaymentManager::getTransactionsForContribution(const std::string& contributionId) const {
-    std::vector<PaymentTransaction> result;
-    
-    std::copy_if(m_transactions.begin(), m_transactions.end(), std::back_inserter(result),
-                [&contributionId](const PaymentTransaction& t) {
-                    return t.contributionId == contributionId;
-                });
-    
-    return result;
+    return m_transactions->findByContribution(contributionId);
+}
+
+void BitcoinPaymentManager::forEachTransaction(const TransactionVisitor& visit) const {
+    m_transactions->forEach(visit);
+}
+
+void BitcoinPaymentManager::forEachTransactionForContribution(const std::string& contributionId,
+                                                              const TransactionVisitor& visit) const {
+    m_transactions->forEachByContribution(contributionId, visit);
 }
 
 // PaymentSubscription Implementation
@@ -157,6 +296,15 @@ PaymentSubscription::PaymentSubscription(
 }
 
 bool PaymentSubscription::processPayment(BitcoinPaymentManager& paymentManager, double amount) {
+    const std::optional<Satoshis> satoshis = Satoshis::tryFromBitcoins(amount);
+    if (!satoshis) {
+        std::cerr << "Error processing payment: " << kInvalidAmount << std::endl;
+        return false;
+    }
+    return processPayment(paymentManager, *satoshis);
+}
+
+bool PaymentSubscription::processPayment(BitcoinPaymentManager& paymentManager, Satoshis amount) {
     // In a real implementation, this would be more complex
     // For now, we'll just simulate the payment
     
@@ -172,8 +320,7 @@ bool PaymentSubscription::processPayment(BitcoinPaymentManager& paymentManager,
         };
         
         // Send the payment (using a placeholder source wallet)
-        std::string sourceWallet = "1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa"; // placeholder
-        paymentManager.sendPayment(sourceWallet, m_walletAddress, amount, m_contributorId, callback);
+        paymentManager.sendPayment(kSubscriptionSourceWallet, m_walletAddress, amount, getPaymentPeriodId(), callback);
         
         // Update the next payment date
         m_nextPaymentDate = std::chrono::system_clock::now() + std::chrono::hours(24 * m_subscriptionPeriod);
@@ -185,6 +332,11 @@ bool PaymentSubscription::processPayment(BitcoinPaymentManager& paymentManager,
     }
 }
 
+std::string PaymentSubscription::getPaymentPeriodId() const {
+    const auto due = std::chrono::duration_cast<std::chrono::seconds>(m_nextPaymentDate.time_since_epoch());
+    return m_contributorId.str() + ":" + std::to_string(due.count());
+}
+
 bool PaymentSubscription::isPaymentDue() const {
     // Check if the current time is past the next payment date
     return std::chrono::system_clock::now() >= m_nextPaymentDate;
@@ -197,52 +349,182 @@ RecurringPaymentManager::RecurringPaymentManager(BitcoinPaymentManager& paymentM
     // Nothing else to initialize
 }
 
+namespace {
+
+// Orders the schedule as a min-heap on the due date
+struct DueLater {
+    template<typename Entry>
+    bool operator()(const Entry& a, const Entry& b) const { return a.due > b.due; }
+};
+
+} // namespace
+
 void RecurringPaymentManager::addSubscription(const PaymentSubscription& subscription) {
+    addSubscription(PaymentSubscription(subscription));
+}
+
+void RecurringPaymentManager::addSubscription(PaymentSubscription&& subscription) {
     // Check if a subscription for this contributor already exists
-    auto it = std::find_if(m_subscriptions.begin(), m_subscriptions.end(),
-                          [&subscription](const PaymentSubscription& s) {
-                              return s.getContributorId() == subscription.getContributorId();
-                          });
+    auto it = m_index.find(subscription.getContributorId());
+    std::size_t position;
     
-    if (it != m_subscriptions.end()) {
+    if (it != m_index.end()) {
         // Replace the existing subscription
-        *it = subscription;
+        position = it->second.position;
+        m_subscriptions[position] = std::move(subscription);
     } else {
         // Add a new subscription
-        m_subscriptions.push_back(subscription);
+        position = m_subscriptions.size();
+        m_index.emplace(subscription.getContributorId(), Slot{position, 0});
+        m_subscriptions.push_back(std::move(subscription));
     }
+    
+    const PaymentSubscription& added = m_subscriptions[position];
+    schedule(added.getContributorId(), added.getNextPaymentDate());
 }
 
 bool RecurringPaymentManager::removeSubscription(const std::string& contributorId) {
-    auto it = std::find_if(m_subscriptions.begin(), m_subscriptions.end(),
-                          [&contributorId](const PaymentSubscription& s) {
-                              return s.getContributorId() == contributorId;
-                          });
+    auto it = m_index.find(contributorId);
+    if (it == m_index.end()) {
+        return false;
+    }
     
-    if (it != m_subscriptions.end()) {
-        m_subscriptions.erase(it);
-        return true;
+    // Move the last subscription into the freed position
+    const std::size_t position = it->second.position;
+    m_index.erase(it);
+    if (position + 1 != m_subscriptions.size()) {
+        m_subscriptions[position] = std::move(m_subscriptions.back());
+        m_index[m_subscriptions[position].getContributorId()].position = position;
     }
+    m_subscriptions.pop_back();
     
-    return false;
+    trimSchedule();
+    return true;
 }
 
 int RecurringPaymentManager::processDuePayments() {
-    int count = 0;
-    
-    for (auto& subscription : m_subscriptions) {
-        if (subscription.isPaymentDue()) {
-            // In a real implementation, the payment amount would be calculated
-            // based on the contribution value
-            double amount = 0.001; // Placeholder: 0.001 BTC
-            
-            if (subscription.processPayment(m_paymentManager, amount)) {
-                count++;
+    return processDuePayments(std::chrono::system_clock::now());
+}
+
+void RecurringPaymentManager::setPayoutEngine(const PayoutEngine* engine, Satoshis budget) {
+    if (budget < Satoshis(0)) {
+        throw std::invalid_argument("Payout budget cannot be negative");
+    }
+    m_payoutEngine = engine;
+    m_payoutBudget = budget;
+}
+
+int RecurringPaymentManager::processDuePayments(std::chrono::system_clock::time_point now) {
+    std::vector<std::string> processed;
+    std::vector<const PaymentSubscription*> due;
+    
+    while (!m_schedule.empty() && m_schedule.front().due <= now) {
+        std::pop_heap(m_schedule.begin(), m_schedule.end(), DueLater());
+        ScheduleEntry entry = std::move(m_schedule.back());
+        m_schedule.pop_back();
+        
+        if (isStale(entry)) {
+            continue;
+        }
+        
+        // Reschedule after the loop so a subscription is paid at most once
+        // per tick, and a failed payment is retried on the next tick
+        due.push_back(&m_subscriptions[m_index.at(entry.contributorId).position]);
+        processed.push_back(std::move(entry.contributorId));
+    }
+    
+    m_skippedPayments = 0;
+    if (due.empty()) {
+        return 0;
+    }
+    
+    // Every amount is computed in one pass, then sent in one transaction;
+    // each output is recorded under the ID of the period it pays for
+    std::vector<PaymentOutput> outputs;
+    std::vector<const std::string*> payees;
+    outputs.reserve(due.size());
+    payees.reserve(due.size());
+    std::unordered_set<std::string> skipped;
+    if (m_payoutEngine) {
+        const std::vector<Payout> payouts = m_payoutEngine->computePayouts(due, m_payoutBudget);
+        for (std::size_t i = 0; i < payouts.size(); i++) {
+            if (payouts[i].amount > Satoshis(0)) {
+                outputs.emplace_back(payouts[i].walletAddress, payouts[i].amount, due[i]->getPaymentPeriodId());
+                payees.push_back(&due[i]->getContributorId());
+            } else {
+                skipped.insert(payouts[i].contributorId);
+            }
+        }
+    } else {
+        for (const PaymentSubscription* subscription : due) {
+            outputs.emplace_back(subscription->getWalletAddress(), kFlatRecurringPayment,
+                                 subscription->getPaymentPeriodId());
+            payees.push_back(&subscription->getContributorId());
+        }
+    }
+    m_skippedPayments = skipped.size();
+    
+    // Only outputs the batch accepted count as paid
+    std::unordered_set<std::string> paid;
+    if (!outputs.empty()) {
+        try {
+            PaymentBatchSubmission submission = m_paymentManager.submitPaymentBatch(kSubscriptionSourceWallet, outputs);
+            for (std::size_t i = 0; i < outputs.size(); i++) {
+                if (submission.outputs[i].state == PaymentOutputState::REJECTED) {
+                    std::cerr << "Error processing payment to " << *payees[i] << ": "
+                              << submission.outputs[i].error << std::endl;
+                } else {
+                    paid.insert(*payees[i]);
+                }
             }
+        } catch (const std::exception& e) {
+            std::cerr << "Error processing payments: " << e.what() << std::endl;
         }
     }
     
-    return count;
+    for (const auto& contributorId : processed) {
+        PaymentSubscription& subscription = m_subscriptions[m_index.at(contributorId).position];
+        if (paid.count(contributorId) || skipped.count(contributorId)) {
+            subscription.setNextPaymentDate(now + std::chrono::hours(24 * subscription.getSubscriptionPeriod()));
+        }
+        schedule(contributorId, subscription.getNextPaymentDate());
+    }
+    
+    return static_cast<int>(paid.size());
+}
+
+const PaymentSubscription* RecurringPaymentManager::findSubscription(const std::string& contributorId) const {
+    auto it = m_index.find(contributorId);
+    return it != m_index.end() ? &m_subscriptions[it->second.position] : nullptr;
+}
+
+void RecurringPaymentManager::schedule(const std::string& contributorId,
+                                       std::chrono::system_clock::time_point due) {
+    // A new generation invalidates any entry already scheduled for the contributor
+    Slot& slot = m_index.at(contributorId);
+    slot.generation = ++m_nextGeneration;
+    
+    m_schedule.push_back(ScheduleEntry{due, contributorId, slot.generation});
+    std::push_heap(m_schedule.begin(), m_schedule.end(), DueLater());
+    trimSchedule();
+}
+
+bool RecurringPaymentManager::isStale(const ScheduleEntry& entry) const {
+    auto it = m_index.find(entry.contributorId);
+    return it == m_index.end() || it->second.generation != entry.generation;
+}
+
+void RecurringPaymentManager::trimSchedule() {
+    // Stale entries are only discarded lazily, so rebuild the heap once they
+    // outnumber the live ones; this keeps the heap O(n) at amortized O(1) cost
+    if (m_schedule.size() <= 2 * m_subscriptions.size() + 16) {
+        return;
+    }
+    
+    m_schedule.erase(std::remove_if(m_schedule.begin(), m_schedule.end(),
+                                    [this](const ScheduleEntry& entry) { return isStale(entry); }),
+                     m_schedule.end());
+    std::make_heap(m_schedule.begin(), m_schedule.end(), DueLater());
 }
 
 } // namespace ccsl
\ No newline at end of file
@@ -0,0 +1,140 @@
+/**
+ * @file payment_executor.cpp
+ * @brief Implementation of the payment verification executor
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/payment_executor.hpp>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+
+namespace ccsl {
+
+namespace {
+
+std::size_t checkedWorkerCount(std::size_t workerCount) {
+    if (workerCount == 0) {
+        throw std::invalid_argument("Worker count must be greater than zero");
+    }
+    return workerCount;
+}
+
+} // namespace
+
+PaymentExecutor::PaymentExecutor(std::size_t workerCount, std::size_t capacity)
+    : m_capacity(capacity),
+      m_workers(checkedWorkerCount(workerCount))
+{
+    if (capacity == 0) {
+        throw std::invalid_argument("Capacity must be greater than zero");
+    }
+
+    m_timerThread = std::thread(&PaymentExecutor::timerLoop, this);
+}
+
+PaymentExecutor::~PaymentExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_timerCondition.notify_one();
+    m_timerThread.join();
+
+    // m_workers is destroyed next and finishes the tasks still queued on it
+}
+
+void PaymentExecutor::schedule(Clock::duration delay, std::function<void()> task) {
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_spaceCondition.wait(lock, [this]() { return m_pending < m_capacity; });
+        m_pending++;
+    }
+    enqueue(delay, std::move(task));
+}
+
+bool PaymentExecutor::trySchedule(Clock::duration delay, std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_pending >= m_capacity) {
+            return false;
+        }
+        m_pending++;
+    }
+    enqueue(delay, std::move(task));
+    return true;
+}
+
+std::size_t PaymentExecutor::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pending;
+}
+
+std::shared_ptr<PaymentExecutor> PaymentExecutor::getDefault() {
+    static std::shared_ptr<PaymentExecutor> executor = std::make_shared<PaymentExecutor>();
+    return executor;
+}
+
+void PaymentExecutor::enqueue(Clock::duration delay, std::function<void()> task) {
+    bool earliest;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_timers.push(Timer{Clock::now() + delay, m_sequence++, std::move(task)});
+        earliest = m_timers.top().sequence == m_sequence - 1;
+    }
+
+    // Only a new earliest deadline changes how long the timer thread sleeps
+    if (earliest) {
+        m_timerCondition.notify_one();
+    }
+}
+
+void PaymentExecutor::dispatch(std::function<void()> task) {
+    m_workers.submit([this, task = std::move(task)]() {
+        try {
+            task();
+        } catch (const std::exception& e) {
+            std::cerr << "Payment task failed: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "Payment task failed" << std::endl;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending--;
+        }
+        m_spaceCondition.notify_one();
+    });
+}
+
+void PaymentExecutor::timerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true) {
+        if (m_timers.empty()) {
+            if (m_stopping) {
+                return;
+            }
+            m_timerCondition.wait(lock);
+            continue;
+        }
+
+        // On shutdown every remaining task is treated as due
+        // Copy the deadline: pushes while waiting may reallocate the heap
+        const Clock::time_point due = m_timers.top().due;
+        if (!m_stopping && due > Clock::now()) {
+            m_timerCondition.wait_until(lock, due);
+            continue;
+        }
+
+        // priority_queue::top() is const, so move the task out before popping
+        std::function<void()> task = std::move(const_cast<Timer&>(m_timers.top()).task);
+        m_timers.pop();
+
+        lock.unlock();
+        dispatch(std::move(task));
+        lock.lock();
+    }
+}
+
+} // namespace ccsl
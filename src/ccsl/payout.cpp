@@ -0,0 +1,94 @@
+/**
+ * @file payout.cpp
+ * @brief Implementation of the payout engine
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/payout.hpp>
+#include <ccsl/thread_pool.hpp>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace ccsl {
+
+namespace {
+
+// Recipients per parallel task; small payouts are not worth splitting
+constexpr std::size_t kPayoutChunk = 4096;
+
+const PaymentSubscription& recipientAt(const std::vector<PaymentSubscription>& recipients, std::size_t i) {
+    return recipients[i];
+}
+
+const PaymentSubscription& recipientAt(const std::vector<const PaymentSubscription*>& recipients, std::size_t i) {
+    return *recipients[i];
+}
+
+Satoshis shareOf(double value, double totalValue, Satoshis budget) {
+    if (!(value > 0.0) || !(totalValue > 0.0)) {
+        return Satoshis(0);
+    }
+    // Rounding down keeps the sum of the shares within the budget
+    const double share = std::floor(static_cast<double>(budget.getSatoshis()) * (value / totalValue));
+    return Satoshis(std::min(static_cast<std::int64_t>(share), budget.getSatoshis()));
+}
+
+} // namespace
+
+PayoutEngine::PayoutEngine(const License& license, ThreadPool* pool)
+    : m_license(license),
+      m_pool(pool)
+{
+}
+
+std::vector<Payout> PayoutEngine::computePayouts(const std::vector<PaymentSubscription>& recipients,
+                                                 Satoshis budget) const {
+    return compute(recipients, budget);
+}
+
+std::vector<Payout> PayoutEngine::computePayouts(const std::vector<const PaymentSubscription*>& recipients,
+                                                 Satoshis budget) const {
+    return compute(recipients, budget);
+}
+
+Satoshis PayoutEngine::computeShare(const std::string& contributorId, Satoshis budget) const {
+    return shareOf(m_license.getContributorValue(contributorId), m_license.getTotalValue(), budget);
+}
+
+template <typename Recipients>
+std::vector<Payout> PayoutEngine::compute(const Recipients& recipients, Satoshis budget) const {
+    if (budget < Satoshis(0)) {
+        throw std::invalid_argument("Payout budget cannot be negative");
+    }
+
+    const double totalValue = m_license.getTotalValue();
+    std::vector<Payout> payouts(recipients.size());
+
+    // Each chunk writes its own payouts, and contributors are looked up by
+    // their interned IDs, so the chunks share no lock
+    auto computeChunk = [&](std::size_t chunk) {
+        const std::size_t end = std::min(recipients.size(), (chunk + 1) * kPayoutChunk);
+        for (std::size_t i = chunk * kPayoutChunk; i < end; i++) {
+            const PaymentSubscription& recipient = recipientAt(recipients, i);
+            Payout& payout = payouts[i];
+            payout.contributorId = recipient.getContributorId();
+            payout.walletAddress = recipient.getWalletAddress();
+            payout.value = m_license.getInternedContributorValue(recipient.getInternedContributorId());
+            payout.amount = shareOf(payout.value, totalValue, budget);
+        }
+    };
+
+    const std::size_t chunks = (recipients.size() + kPayoutChunk - 1) / kPayoutChunk;
+    if (m_pool && chunks > 1) {
+        m_pool->parallelFor(chunks, computeChunk);
+    } else {
+        for (std::size_t chunk = 0; chunk < chunks; chunk++) {
+            computeChunk(chunk);
+        }
+    }
+
+    return payouts;
+}
+
+} // namespace ccsl
@@ -0,0 +1,86 @@
+/**
+ * @file report_writer.cpp
+ * @brief Implementation of the buffered report writer
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/report_writer.hpp>
+#include <charconv>
+#include <cstring>
+#include <ostream>
+#include <utility>
+
+namespace ccsl {
+
+ReportWriter::ReportWriter(ReportSink sink) : m_sink(std::move(sink)) {}
+
+ReportWriter::ReportWriter(std::ostream& out)
+    : m_sink([&out](std::string_view text) { out.write(text.data(), static_cast<std::streamsize>(text.size())); }) {}
+
+ReportWriter::~ReportWriter() {
+    flush();
+}
+
+ReportWriter& ReportWriter::operator<<(std::string_view text) {
+    if (m_size + text.size() > kBufferSize) {
+        flush();
+        // Text that would fill the buffer anyway goes straight to the sink
+        if (text.size() >= kBufferSize) {
+            m_sink(text);
+            return *this;
+        }
+    }
+    std::memcpy(m_buffer + m_size, text.data(), text.size());
+    m_size += text.size();
+    return *this;
+}
+
+ReportWriter& ReportWriter::operator<<(char c) {
+    if (m_size == kBufferSize) {
+        flush();
+    }
+    m_buffer[m_size++] = c;
+    return *this;
+}
+
+ReportWriter& ReportWriter::operator<<(std::int64_t value) {
+    reserveNumber();
+    m_size = static_cast<std::size_t>(std::to_chars(m_buffer + m_size, m_buffer + kBufferSize, value).ptr - m_buffer);
+    return *this;
+}
+
+ReportWriter& ReportWriter::operator<<(std::uint64_t value) {
+    reserveNumber();
+    m_size = static_cast<std::size_t>(std::to_chars(m_buffer + m_size, m_buffer + kBufferSize, value).ptr - m_buffer);
+    return *this;
+}
+
+ReportWriter& ReportWriter::operator<<(double value) {
+    reserveNumber();
+    m_size = static_cast<std::size_t>(
+        std::to_chars(m_buffer + m_size, m_buffer + kBufferSize, value, std::chars_format::general, 6).ptr - m_buffer);
+    return *this;
+}
+
+ReportWriter& ReportWriter::writeFixed(double value, int decimals) {
+    reserveNumber();
+    decimals = decimals < 0 ? 0 : decimals > kMaxDecimals ? kMaxDecimals : decimals;
+    m_size = static_cast<std::size_t>(
+        std::to_chars(m_buffer + m_size, m_buffer + kBufferSize, value, std::chars_format::fixed, decimals).ptr - m_buffer);
+    return *this;
+}
+
+ReportWriter& ReportWriter::writeBitcoinAmount(Satoshis amount) {
+    reserveNumber();
+    m_size += formatSatoshis(amount, m_buffer + m_size);
+    return *this;
+}
+
+void ReportWriter::flush() {
+    if (m_size > 0) {
+        m_sink(std::string_view(m_buffer, m_size));
+        m_size = 0;
+    }
+}
+
+} // namespace ccsl
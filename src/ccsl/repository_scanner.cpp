@@ -0,0 +1,346 @@
+/**
+ * @file repository_scanner.cpp
+ * @brief Implementation of the pipelined repository scanner
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/repository_scanner.hpp>
+#include <ccsl/source_file.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace ccsl {
+
+namespace {
+
+/**
+ * @brief Blocking FIFO with a fixed capacity, connecting two pipeline stages
+ *
+ * Producers block while the queue is full, so a fast stage cannot run
+ * ahead of a slow one by more than the capacity.
+ */
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(std::size_t capacity) : m_capacity(capacity) {}
+
+    /**
+     * @brief Add an item, waiting for room
+     * @param item The item
+     * @return False if the queue was closed and the item was dropped
+     */
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFull.wait(lock, [this] { return m_closed || m_items.size() < m_capacity; });
+        if (m_closed) {
+            return false;
+        }
+        m_items.push_back(std::move(item));
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest item, waiting for one
+     * @return The item, or empty once the queue is closed and drained
+     */
+    std::optional<T> pop() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [this] { return m_closed || !m_items.empty(); });
+        if (m_items.empty()) {
+            return std::nullopt;
+        }
+        std::optional<T> item(std::move(m_items.front()));
+        m_items.pop_front();
+        m_notFull.notify_one();
+        return item;
+    }
+
+    /**
+     * @brief Refuse further items; consumers still drain what is queued
+     */
+    void close() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_notFull.notify_all();
+        m_notEmpty.notify_all();
+    }
+
+    /**
+     * @brief Close the queue and drop everything in it
+     */
+    void cancel() {
+        std::deque<T> dropped;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+            dropped.swap(m_items);
+            m_notFull.notify_all();
+            m_notEmpty.notify_all();
+        }
+    }
+
+private:
+    std::size_t m_capacity;              ///< Most items held at once
+    std::deque<T> m_items;               ///< Queued items, oldest first
+    bool m_closed = false;               ///< Set by close() or cancel()
+    std::mutex m_mutex;                  ///< Guards every member
+    std::condition_variable m_notFull;   ///< Signalled when an item is removed
+    std::condition_variable m_notEmpty;  ///< Signalled when an item is added
+};
+
+struct DiscoveredFile {
+    std::filesystem::path path; ///< Where to read the file
+    std::string fileId;         ///< Path relative to the root, in generic form
+};
+
+struct LoadedFile {
+    std::string fileId;         ///< Path relative to the root, in generic form
+    SourceFile source;          ///< Mapped contents
+};
+
+struct EvaluatedFile {
+    std::string fileId;         ///< Path relative to the root, in generic form
+    int lineCount;              ///< Number of lines in the file
+    MetricScores scores;        ///< Scores of the whole file
+};
+
+// Scanning every file means no extension is a reason to skip one
+SourceClassifierOptions classifierOptions(const RepositoryScanOptions& options) {
+    SourceClassifierOptions result = options.classifier;
+    if (options.extensions.empty()) {
+        result.requireKnownExtension = false;
+    }
+    return result;
+}
+
+} // namespace
+
+RepositoryScanner::RepositoryScanner(RepositoryScanOptions options)
+    : m_options(std::move(options)),
+      m_classifier(classifierOptions(m_options)) {
+    if (m_options.contributor.empty()) {
+        throw std::invalid_argument("Contributor cannot be empty");
+    }
+    if (m_options.readThreads == 0) {
+        throw std::invalid_argument("Read thread count must be positive");
+    }
+    if (m_options.queueCapacity == 0) {
+        throw std::invalid_argument("Queue capacity must be positive");
+    }
+    if (m_options.evaluateThreads == 0) {
+        m_options.evaluateThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+bool RepositoryScanner::matches(const std::filesystem::path& path) const {
+    if (m_options.extensions.empty()) {
+        return true;
+    }
+    const std::string extension = path.extension().string();
+    return std::find(m_options.extensions.begin(), m_options.extensions.end(), extension) !=
+           m_options.extensions.end();
+}
+
+RepositoryScanResult RepositoryScanner::scan(const std::filesystem::path& root, License& license) {
+    namespace fs = std::filesystem;
+
+    m_cancelled.store(false);
+    m_counters.discovered = 0;
+    m_counters.read = 0;
+    m_counters.evaluated = 0;
+    m_counters.registered = 0;
+    m_counters.rejected = 0;
+    m_counters.skipped = 0;
+    m_counters.failed = 0;
+    m_counters.bytes = 0;
+
+    RepositoryScanResult result;
+    std::mutex failuresMutex;
+    auto fail = [&](const fs::path& path) {
+        m_counters.failed++;
+        std::lock_guard<std::mutex> lock(failuresMutex);
+        result.failures.push_back(path);
+    };
+
+    std::error_code ec;
+    if (!fs::is_directory(root, ec)) {
+        fail(root);
+        result.progress = getProgress();
+        return result;
+    }
+
+    BoundedQueue<DiscoveredFile> discovered(m_options.queueCapacity);
+    BoundedQueue<LoadedFile> loaded(m_options.queueCapacity);
+    BoundedQueue<EvaluatedFile> evaluated(m_options.queueCapacity);
+    {
+        std::lock_guard<std::mutex> lock(m_cancelMutex);
+        m_cancelQueues = [&] {
+            discovered.cancel();
+            loaded.cancel();
+            evaluated.cancel();
+        };
+        // cancel() may have run before the queues could be woken
+        if (m_cancelled.load()) {
+            m_cancelQueues();
+        }
+    }
+
+    std::thread discoverer([&] {
+        fs::directory_options options = fs::directory_options::skip_permission_denied;
+        if (m_options.followSymlinks) {
+            options |= fs::directory_options::follow_directory_symlink;
+        }
+        std::error_code walkError;
+        fs::path current = root;
+        fs::recursive_directory_iterator it(root, options, walkError);
+        for (; !walkError && it != fs::recursive_directory_iterator() && !m_cancelled.load();
+             it.increment(walkError)) {
+            current = it->path();
+            std::error_code entryError;
+            if (!it->is_regular_file(entryError) || !matches(it->path())) {
+                continue;
+            }
+            m_counters.discovered++;
+            const std::uintmax_t size = it->file_size(entryError);
+            if (entryError) {
+                fail(it->path());
+                continue;
+            }
+            if (size == 0 || size > m_options.maxFileSize) {
+                m_counters.skipped++;
+                continue;
+            }
+            if (!discovered.push({it->path(), it->path().lexically_relative(root).generic_string()})) {
+                break;
+            }
+        }
+        if (walkError) {
+            fail(current);
+        }
+        discovered.close();
+    });
+
+    std::atomic<std::size_t> activeReaders{m_options.readThreads};
+    std::vector<std::thread> readers;
+    for (std::size_t i = 0; i < m_options.readThreads; i++) {
+        readers.emplace_back([&] {
+            while (std::optional<DiscoveredFile> file = discovered.pop()) {
+                std::optional<SourceFile> source = SourceFile::open(file->path);
+                if (!source) {
+                    fail(file->path);
+                    continue;
+                }
+                m_counters.read++;
+                m_counters.bytes += source->getContents().size();
+                if (source->getLineCount() == 0) {
+                    m_counters.skipped++;
+                    continue;
+                }
+                // Rejected here, a file never takes up an evaluation thread
+                if (m_options.classifyFiles &&
+                    !m_classifier.classify(file->fileId, source->getContents()).shouldEvaluate()) {
+                    m_counters.skipped++;
+                    continue;
+                }
+                if (!loaded.push({std::move(file->fileId), std::move(*source)})) {
+                    break;
+                }
+            }
+            if (--activeReaders == 0) {
+                loaded.close();
+            }
+        });
+    }
+
+    std::atomic<std::size_t> activeEvaluators{m_options.evaluateThreads};
+    std::vector<std::thread> evaluators;
+    for (std::size_t i = 0; i < m_options.evaluateThreads; i++) {
+        evaluators.emplace_back([&] {
+            while (std::optional<LoadedFile> file = loaded.pop()) {
+                EvaluatedFile scored{std::move(file->fileId),
+                                     static_cast<int>(file->source.getLineCount()), MetricScores{}};
+                try {
+                    scored.scores = m_evaluator.evaluateScores(file->source.getContents());
+                } catch (const std::exception&) {
+                    fail(root / scored.fileId);
+                    continue;
+                }
+                m_counters.evaluated++;
+                // Unmap the file before waiting for room in the next queue
+                file.reset();
+                if (!evaluated.push(std::move(scored))) {
+                    break;
+                }
+            }
+            if (--activeEvaluators == 0) {
+                evaluated.close();
+            }
+        });
+    }
+
+    // Registration runs on the calling thread, since License is not thread-safe
+    while (std::optional<EvaluatedFile> file = evaluated.pop()) {
+        try {
+            CodeContribution contribution(m_options.contributor, file->fileId, 0, file->lineCount - 1);
+            contribution.setMetricScores(file->scores);
+            if (license.registerContribution(contribution)) {
+                m_counters.registered++;
+            } else {
+                m_counters.rejected++;
+            }
+        } catch (const std::exception&) {
+            fail(root / file->fileId);
+        }
+        if (m_options.onProgress) {
+            m_options.onProgress(getProgress());
+        }
+    }
+
+    discoverer.join();
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    for (std::thread& evaluator : evaluators) {
+        evaluator.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_cancelMutex);
+        m_cancelQueues = nullptr;
+    }
+
+    result.progress = getProgress();
+    result.cancelled = m_cancelled.load();
+    if (m_options.onProgress) {
+        m_options.onProgress(result.progress);
+    }
+    return result;
+}
+
+void RepositoryScanner::cancel() {
+    m_cancelled.store(true);
+    std::lock_guard<std::mutex> lock(m_cancelMutex);
+    if (m_cancelQueues) {
+        m_cancelQueues();
+    }
+}
+
+ScanProgress RepositoryScanner::getProgress() const {
+    ScanProgress progress;
+    progress.discovered = m_counters.discovered.load();
+    progress.read = m_counters.read.load();
+    progress.evaluated = m_counters.evaluated.load();
+    progress.registered = m_counters.registered.load();
+    progress.rejected = m_counters.rejected.load();
+    progress.skipped = m_counters.skipped.load();
+    progress.failed = m_counters.failed.load();
+    progress.bytes = m_counters.bytes.load();
+    return progress;
+}
+
+} // namespace ccsl
@@ -0,0 +1,195 @@
+/**
+ * @file score_matrix.cpp
+ * @brief Implementation of metric weights and the columnar score matrix
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/license.hpp>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CCSL_SCORE_MATRIX_AVX2 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define CCSL_SCORE_MATRIX_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace ccsl {
+
+namespace {
+
+/**
+ * @brief Column pointers of a score matrix, for the weighing kernels
+ */
+struct Columns {
+    const double* scores[kMetricTypeCount];  ///< Score column per metric
+    const double* present[kMetricTypeCount]; ///< Presence column per metric
+};
+
+using WeighKernel = void (*)(const Columns& columns, const double* weights,
+                             std::size_t begin, std::size_t end, double* out);
+
+// Each kernel adds weight * score and weight * presence metric by metric,
+// in metric order, so all of them round exactly like MetricWeights::apply().
+// The build compiles this file with -ffp-contract=off; a fused multiply-add
+// in the scalar loops would round differently from the vector kernels.
+void weighScalar(const Columns& columns, const double* weights,
+                 std::size_t begin, std::size_t end, double* out) {
+    for (std::size_t row = begin; row < end; row++) {
+        double weighted = 0.0;
+        double weight = 0.0;
+        for (std::size_t m = 0; m < kMetricTypeCount; m++) {
+            weighted = weighted + weights[m] * columns.scores[m][row];
+            weight = weight + weights[m] * columns.present[m][row];
+        }
+        out[row] = weight > 0.0 ? weighted / weight : 0.0;
+    }
+}
+
+#if defined(CCSL_SCORE_MATRIX_AVX2)
+__attribute__((target("avx2")))
+void weighAvx2(const Columns& columns, const double* weights,
+               std::size_t begin, std::size_t end, double* out) {
+    const __m256d zero = _mm256_setzero_pd();
+    std::size_t row = begin;
+    for (; row + 4 <= end; row += 4) {
+        __m256d weighted = zero;
+        __m256d weight = zero;
+        for (std::size_t m = 0; m < kMetricTypeCount; m++) {
+            const __m256d w = _mm256_set1_pd(weights[m]);
+            weighted = _mm256_add_pd(weighted, _mm256_mul_pd(w, _mm256_loadu_pd(columns.scores[m] + row)));
+            weight = _mm256_add_pd(weight, _mm256_mul_pd(w, _mm256_loadu_pd(columns.present[m] + row)));
+        }
+        // Rows without weight divide by zero; the mask turns them into 0
+        const __m256d hasWeight = _mm256_cmp_pd(weight, zero, _CMP_GT_OQ);
+        _mm256_storeu_pd(out + row, _mm256_and_pd(hasWeight, _mm256_div_pd(weighted, weight)));
+    }
+    weighScalar(columns, weights, row, end, out);
+}
+
+bool hasAvx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+#endif
+
+#if defined(CCSL_SCORE_MATRIX_NEON)
+void weighNeon(const Columns& columns, const double* weights,
+               std::size_t begin, std::size_t end, double* out) {
+    const float64x2_t zero = vdupq_n_f64(0.0);
+    std::size_t row = begin;
+    for (; row + 2 <= end; row += 2) {
+        float64x2_t weighted = zero;
+        float64x2_t weight = zero;
+        for (std::size_t m = 0; m < kMetricTypeCount; m++) {
+            const float64x2_t w = vdupq_n_f64(weights[m]);
+            weighted = vaddq_f64(weighted, vmulq_f64(w, vld1q_f64(columns.scores[m] + row)));
+            weight = vaddq_f64(weight, vmulq_f64(w, vld1q_f64(columns.present[m] + row)));
+        }
+        const uint64x2_t hasWeight = vcgtq_f64(weight, zero);
+        vst1q_f64(out + row, vbslq_f64(hasWeight, vdivq_f64(weighted, weight), zero));
+    }
+    weighScalar(columns, weights, row, end, out);
+}
+#endif
+
+WeighKernel selectKernel() {
+#if defined(CCSL_SCORE_MATRIX_AVX2)
+    if (hasAvx2()) {
+        return weighAvx2;
+    }
+#elif defined(CCSL_SCORE_MATRIX_NEON)
+    return weighNeon;
+#endif
+    return weighScalar;
+}
+
+std::array<std::pmr::vector<double>, kMetricTypeCount> makeColumns(std::pmr::memory_resource* resource) {
+    return {std::pmr::vector<double>(resource), std::pmr::vector<double>(resource),
+            std::pmr::vector<double>(resource), std::pmr::vector<double>(resource),
+            std::pmr::vector<double>(resource), std::pmr::vector<double>(resource)};
+}
+
+static_assert(kMetricTypeCount == 6, "makeColumns() builds one column per metric type");
+
+} // namespace
+
+void MetricWeights::set(MetricType type, double weight) {
+    if (!std::isfinite(weight) || weight < 0.0) {
+        throw std::invalid_argument("Metric weight must be finite and non-negative");
+    }
+    values[metricIndex(type)] = weight;
+}
+
+double MetricWeights::apply(const MetricScores& scores) const {
+    double weighted = 0.0;
+    double weight = 0.0;
+    for (std::size_t m = 0; m < kMetricTypeCount; m++) {
+        const double present = (scores.present >> m) & 1u ? 1.0 : 0.0;
+        weighted = weighted + values[m] * (present > 0.0 ? scores.values[m] : 0.0);
+        weight = weight + values[m] * present;
+    }
+    return weight > 0.0 ? weighted / weight : 0.0;
+}
+
+ScoreMatrix::ScoreMatrix(const MetricWeights& weights, std::pmr::memory_resource* resource)
+    : m_weights(weights),
+      m_scores(makeColumns(resource)),
+      m_present(makeColumns(resource)),
+      m_rowValues(resource)
+{
+}
+
+double ScoreMatrix::append(const MetricScores& scores) {
+    for (std::size_t m = 0; m < kMetricTypeCount; m++) {
+        const bool present = (scores.present >> m) & 1u;
+        m_scores[m].push_back(present ? scores.values[m] : 0.0);
+        m_present[m].push_back(present ? 1.0 : 0.0);
+    }
+    m_rowValues.push_back(m_weights.apply(scores));
+    return m_rowValues.back();
+}
+
+void ScoreMatrix::removeSwap(std::size_t row) {
+    const std::size_t last = m_rowValues.size() - 1;
+    for (std::size_t m = 0; m < kMetricTypeCount; m++) {
+        m_scores[m][row] = m_scores[m][last];
+        m_scores[m].pop_back();
+        m_present[m][row] = m_present[m][last];
+        m_present[m].pop_back();
+    }
+    m_rowValues[row] = m_rowValues[last];
+    m_rowValues.pop_back();
+}
+
+void ScoreMatrix::clear() {
+    for (std::size_t m = 0; m < kMetricTypeCount; m++) {
+        m_scores[m].clear();
+        m_present[m].clear();
+    }
+    m_rowValues.clear();
+}
+
+void ScoreMatrix::reserve(std::size_t rows) {
+    for (std::size_t m = 0; m < kMetricTypeCount; m++) {
+        m_scores[m].reserve(rows);
+        m_present[m].reserve(rows);
+    }
+    m_rowValues.reserve(rows);
+}
+
+void ScoreMatrix::setWeights(const MetricWeights& weights) {
+    static const WeighKernel kernel = selectKernel();
+
+    m_weights = weights;
+    Columns columns;
+    for (std::size_t m = 0; m < kMetricTypeCount; m++) {
+        columns.scores[m] = m_scores[m].data();
+        columns.present[m] = m_present[m].data();
+    }
+    kernel(columns, m_weights.values.data(), 0, m_rowValues.size(), m_rowValues.data());
+}
+
+} // namespace ccsl
@@ -0,0 +1,121 @@
+/**
+ * @file source_classifier.cpp
+ * @brief Implementation of the source classifier
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/source_classifier.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <string>
+
+namespace ccsl {
+
+namespace {
+
+struct ExtensionLanguage {
+    const char* extension;
+    SourceLanguage language;
+};
+
+// Lowercase extensions; ".C" and ".H" are handled before lowercasing
+const ExtensionLanguage kExtensions[] = {
+    {".c", SourceLanguage::C},    {".h", SourceLanguage::C},
+    {".cc", SourceLanguage::CPP}, {".cpp", SourceLanguage::CPP}, {".cxx", SourceLanguage::CPP},
+    {".c++", SourceLanguage::CPP}, {".hh", SourceLanguage::CPP}, {".hpp", SourceLanguage::CPP},
+    {".hxx", SourceLanguage::CPP}, {".h++", SourceLanguage::CPP}, {".ipp", SourceLanguage::CPP},
+    {".inl", SourceLanguage::CPP}, {".tpp", SourceLanguage::CPP}, {".tcc", SourceLanguage::CPP}
+};
+
+std::string_view extensionOf(std::string_view path) {
+    const std::size_t slash = path.find_last_of("/\\");
+    const std::string_view name = slash == std::string_view::npos ? path : path.substr(slash + 1);
+    const std::size_t dot = name.rfind('.');
+    // A leading dot names a hidden file, not an extension
+    if (dot == std::string_view::npos || dot == 0) {
+        return {};
+    }
+    return name.substr(dot);
+}
+
+} // namespace
+
+SourceClassifier::SourceClassifier(const SourceClassifierOptions& options)
+    : m_options(options)
+{
+}
+
+SourceLanguage SourceClassifier::languageOf(std::string_view path) {
+    const std::string_view extension = extensionOf(path);
+    if (extension == ".C" || extension == ".H") {
+        return SourceLanguage::CPP;
+    }
+
+    std::string lower(extension);
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    for (const ExtensionLanguage& known : kExtensions) {
+        if (lower == known.extension) {
+            return known.language;
+        }
+    }
+    return SourceLanguage::UNKNOWN;
+}
+
+SourceClassification SourceClassifier::classify(std::string_view path, std::string_view contents) const {
+    SourceClassification result;
+    result.language = languageOf(path);
+    if (result.language == SourceLanguage::UNKNOWN && m_options.requireKnownExtension &&
+        !extensionOf(path).empty()) {
+        result.verdict = SourceVerdict::NOT_C_FAMILY;
+        return result;
+    }
+
+    const std::size_t probe = std::min(contents.size(), m_options.binaryProbeBytes);
+    if (probe > 0 && std::memchr(contents.data(), '\0', probe)) {
+        result.verdict = SourceVerdict::BINARY;
+        return result;
+    }
+
+    // memchr() never looks further than one line past the limit, so a
+    // single huge line is rejected without reading all of it
+    const char* position = contents.data();
+    const char* const end = contents.data() + contents.size();
+    while (position < end) {
+        const std::size_t window = std::min<std::size_t>(end - position, m_options.maxLineLength + 1);
+        const char* newline = static_cast<const char*>(std::memchr(position, '\n', window));
+        const std::size_t length = newline ? static_cast<std::size_t>(newline - position) : window;
+        result.lineCount++;
+        result.longestLine = std::max(result.longestLine, length);
+        if (length > m_options.maxLineLength) {
+            result.verdict = SourceVerdict::MINIFIED;
+            return result;
+        }
+        if (length > m_options.longLineLength) {
+            result.longLines++;
+        }
+        position = newline ? newline + 1 : end;
+    }
+
+    if (static_cast<double>(result.longLines) > m_options.maxLongLineFraction * static_cast<double>(result.lineCount)) {
+        result.verdict = SourceVerdict::MINIFIED;
+    }
+    return result;
+}
+
+const char* verdictName(SourceVerdict verdict) {
+    switch (verdict) {
+        case SourceVerdict::EVALUATE:
+            return "evaluate";
+        case SourceVerdict::NOT_C_FAMILY:
+            return "not C-family";
+        case SourceVerdict::BINARY:
+            return "binary";
+        case SourceVerdict::MINIFIED:
+            return "minified";
+    }
+    return "unknown";
+}
+
+} // namespace ccsl
@@ -0,0 +1,155 @@
+/**
+ * @file source_file.cpp
+ * @brief Implementation of the memory-mapped source file
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/source_file.hpp>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CCSL_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ccsl {
+
+std::optional<SourceFile> SourceFile::open(const std::filesystem::path& filePath) {
+    SourceFile file;
+
+#ifdef CCSL_HAVE_MMAP
+    int fd = ::open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return std::nullopt;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        ::close(fd);
+        return std::nullopt;
+    }
+
+    // Empty files cannot be mapped, but they are still valid sources
+    if (info.st_size > 0) {
+        void* mapping = ::mmap(nullptr, static_cast<std::size_t>(info.st_size),
+                               PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            return std::nullopt;
+        }
+        ::madvise(mapping, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+        file.m_mapping = mapping;
+        file.m_data = static_cast<const char*>(mapping);
+        file.m_size = static_cast<std::size_t>(info.st_size);
+    }
+    ::close(fd);
+#else
+    std::ifstream stream(filePath, std::ios::binary | std::ios::ate);
+    if (!stream.is_open()) {
+        return std::nullopt;
+    }
+
+    const std::streamsize size = stream.tellg();
+    stream.seekg(0);
+    file.m_buffer = std::make_unique<char[]>(static_cast<std::size_t>(size));
+    if (size > 0 && !stream.read(file.m_buffer.get(), size)) {
+        return std::nullopt;
+    }
+    file.m_data = file.m_buffer.get();
+    file.m_size = static_cast<std::size_t>(size);
+#endif
+
+    file.buildLineIndex();
+    return file;
+}
+
+SourceFile SourceFile::fromString(std::string contents) {
+    SourceFile file;
+    file.m_buffer = std::make_unique<char[]>(contents.size());
+    std::memcpy(file.m_buffer.get(), contents.data(), contents.size());
+    file.m_data = file.m_buffer.get();
+    file.m_size = contents.size();
+    file.buildLineIndex();
+    return file;
+}
+
+SourceFile::~SourceFile() {
+    release();
+}
+
+SourceFile::SourceFile(SourceFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)),
+      m_size(std::exchange(other.m_size, 0)),
+      m_mapping(std::exchange(other.m_mapping, nullptr)),
+      m_buffer(std::move(other.m_buffer)),
+      m_lineOffsets(std::move(other.m_lineOffsets)) {
+}
+
+SourceFile& SourceFile::operator=(SourceFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+        m_buffer = std::move(other.m_buffer);
+        m_lineOffsets = std::move(other.m_lineOffsets);
+    }
+    return *this;
+}
+
+std::string_view SourceFile::getLine(std::size_t line) const {
+    std::string_view lines = getLines(line, line);
+    if (!lines.empty() && lines.back() == '\n') {
+        lines.remove_suffix(1);
+    }
+    return lines;
+}
+
+std::string_view SourceFile::getLines(std::size_t startLine, std::size_t endLine) const {
+    if (startLine >= m_lineOffsets.size() || endLine < startLine) {
+        return std::string_view();
+    }
+
+    const std::size_t begin = m_lineOffsets[startLine];
+    const std::size_t end = endLine + 1 < m_lineOffsets.size() ? m_lineOffsets[endLine + 1] : m_size;
+    return std::string_view(m_data + begin, end - begin);
+}
+
+void SourceFile::buildLineIndex() {
+    m_lineOffsets.clear();
+    if (m_size == 0) {
+        return;
+    }
+
+    m_lineOffsets.push_back(0);
+
+    // memchr is vectorized by the C library, which makes this scan cheap
+    const char* cursor = m_data;
+    const char* const last = m_data + m_size;
+    while (const void* found = std::memchr(cursor, '\n', static_cast<std::size_t>(last - cursor))) {
+        cursor = static_cast<const char*>(found) + 1;
+        if (cursor == last) {
+            break;
+        }
+        m_lineOffsets.push_back(static_cast<std::size_t>(cursor - m_data));
+    }
+}
+
+void SourceFile::release() {
+#ifdef CCSL_HAVE_MMAP
+    if (m_mapping) {
+        ::munmap(m_mapping, m_size);
+    }
+#endif
+    m_mapping = nullptr;
+    m_data = nullptr;
+    m_size = 0;
+    m_buffer.reset();
+}
+
+} // namespace ccsl
@@ -0,0 +1,114 @@
+/**
+ * @file string_interner.cpp
+ * @brief Implementation of the shared string interner
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/string_interner.hpp>
+#include <limits>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+
+namespace ccsl {
+
+namespace {
+
+unsigned highestBit(std::uint64_t value) {
+#if defined(__GNUC__)
+    return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+    unsigned bit = 0;
+    while (value >>= 1) {
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+} // namespace
+
+StringInterner& StringInterner::get() {
+    // Never destroyed, so interned strings outlive every static that holds one
+    static StringInterner* instance = new StringInterner();
+    return *instance;
+}
+
+StringInterner::StringInterner() {
+    intern(std::string_view());
+}
+
+StringInterner::~StringInterner() {
+    for (std::atomic<std::string*>& block : m_blocks) {
+        delete[] block.load(std::memory_order_relaxed);
+    }
+}
+
+std::string* StringInterner::slot(StringId id) const {
+    // Offsetting by the first block's size makes the block index the
+    // position of the highest set bit
+    const std::uint64_t position = std::uint64_t(id) + kFirstBlockSize;
+    const unsigned block = highestBit(position) - kFirstBlockBits;
+    std::string* storage = m_blocks[block].load(std::memory_order_acquire);
+    return storage + (position - (std::uint64_t(kFirstBlockSize) << block));
+}
+
+StringId StringInterner::intern(std::string_view text) {
+    if (std::optional<StringId> id = find(text)) {
+        return *id;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto found = m_ids.find(text);
+    if (found != m_ids.end()) {
+        return found->second;
+    }
+
+    const std::size_t next = m_size.load(std::memory_order_relaxed);
+    if (next > std::numeric_limits<StringId>::max()) {
+        throw std::length_error("String interner is full");
+    }
+    const StringId id = static_cast<StringId>(next);
+
+    const std::uint64_t position = std::uint64_t(id) + kFirstBlockSize;
+    const unsigned block = highestBit(position) - kFirstBlockBits;
+    if (!m_blocks[block].load(std::memory_order_relaxed)) {
+        m_blocks[block].store(new std::string[kFirstBlockSize << block], std::memory_order_release);
+    }
+
+    std::string* stored = slot(id);
+    *stored = std::string(text);
+    m_ids.emplace(std::string_view(*stored), id);
+    // Publishes the string to lookup(), which reads without the lock
+    m_size.store(next + 1, std::memory_order_release);
+    return id;
+}
+
+std::optional<StringId> StringInterner::find(std::string_view text) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    auto found = m_ids.find(text);
+    if (found == m_ids.end()) {
+        return std::nullopt;
+    }
+    return found->second;
+}
+
+const std::string& StringInterner::lookup(StringId id) const {
+    if (id >= size()) {
+        return *slot(0);
+    }
+    return *slot(id);
+}
+
+std::optional<InternedString> InternedString::find(std::string_view text) {
+    if (std::optional<StringId> id = StringInterner::get().find(text)) {
+        return InternedString(*id, true);
+    }
+    return std::nullopt;
+}
+
+std::ostream& operator<<(std::ostream& out, InternedString text) {
+    return out << text.str();
+}
+
+} // namespace ccsl
@@ -0,0 +1,155 @@
+/**
+ * @file thread_pool.cpp
+ * @brief Implementation of the work-stealing thread pool
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/thread_pool.hpp>
+#include <algorithm>
+#include <exception>
+
+namespace ccsl {
+
+ThreadPool::ThreadPool(std::size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (std::size_t i = 0; i < threadCount; i++) {
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    m_workers.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; i++) {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    std::size_t index = m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    {
+        // Count the task before it becomes visible so m_queued never underflows,
+        // and do it under the pool mutex so a worker about to sleep sees it
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queued.fetch_add(1, std::memory_order_release);
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->tasks.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+
+    // A few chunks per worker keeps stealing effective without flooding the queues
+    const std::size_t chunkCount = std::min(count, m_workers.size() * 4);
+    const std::size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    struct State {
+        std::mutex mutex;
+        std::condition_variable done;
+        std::size_t remaining = 0;
+        std::exception_ptr error;
+    } state;
+    state.remaining = (count + chunkSize - 1) / chunkSize;
+
+    for (std::size_t begin = 0; begin < count; begin += chunkSize) {
+        const std::size_t end = std::min(count, begin + chunkSize);
+        submit([&state, &body, begin, end]() {
+            std::exception_ptr error;
+            try {
+                for (std::size_t i = begin; i < end; i++) {
+                    body(i);
+                }
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(state.mutex);
+            if (error && !state.error) {
+                state.error = error;
+            }
+            if (--state.remaining == 0) {
+                state.done.notify_all();
+            }
+        });
+    }
+
+    // Help out until the queues are drained, then wait for in-flight chunks
+    while (runPendingTask(0)) {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (state.remaining == 0) {
+            break;
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.done.wait(lock, [&state]() { return state.remaining == 0; });
+
+    if (state.error) {
+        std::rethrow_exception(state.error);
+    }
+}
+
+bool ThreadPool::runPendingTask(std::size_t queueIndex) {
+    std::function<void()> task;
+
+    // Own queue first (newest task), then steal from the others (oldest task)
+    for (std::size_t offset = 0; offset < m_queues.size() && !task; offset++) {
+        WorkerQueue& queue = *m_queues[(queueIndex + offset) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            continue;
+        }
+        if (offset == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+
+    if (!task) {
+        return false;
+    }
+
+    m_queued.fetch_sub(1, std::memory_order_acq_rel);
+    task();
+    return true;
+}
+
+void ThreadPool::workerLoop(std::size_t queueIndex) {
+    while (true) {
+        if (runPendingTask(queueIndex)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this]() {
+            return m_stopping || m_queued.load(std::memory_order_acquire) > 0;
+        });
+
+        if (m_stopping && m_queued.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+} // namespace ccsl
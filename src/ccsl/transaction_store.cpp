@@ -0,0 +1,249 @@
+/**
+ * @file transaction_store.cpp
+ * @brief Implementation of the concurrent transaction store
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/transaction_store.hpp>
+#include <ccsl/utility.hpp>
+#include <algorithm>
+
+namespace ccsl {
+
+namespace {
+
+std::size_t hashKey(const std::string& key) {
+    return hashBytes(key);
+}
+
+std::size_t hashKey(InternedString key) {
+    // IDs are dense, so consecutive contributions fill consecutive buckets
+    return key.getId();
+}
+
+} // namespace
+
+struct TransactionStore::Record {
+    PaymentTransaction transaction;  ///< Immutable once published, except verified
+    mutable std::atomic<bool> verified; ///< Authoritative verification status
+    const Record* previous;          ///< Next older record, for insertion-order walks
+
+    PaymentTransaction copy() const {
+        PaymentTransaction result = transaction;
+        result.verified = verified.load(std::memory_order_acquire);
+        return result;
+    }
+};
+
+/**
+ * @brief Insert-only hash index from a field of type Key to records
+ *
+ * Each table owns its bucket heads and a pool of links filled in insertion
+ * order. Growing builds a complete new table and publishes it with a single
+ * release store; retired tables stay alive until the index is destroyed, so
+ * readers still walking them are never left dangling. The total memory of
+ * the retired tables is bounded by that of the current one.
+ */
+template <typename Key>
+struct TransactionStore::Index {
+    struct Link {
+        const Record* record; ///< Indexed record
+        const Link* next;     ///< Next older link in the same bucket
+    };
+
+    struct Table {
+        explicit Table(std::size_t bucketCount)
+            : mask(bucketCount - 1),
+              buckets(new std::atomic<const Link*>[bucketCount]),
+              links(new Link[bucketCount]),
+              capacity(bucketCount) {
+            for (std::size_t i = 0; i < bucketCount; i++) {
+                buckets[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        std::size_t mask;                                   ///< Bucket count minus one
+        std::unique_ptr<std::atomic<const Link*>[]> buckets; ///< Newest link of each bucket
+        std::unique_ptr<Link[]> links;                      ///< Link pool, in insertion order
+        std::size_t capacity;                               ///< Links the pool can hold
+        std::size_t used = 0;                               ///< Links handed out; writers only
+    };
+
+    explicit Index(Key PaymentTransaction::* keyField) : key(keyField) {
+        tables.push_back(std::make_unique<Table>(64));
+        current.store(tables.back().get(), std::memory_order_release);
+    }
+
+    const Key& keyOf(const Record* record) const {
+        return record->transaction.*key;
+    }
+
+    // Called with the writer mutex held
+    void insert(const Record* record) {
+        Table* table = current.load(std::memory_order_relaxed);
+        if (table->used == table->capacity) {
+            // Keep the load factor at or below one by doubling
+            auto grown = std::make_unique<Table>((table->mask + 1) * 2);
+            for (std::size_t i = 0; i < table->used; i++) {
+                link(*grown, table->links[i].record);
+            }
+            tables.push_back(std::move(grown));
+            table = tables.back().get();
+            current.store(table, std::memory_order_release);
+        }
+        link(*table, record);
+    }
+
+    void link(Table& table, const Record* record) {
+        const Key& value = keyOf(record);
+        std::atomic<const Link*>& bucket = table.buckets[hashKey(value) & table.mask];
+
+        Link& entry = table.links[table.used++];
+        entry.record = record;
+        entry.next = bucket.load(std::memory_order_relaxed);
+        bucket.store(&entry, std::memory_order_release);
+    }
+
+    /**
+     * @brief Visit the records whose key equals value, newest first
+     * @param visit Called per record; returning false stops the walk
+     */
+    template<typename Visit>
+    void forEach(const Key& value, Visit visit) const {
+        const Table* table = current.load(std::memory_order_acquire);
+        const Link* entry = table->buckets[hashKey(value) & table->mask].load(std::memory_order_acquire);
+        for (; entry; entry = entry->next) {
+            if (keyOf(entry->record) == value && !visit(entry->record)) {
+                return;
+            }
+        }
+    }
+
+    const Record* findFirst(const Key& value) const {
+        const Record* found = nullptr;
+        forEach(value, [&found](const Record* record) {
+            found = record;
+            return false;
+        });
+        return found;
+    }
+
+    Key PaymentTransaction::* key;             ///< Indexed field
+    std::atomic<Table*> current{nullptr};      ///< Table used by readers
+    std::vector<std::unique_ptr<Table>> tables; ///< Current and retired tables; writers only
+};
+
+TransactionStore::TransactionStore()
+    : m_byId(std::make_unique<Index<std::string>>(&PaymentTransaction::transactionId)),
+      m_byContribution(std::make_unique<Index<InternedString>>(&PaymentTransaction::contributionId)) {
+}
+
+TransactionStore::~TransactionStore() = default;
+
+bool TransactionStore::insert(const PaymentTransaction& transaction) {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+
+    if (m_byId->findFirst(transaction.transactionId)) {
+        return false;
+    }
+
+    auto record = std::make_unique<Record>();
+    record->transaction = transaction;
+    record->verified.store(transaction.verified, std::memory_order_relaxed);
+    record->previous = m_newest.load(std::memory_order_relaxed);
+
+    // The indexes publish the fully built record with release stores
+    const Record* published = record.get();
+    m_records.push_back(std::move(record));
+    m_byId->insert(published);
+    m_byContribution->insert(published);
+    m_newest.store(published, std::memory_order_release);
+    m_size.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+bool TransactionStore::setVerified(const std::string& transactionId, bool verified) {
+    const Record* record = m_byId->findFirst(transactionId);
+    if (!record) {
+        return false;
+    }
+
+    // Records live as long as the store, so the flag can be flipped in
+    // place without taking the writer mutex
+    record->verified.store(verified, std::memory_order_release);
+    return true;
+}
+
+bool TransactionStore::isVerified(const std::string& transactionId) const {
+    const Record* record = m_byId->findFirst(transactionId);
+    return record && record->verified.load(std::memory_order_acquire);
+}
+
+std::optional<PaymentTransaction> TransactionStore::find(const std::string& transactionId) const {
+    const Record* record = m_byId->findFirst(transactionId);
+    if (!record) {
+        return std::nullopt;
+    }
+    return record->copy();
+}
+
+std::vector<PaymentTransaction> TransactionStore::findByContribution(const std::string& contributionId) const {
+    std::vector<PaymentTransaction> result;
+    forEachByContribution(contributionId, [&result](const PaymentTransaction& transaction, bool verified) {
+        result.push_back(transaction);
+        result.back().verified = verified;
+        return true;
+    });
+    return result;
+}
+
+std::vector<PaymentTransaction> TransactionStore::snapshot() const {
+    std::vector<PaymentTransaction> result;
+    result.reserve(size());
+    forEach([&result](const PaymentTransaction& transaction, bool verified) {
+        result.push_back(transaction);
+        result.back().verified = verified;
+        return true;
+    });
+    return result;
+}
+
+namespace {
+
+// Chains run newest first; visiting oldest first only needs the pointers
+template <typename Record>
+void visitOldestFirst(const std::vector<const Record*>& newestFirst, const TransactionVisitor& visit) {
+    for (auto it = newestFirst.rbegin(); it != newestFirst.rend(); ++it) {
+        if (!visit((*it)->transaction, (*it)->verified.load(std::memory_order_acquire))) {
+            return;
+        }
+    }
+}
+
+} // namespace
+
+void TransactionStore::forEach(const TransactionVisitor& visit) const {
+    std::vector<const Record*> records;
+    records.reserve(size());
+    for (const Record* record = m_newest.load(std::memory_order_acquire); record; record = record->previous) {
+        records.push_back(record);
+    }
+    visitOldestFirst(records, visit);
+}
+
+void TransactionStore::forEachByContribution(const std::string& contributionId, const TransactionVisitor& visit) const {
+    // No transaction can name a contribution ID that was never interned
+    std::optional<InternedString> key = InternedString::find(contributionId);
+    if (!key) {
+        return;
+    }
+
+    std::vector<const Record*> records;
+    m_byContribution->forEach(*key, [&records](const Record* record) {
+        records.push_back(record);
+        return true;
+    });
+    visitOldestFirst(records, visit);
+}
+
+} // namespace ccsl
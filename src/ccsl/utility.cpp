@@ -5,120 +5,342 @@
  */
 
 #include <ccsl/utility.hpp>
+#include <ccsl/instrumentation.hpp>
+#include <ccsl/bitcoin_address.hpp>
+#include <charconv>
 #include <random>
 #include <sstream>
 #include <iomanip>
-#include <fstream>
-#include <regex>
 #include <ctime>
 #include <algorithm>
 #include <functional>
 #include <cctype>
+#include <cstring>
 
 namespace ccsl {
 
-std::string generateUUID() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> dis(0, 15);
-    static std::uniform_int_distribution<> dis2(8, 11);
+namespace {
 
-    std::stringstream ss;
-    ss << std::hex;
+// xoshiro256**, seeded once per thread through SplitMix64
+class UUIDRandom {
+public:
+    UUIDRandom() {
+        std::random_device device;
+        std::uint64_t seed = (static_cast<std::uint64_t>(device()) << 32) ^ device();
+        seed ^= static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        for (std::uint64_t& word : m_state) {
+            seed += 0x9E3779B97F4A7C15ULL;
+            std::uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    std::uint64_t next() {
+        const std::uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+        const std::uint64_t t = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotl(m_state[3], 45);
+        return result;
+    }
+
+private:
+    static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
 
+    std::uint64_t m_state[4];
+};
+
+// Two lower-case hex digits per byte value
+constexpr std::array<char, 512> kHexPairs = [] {
+    constexpr char digits[] = "0123456789abcdef";
+    std::array<char, 512> pairs{};
+    for (std::size_t i = 0; i < 256; i++) {
+        pairs[2 * i] = digits[i >> 4];
+        pairs[2 * i + 1] = digits[i & 15];
+    }
+    return pairs;
+}();
+
+// Time part of a version 7 UUID: 48 bits of Unix milliseconds followed by
+// 12 bits of sub-millisecond fraction (RFC 9562, method 3). Bumped past the
+// previous value so IDs from one thread are strictly increasing.
+std::uint64_t nextUUIDTimestamp() {
+    thread_local std::uint64_t last = 0;
+
+    const std::uint64_t nanoseconds = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    std::uint64_t timestamp = ((nanoseconds / 1000000) << 12) | (((nanoseconds % 1000000) << 12) / 1000000);
+    if (timestamp <= last) {
+        timestamp = last + 1;
+    }
+    last = timestamp;
+    return timestamp;
+}
+
+} // namespace
+
+UUIDChars generateUUIDChars(UUIDVersion version) {
+    thread_local UUIDRandom random;
+
+    std::uint64_t high = random.next();
+    std::uint64_t low = random.next();
+    if (version == UUIDVersion::V7) {
+        const std::uint64_t timestamp = nextUUIDTimestamp();
+        high = ((timestamp >> 12) << 16) | (timestamp & 0x0FFF);
+    }
+
+    // Version nibble and RFC 4122 variant bits
+    high = (high & ~0xF000ULL) | (static_cast<std::uint64_t>(version) << 12);
+    low = (low & 0x3FFFFFFFFFFFFFFFULL) | 0x8000000000000000ULL;
+
+    std::uint8_t bytes[16];
     for (int i = 0; i < 8; i++) {
-        ss << dis(gen);
+        bytes[i] = static_cast<std::uint8_t>(high >> (56 - 8 * i));
+        bytes[8 + i] = static_cast<std::uint8_t>(low >> (56 - 8 * i));
     }
-    ss << "-";
-    
-    for (int i = 0; i < 4; i++) {
-        ss << dis(gen);
+
+    UUIDChars text;
+    std::size_t out = 0;
+    for (int i = 0; i < 16; i++) {
+        if (i == 4 || i == 6 || i == 8 || i == 10) {
+            text[out++] = '-';
+        }
+        text[out++] = kHexPairs[2 * bytes[i]];
+        text[out++] = kHexPairs[2 * bytes[i] + 1];
+    }
+    return text;
+}
+
+std::string generateUUID(UUIDVersion version) {
+    const UUIDChars text = generateUUIDChars(version);
+    return std::string(text.data(), text.size());
+}
+
+namespace {
+
+constexpr std::uint64_t kPrime1 = 11400714785074694791ULL;
+constexpr std::uint64_t kPrime2 = 14029467366897019727ULL;
+constexpr std::uint64_t kPrime3 = 1609587929392839161ULL;
+constexpr std::uint64_t kPrime4 = 9650029242287828579ULL;
+constexpr std::uint64_t kPrime5 = 2870177450012600261ULL;
+
+inline std::uint64_t rotateLeft(std::uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// Little-endian loads keep the hash identical on every platform
+inline std::uint64_t read64(const unsigned char* p) {
+    std::uint64_t value = 0;
+    for (int i = 7; i >= 0; i--) {
+        value = (value << 8) | p[i];
     }
-    ss << "-4";
+    return value;
+}
+
+inline std::uint64_t read32(const unsigned char* p) {
+    return std::uint64_t(p[0]) | (std::uint64_t(p[1]) << 8) |
+           (std::uint64_t(p[2]) << 16) | (std::uint64_t(p[3]) << 24);
+}
+
+inline std::uint64_t hashRound(std::uint64_t acc, std::uint64_t input) {
+    acc += input * kPrime2;
+    acc = rotateLeft(acc, 31);
+    return acc * kPrime1;
+}
+
+inline std::uint64_t mergeRound(std::uint64_t acc, std::uint64_t value) {
+    acc ^= hashRound(0, value);
+    return acc * kPrime1 + kPrime4;
+}
+
+} // namespace
+
+std::uint64_t hashBytes(std::string_view data, std::uint64_t seed) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data.data());
+    const unsigned char* const end = p + data.size();
+    std::uint64_t hash;
     
-    for (int i = 0; i < 3; i++) {
-        ss << dis(gen);
+    if (data.size() >= 32) {
+        std::uint64_t v1 = seed + kPrime1 + kPrime2;
+        std::uint64_t v2 = seed + kPrime2;
+        std::uint64_t v3 = seed;
+        std::uint64_t v4 = seed - kPrime1;
+        
+        // Four independent lanes of 8 bytes each per 32-byte stripe
+        for (; end - p >= 32; p += 32) {
+            v1 = hashRound(v1, read64(p));
+            v2 = hashRound(v2, read64(p + 8));
+            v3 = hashRound(v3, read64(p + 16));
+            v4 = hashRound(v4, read64(p + 24));
+        }
+        
+        hash = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+        hash = mergeRound(hash, v1);
+        hash = mergeRound(hash, v2);
+        hash = mergeRound(hash, v3);
+        hash = mergeRound(hash, v4);
+    } else {
+        hash = seed + kPrime5;
     }
-    ss << "-";
     
-    ss << dis2(gen);
+    hash += static_cast<std::uint64_t>(data.size());
     
-    for (int i = 0; i < 3; i++) {
-        ss << dis(gen);
+    for (; end - p >= 8; p += 8) {
+        hash ^= hashRound(0, read64(p));
+        hash = rotateLeft(hash, 27) * kPrime1 + kPrime4;
     }
-    ss << "-";
-    
-    for (int i = 0; i < 12; i++) {
-        ss << dis(gen);
+    if (end - p >= 4) {
+        hash ^= read32(p) * kPrime1;
+        hash = rotateLeft(hash, 23) * kPrime2 + kPrime3;
+        p += 4;
+    }
+    for (; p < end; p++) {
+        hash ^= *p * kPrime5;
+        hash = rotateLeft(hash, 11) * kPrime1;
     }
     
-    return ss.str();
+    // Final avalanche
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    hash *= kPrime3;
+    hash ^= hash >> 32;
+    return hash;
 }
 
-std::string calculateHash(const std::string& input) {
+std::string calculateHash(std::string_view input) {
     if (input.empty()) {
         return "";
     }
     
-    // Simple hash function for demonstration purposes
-    // In a real implementation, use a cryptographic hash function
-    std::hash<std::string> hasher;
-    size_t hashValue = hasher(input);
+    static constexpr char kHexDigits[] = "0123456789abcdef";
+    std::uint64_t hashValue = hashBytes(input);
     
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0') << std::setw(16) << hashValue;
-    return ss.str();
+    std::string hex(16, '0');
+    for (int i = 15; i >= 0; i--) {
+        hex[i] = kHexDigits[hashValue & 0xf];
+        hashValue >>= 4;
+    }
+    return hex;
 }
 
 bool validateBitcoinAddress(const std::string& address) {
-    // Simple validation for demonstration purposes
-    // In a real implementation, use proper Bitcoin address validation
-    
-    // Check length (typical Bitcoin address is 25-34 characters)
-    if (address.length() < 25 || address.length() > 34) {
+    // Direct-mapped cache of recent results; addresses are at most 90 characters
+    struct CachedAddress {
+        std::uint8_t length = 0;
+        bool valid = false;
+        char text[90];
+    };
+    constexpr std::size_t kCacheSize = 64;
+    thread_local std::array<CachedAddress, kCacheSize> cache;
+
+    if (address.empty() || address.size() > sizeof(CachedAddress::text)) {
         return false;
     }
-    
-    // Check that it starts with 1, 3, or bc1
-    if (!(address[0] == '1' || address[0] == '3' || address.substr(0, 3) == "bc1")) {
-        return false;
+
+    CachedAddress& entry = cache[hashBytes(address) % kCacheSize];
+    if (entry.length == address.size() && std::memcmp(entry.text, address.data(), address.size()) == 0) {
+        return entry.valid;
+    }
+
+    entry.valid = parseBitcoinAddress(address).has_value();
+    entry.length = static_cast<std::uint8_t>(address.size());
+    std::memcpy(entry.text, address.data(), address.size());
+    return entry.valid;
+}
+
+namespace {
+
+bool isMetadataSpace(char c) {
+    return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+bool isMetadataWordChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_';
+}
+
+/**
+ * @brief Match "*\s*@(\w+)\s*:\s*([^*]+)" at the leftmost possible position
+ * @param line The line to search
+ * @param key Receives the metadata key
+ * @param value Receives the untrimmed value
+ * @return True if the line contains metadata
+ */
+bool matchMetadata(std::string_view line, std::string_view& key, std::string_view& value) {
+    for (std::size_t star = line.find('*'); star != std::string_view::npos; star = line.find('*', star + 1)) {
+        std::size_t pos = star + 1;
+        while (pos < line.size() && isMetadataSpace(line[pos])) {
+            pos++;
+        }
+        if (pos >= line.size() || line[pos] != '@') {
+            continue;
+        }
+        
+        const std::size_t keyStart = ++pos;
+        while (pos < line.size() && isMetadataWordChar(line[pos])) {
+            pos++;
+        }
+        if (pos == keyStart) {
+            continue;
+        }
+        key = line.substr(keyStart, pos - keyStart);
+        
+        while (pos < line.size() && isMetadataSpace(line[pos])) {
+            pos++;
+        }
+        if (pos >= line.size() || line[pos] != ':') {
+            continue;
+        }
+        
+        // The value runs up to the next '*' and must not be empty
+        const std::size_t valueStart = pos + 1;
+        const std::size_t valueEnd = std::min(line.find('*', valueStart), line.size());
+        if (valueEnd == valueStart) {
+            continue;
+        }
+        value = line.substr(valueStart, valueEnd - valueStart);
+        return true;
     }
     
-    // Check that it only contains valid characters
-    std::regex validChars("^[a-zA-Z0-9]+$");
-    return std::regex_match(address, validChars);
+    return false;
 }
 
+} // namespace
+
 std::unordered_map<std::string, std::string> parseCodeMetadata(const std::filesystem::path& filePath) {
-    std::unordered_map<std::string, std::string> metadata;
-    
-    // Open the file
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-        return metadata;
+    std::optional<SourceFile> file = SourceFile::open(filePath);
+    if (!file) {
+        return {};
     }
     
+    return parseCodeMetadata(*file);
+}
+
+std::unordered_map<std::string, std::string> parseCodeMetadata(const SourceFile& file) {
+    std::unordered_map<std::string, std::string> metadata;
+    
     // Read the first few lines to look for metadata
-    std::string line;
-    int lineCount = 0;
-    const int maxLinesToCheck = 20;
+    const std::size_t maxLinesToCheck = 20;
+    const std::size_t lineCount = std::min(file.getLineCount(), maxLinesToCheck);
     
-    while (std::getline(file, line) && lineCount < maxLinesToCheck) {
-        lineCount++;
-        
+    for (std::size_t line = 0; line < lineCount; line++) {
         // Look for metadata in comments
-        std::smatch matches;
-        std::regex metadataRegex(R"(\*\s*@(\w+)\s*:\s*([^*]+))");
+        std::string_view key;
+        std::string_view value;
         
-        if (std::regex_search(line, matches, metadataRegex) && matches.size() > 2) {
-            std::string key = matches[1].str();
-            std::string value = matches[2].str();
-            
+        if (matchMetadata(file.getLine(line), key, value)) {
             // Trim whitespace
-            value.erase(0, value.find_first_not_of(" \t\r\n"));
-            value.erase(value.find_last_not_of(" \t\r\n") + 1);
+            const std::size_t first = value.find_first_not_of(" \t\r\n");
+            value = first == std::string_view::npos ? std::string_view() : value.substr(first);
+            value = value.substr(0, value.find_last_not_of(" \t\r\n") + 1);
             
-            metadata[key] = value;
+            metadata[std::string(key)] = std::string(value);
         }
     }
     
@@ -130,33 +352,27 @@ std::optional<std::string> readCodeFromFile(
     int startLine,
     int endLine
 ) {
+    CCSL_PROBE(probe, Probe::READ_CODE_FROM_FILE, 0);
+    
     // Validate input
     if (startLine < 0 || endLine < startLine) {
         return std::nullopt;
     }
     
     // Open the file
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
+    std::optional<SourceFile> file = SourceFile::open(filePath);
+    if (!file) {
         return std::nullopt;
     }
     
-    // Read the lines
-    std::string line;
-    std::stringstream codeStream;
-    int currentLine = 0;
-    
-    while (std::getline(file, line)) {
-        if (currentLine >= startLine && currentLine <= endLine) {
-            codeStream << line << '\n';
-        } else if (currentLine > endLine) {
-            break;
-        }
-        
-        currentLine++;
+    // Every returned line ends with a newline, even the last line of the file
+    std::string code(file->getLines(static_cast<std::size_t>(startLine), static_cast<std::size_t>(endLine)));
+    if (!code.empty() && code.back() != '\n') {
+        code += '\n';
     }
+    CCSL_PROBE_ADD_BYTES(probe, code.size());
     
-    return codeStream.str();
+    return code;
 }
 
 double normalizeValue(double value, double min, double max) {
@@ -172,9 +388,15 @@ double normalizeValue(double value, double min, double max) {
 }
 
 std::string formatBitcoinAmount(double amount) {
-    std::stringstream ss;
-    ss << std::fixed << std::setprecision(8) << amount;
-    return ss.str();
+    // Enough for any double with 8 decimals
+    char buffer[330];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), amount, std::chars_format::fixed, 8);
+    return std::string(buffer, result.ptr);
+}
+
+std::string formatBitcoinAmount(Satoshis amount) {
+    char buffer[kMaxBitcoinAmountChars];
+    return std::string(buffer, formatSatoshis(amount, buffer));
 }
 
 std::string formatTimestamp(const std::chrono::system_clock::time_point& timestamp) {
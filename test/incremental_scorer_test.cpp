@@ -0,0 +1,246 @@
+/**
+ * @file incremental_scorer_test.cpp
+ * @brief Test cases for diff parsing and incremental contribution scoring
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/diff.hpp>
+#include <ccsl/incremental_scorer.hpp>
+#include <ccsl/license.hpp>
+#include "test_framework.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+using namespace ccsl;
+using namespace ccsl::test;
+
+namespace {
+
+bool sameHunk(const DiffHunk& hunk, int oldStart, int oldCount, int newStart, int newCount) {
+    return hunk.oldStart == oldStart && hunk.oldCount == oldCount &&
+           hunk.newStart == newStart && hunk.newCount == newCount;
+}
+
+const CodeContribution* findContribution(const License& license, const std::string& fileId, int lineStart) {
+    for (const CodeContribution& contribution : license.getContributions()) {
+        if (contribution.getFileId() == fileId && contribution.getLineRange().first == lineStart) {
+            return &contribution;
+        }
+    }
+    return nullptr;
+}
+
+License makeLicense() {
+    License license("Test Project", "CCSL-1234-5678");
+    license.registerContribution(CodeContribution("Alice", "a.cpp", 0, 1));
+    license.registerContribution(CodeContribution("Bob", "a.cpp", 2, 4));
+    license.registerContribution(CodeContribution("Carol", "a.cpp", 6, 8));
+    license.registerContribution(CodeContribution("Dave", "a.cpp", 10, 12));
+    license.registerContribution(CodeContribution("Eve", "a.cpp", 20, 25));
+    license.registerContribution(CodeContribution("Frank", "other.cpp", 0, 5));
+    return license;
+}
+
+// Replaces line 3 with three lines, inserts a line before line 9 and two inside Eve's range
+FileDiff makeDiff() {
+    return FileDiff{"a.cpp", "a.cpp", {{3, 1, 3, 3}, {9, 0, 11, 1}, {21, 0, 24, 2}}};
+}
+
+std::vector<std::pair<int, int>> ranges(std::initializer_list<std::pair<int, int>> list) {
+    return list;
+}
+
+} // namespace
+
+void testParseUnifiedDiff() {
+    std::cout << "Testing parseUnifiedDiff...\n";
+
+    const std::string text =
+        "diff --git a/src/a.cpp b/src/a.cpp\n"
+        "index 1111111..2222222 100644\n"
+        "--- a/src/a.cpp\n"
+        "+++ b/src/a.cpp\n"
+        "@@ -2,4 +2,5 @@ int f()\n"
+        " context\n"
+        "-removed\n"
+        "+added\n"
+        "+added\n"
+        " context\n"
+        "\n"
+        "@@ -10,0 +12,2 @@\n"
+        "+x\n"
+        "+y\n"
+        "\\ No newline at end of file\n"
+        "diff --git a/old.cpp b/new.cpp\n"
+        "similarity index 100%\n"
+        "rename from old.cpp\n"
+        "rename to new.cpp\n"
+        "diff --git a/gone.cpp b/gone.cpp\n"
+        "deleted file mode 100644\n"
+        "--- a/gone.cpp\n"
+        "+++ /dev/null\n"
+        "@@ -1,2 +0,0 @@\n"
+        "--- a removed line that looks like a header\n"
+        "-b\n"
+        "--- /dev/null\t2025-01-01 00:00:00\n"
+        "+++ created.cpp\t2025-01-01 00:00:00\n"
+        "@@ -0,0 +1 @@\r\n"
+        "+int main() {}\r\n";
+
+    std::vector<FileDiff> files = parseUnifiedDiff(text);
+    Assert::areEqual(files.size(), size_t(4));
+
+    Assert::areEqual(files[0].oldPath, std::string("src/a.cpp"));
+    Assert::areEqual(files[0].newPath, std::string("src/a.cpp"));
+    Assert::areEqual(files[0].hunks.size(), size_t(2));
+    Assert::isTrue(sameHunk(files[0].hunks[0], 2, 1, 2, 2));
+    Assert::isTrue(sameHunk(files[0].hunks[1], 10, 0, 11, 2));
+
+    Assert::areEqual(files[1].oldPath, std::string("old.cpp"));
+    Assert::areEqual(files[1].newPath, std::string("new.cpp"));
+    Assert::isTrue(files[1].hunks.empty());
+
+    Assert::isTrue(files[2].isDeleted());
+    Assert::areEqual(files[2].oldPath, std::string("gone.cpp"));
+    Assert::areEqual(files[2].hunks.size(), size_t(1));
+    Assert::isTrue(sameHunk(files[2].hunks[0], 0, 2, 0, 0));
+
+    Assert::isTrue(files[3].isNew());
+    Assert::areEqual(files[3].newPath, std::string("created.cpp"));
+    Assert::areEqual(files[3].hunks.size(), size_t(1));
+    Assert::isTrue(sameHunk(files[3].hunks[0], 0, 0, 0, 1));
+
+    Assert::isTrue(parseUnifiedDiff("").empty());
+    Assert::throws<std::invalid_argument>([] {
+        parseUnifiedDiff("--- a/x\n+++ b/x\n@@ -1,x +1 @@\n");
+    });
+    Assert::throws<std::invalid_argument>([] {
+        parseUnifiedDiff("--- a/x\n+++ b/x\n@@ -1,3 +1,3 @@\n a\n");
+    });
+    Assert::throws<std::invalid_argument>([] {
+        parseUnifiedDiff("--- a/x\n+++ b/x\n@@ -1 +1 @@\n+a\n+b\n");
+    });
+}
+
+void testApplyDiff() {
+    std::cout << "Testing License::applyDiff...\n";
+
+    // Touched contributions are dropped; the others move with the lines above them
+    License license = makeLicense();
+    DiffEffect effect = license.applyDiff(makeDiff());
+    Assert::areEqual(effect.shifted, size_t(2));
+    Assert::areEqual(effect.removed, size_t(2));
+    Assert::isTrue(effect.dirtyRanges == ranges({{3, 5}, {11, 11}, {24, 25}}));
+    Assert::areEqual(license.getContributions().size(), size_t(4));
+    Assert::isNotNull(findContribution(license, "a.cpp", 0));
+    Assert::isTrue(findContribution(license, "a.cpp", 8)->getLineRange() == std::make_pair(8, 10));
+    Assert::areEqual(findContribution(license, "a.cpp", 8)->getContributor(), std::string("Carol"));
+    Assert::isTrue(findContribution(license, "a.cpp", 13)->getLineRange() == std::make_pair(13, 15));
+    Assert::isNotNull(findContribution(license, "other.cpp", 0));
+
+    // The index follows the moved lines
+    Assert::isFalse(license.registerContribution(CodeContribution("Grace", "a.cpp", 9, 9)));
+    Assert::isTrue(license.registerContribution(CodeContribution("Grace", "a.cpp", 6, 7)));
+    Assert::isTrue(license.registerContribution(CodeContribution("Grace", "a.cpp", 3, 5)));
+
+    // Merging leaves the remaining lines of touched contributions to score with the change
+    License merged = makeLicense();
+    effect = merged.applyDiff(makeDiff(), OverlapPolicy::MERGE);
+    Assert::areEqual(effect.removed, size_t(2));
+    Assert::isTrue(effect.dirtyRanges == ranges({{2, 6}, {11, 11}, {23, 30}}));
+
+    // A contribution inside a deleted block leaves nothing behind to merge
+    License deleted("Test Project", "CCSL-1234-5678");
+    deleted.registerContribution(CodeContribution("Alice", "a.cpp", 2, 3));
+    effect = deleted.applyDiff(FileDiff{"a.cpp", "a.cpp", {{1, 4, 1, 0}}}, OverlapPolicy::MERGE);
+    Assert::areEqual(effect.removed, size_t(1));
+    Assert::isTrue(effect.dirtyRanges.empty());
+
+    // Renames move every contribution; deletes remove them
+    effect = license.applyDiff(FileDiff{"a.cpp", "b.cpp", {}});
+    Assert::areEqual(effect.shifted, size_t(0));
+    Assert::isTrue(effect.dirtyRanges.empty());
+    Assert::isNull(findContribution(license, "a.cpp", 0));
+    Assert::areEqual(findContribution(license, "b.cpp", 8)->getFileId(), std::string("b.cpp"));
+    Assert::isTrue(license.registerContribution(CodeContribution("Heidi", "a.cpp", 0, 1)));
+    Assert::isFalse(license.registerContribution(CodeContribution("Heidi", "b.cpp", 0, 1)));
+
+    effect = license.applyDiff(FileDiff{"b.cpp", "", {}});
+    Assert::areEqual(effect.removed, size_t(5));
+    Assert::areEqual(license.getContributions().size(), size_t(2));
+    Assert::isNotNull(findContribution(license, "other.cpp", 0));
+    Assert::isNotNull(findContribution(license, "a.cpp", 0));
+    Assert::isTrue(license.registerContribution(CodeContribution("Ivan", "b.cpp", 0, 100)));
+}
+
+void testIncrementalScorer() {
+    std::cout << "Testing IncrementalScorer...\n";
+
+    std::filesystem::path root = std::filesystem::temp_directory_path() / "ccsl_incremental_test";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+    {
+        std::ofstream file(root / "main.cpp", std::ios::binary);
+        file << "#include <cstdio>\n"
+                "\n"
+                "// Prints a greeting\n"
+                "void greet() { std::puts(\"hello\"); }\n"
+                "\n"
+                "int main() {\n"
+                "    return 0;\n"
+                "}\n";
+    }
+
+    License license("Test Project", "CCSL-1234-5678");
+    license.registerContribution(CodeContribution("Alice", "main.cpp", 0, 1));
+    license.registerContribution(CodeContribution("Alice", "main.cpp", 4, 5));
+
+    const std::string diff =
+        "--- a/main.cpp\n"
+        "+++ b/main.cpp\n"
+        "@@ -2,2 +2,4 @@\n"
+        " \n"
+        "+// Prints a greeting\n"
+        "+void greet() { std::puts(\"hello\"); }\n"
+        " \n"
+        "--- /dev/null\n"
+        "+++ b/absent.cpp\n"
+        "@@ -0,0 +1 @@\n"
+        "+int absent;\n";
+
+    EvaluationCache cache;
+    IncrementalScorer scorer(OverlapPolicy::DROP, &cache);
+    IncrementalResult result = scorer.apply(license, diff, "Bob", root);
+
+    Assert::areEqual(result.files, size_t(2));
+    Assert::areEqual(result.shifted, size_t(1));
+    Assert::areEqual(result.removed, size_t(0));
+    Assert::areEqual(result.added, size_t(1));
+    Assert::areEqual(result.scoredLines, size_t(2));
+    Assert::areEqual(result.missingFiles.size(), size_t(1));
+    Assert::areEqual(result.missingFiles[0], std::string("absent.cpp"));
+    Assert::areEqual(cache.getMisses(), size_t(1));
+
+    const CodeContribution* added = findContribution(license, "main.cpp", 2);
+    Assert::isNotNull(added);
+    Assert::areEqual(added->getContributor(), std::string("Bob"));
+    Assert::isTrue(added->getLineRange() == std::make_pair(2, 3));
+    Assert::areEqual(added->getMetricScores().size(), size_t(kMetricTypeCount));
+    Assert::isTrue(findContribution(license, "main.cpp", 6)->getLineRange() == std::make_pair(6, 7));
+
+    Assert::throws<std::invalid_argument>([&] { scorer.apply(license, diff, "", root); });
+
+    std::filesystem::remove_all(root);
+}
+
+int main() {
+    TestRunner runner;
+
+    runner.addTest("ParseUnifiedDiff", testParseUnifiedDiff);
+    runner.addTest("ApplyDiff", testApplyDiff);
+    runner.addTest("IncrementalScorer", testIncrementalScorer);
+
+    return runner.runAll();
+}
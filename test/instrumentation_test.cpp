@@ -0,0 +1,131 @@
+/**
+ * @file instrumentation_test.cpp
+ * @brief Test cases for the CCSL instrumentation probes and exporters
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/instrumentation.hpp>
+#include <ccsl/metrics.hpp>
+#include <ccsl/utility.hpp>
+#include "test_framework.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using namespace ccsl;
+using namespace ccsl::test;
+
+void testRecord() {
+    std::cout << "Testing Instrumentation::record...\n";
+
+    Instrumentation& instrumentation = Instrumentation::get();
+    instrumentation.reset();
+
+    auto now = std::chrono::steady_clock::now();
+    instrumentation.record(Probe::SEND_PAYMENT, now, 500, 10, 2);
+    instrumentation.record(Probe::SEND_PAYMENT, now, 3000, 20, 0);
+    instrumentation.record(Probe::SEND_PAYMENT, now, 20000000000ULL, 0, 1);
+
+    ProbeStats stats = instrumentation.getStats(Probe::SEND_PAYMENT);
+    Assert::areEqual(stats.calls, std::uint64_t(3));
+    Assert::areEqual(stats.nanoseconds, std::uint64_t(20000003500ULL));
+    Assert::areEqual(stats.bytes, std::uint64_t(30));
+    Assert::areEqual(stats.allocations, std::uint64_t(3));
+    Assert::areEqual(stats.latency[0], std::uint64_t(1));  // <= 1us
+    Assert::areEqual(stats.latency[2], std::uint64_t(1));  // <= 5us
+    Assert::areEqual(stats.latency.back(), std::uint64_t(1));
+
+    Assert::areEqual(instrumentation.getStats(Probe::SCAN_SOURCE).calls, std::uint64_t(0));
+    Assert::areEqual(std::string(probeName(evaluateProbe(MetricType::NOVELTY))), std::string("evaluate_novelty"));
+
+    std::string text = instrumentation.toPrometheus();
+    Assert::isTrue(text.find("# TYPE ccsl_call_duration_seconds histogram\n") != std::string::npos);
+    Assert::isTrue(text.find("ccsl_call_duration_seconds_bucket{probe=\"send_payment\",le=\"1e-06\"} 1\n") != std::string::npos);
+    Assert::isTrue(text.find("ccsl_call_duration_seconds_bucket{probe=\"send_payment\",le=\"5e-06\"} 2\n") != std::string::npos);
+    Assert::isTrue(text.find("ccsl_call_duration_seconds_bucket{probe=\"send_payment\",le=\"+Inf\"} 3\n") != std::string::npos);
+    Assert::isTrue(text.find("ccsl_call_duration_seconds_count{probe=\"send_payment\"} 3\n") != std::string::npos);
+    Assert::isTrue(text.find("ccsl_processed_bytes_total{probe=\"send_payment\"} 30\n") != std::string::npos);
+    Assert::isTrue(text.find("ccsl_allocations_total{probe=\"send_payment\"} 3\n") != std::string::npos);
+
+    instrumentation.reset();
+    Assert::areEqual(instrumentation.getStats(Probe::SEND_PAYMENT).calls, std::uint64_t(0));
+}
+
+void testChromeTrace() {
+    std::cout << "Testing Instrumentation Chrome trace...\n";
+
+    Instrumentation& instrumentation = Instrumentation::get();
+    instrumentation.reset();
+
+    // Calls are only kept as events while tracing, and only up to the limit
+    auto now = std::chrono::steady_clock::now();
+    instrumentation.record(Probe::SCAN_SOURCE, now, 1000, 1, 0);
+    instrumentation.setTracing(true, 2);
+    for (int i = 0; i < 3; i++) {
+        instrumentation.record(Probe::SCAN_SOURCE, now, 1500, 64, 1);
+    }
+    instrumentation.setTracing(false);
+    Assert::areEqual(instrumentation.getTraceEventCount(), size_t(2));
+    Assert::areEqual(instrumentation.getStats(Probe::SCAN_SOURCE).calls, std::uint64_t(4));
+
+    std::string trace = instrumentation.toChromeTrace();
+    Assert::isTrue(trace.rfind("{\"traceEvents\":[", 0) == 0);
+    Assert::isTrue(trace.find("\"name\":\"scan_source\",\"cat\":\"ccsl\",\"ph\":\"X\"") != std::string::npos);
+    Assert::isTrue(trace.find("\"dur\":1.500") != std::string::npos);
+    Assert::isTrue(trace.find("\"args\":{\"bytes\":64,\"allocations\":1}") != std::string::npos);
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "ccsl_instrumentation_test.json";
+    Assert::isTrue(instrumentation.writeChromeTrace(path));
+    std::ifstream file(path, std::ios::binary);
+    std::string written((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    Assert::areEqual(written, trace);
+    std::filesystem::remove(path);
+
+    instrumentation.reset();
+    Assert::areEqual(instrumentation.getTraceEventCount(), size_t(0));
+}
+
+void testProbes() {
+    std::cout << "Testing instrumentation probes...\n";
+
+    Instrumentation& instrumentation = Instrumentation::get();
+    instrumentation.reset();
+
+    const std::string code = "int main() {\n    if (x) { f(); }\n    return 0;\n}\n";
+    MetricsEvaluator evaluator;
+    evaluator.evaluateScores(code);
+
+    // The probes only record anything when compiled in
+    const std::uint64_t expected = Instrumentation::kEnabled ? 1 : 0;
+    ProbeStats scan = instrumentation.getStats(Probe::SCAN_SOURCE);
+    Assert::areEqual(scan.calls, expected);
+    Assert::areEqual(scan.bytes, expected * code.size());
+    for (std::size_t i = 0; i < kMetricTypeCount; i++) {
+        ProbeStats stats = instrumentation.getStats(evaluateProbe(static_cast<MetricType>(i)));
+        Assert::areEqual(stats.calls, expected);
+        Assert::areEqual(stats.bytes, expected * code.size());
+    }
+
+    if (Instrumentation::kEnabled) {
+        std::uint64_t before = Instrumentation::getThreadAllocations();
+        int* volatile allocated = new int(0);
+        delete allocated;
+        std::uint64_t after = Instrumentation::getThreadAllocations();
+        Assert::areEqual(after, before + 1);
+    } else {
+        Assert::areEqual(Instrumentation::getThreadAllocations(), std::uint64_t(0));
+    }
+
+    instrumentation.reset();
+}
+
+int main() {
+    TestRunner runner;
+
+    runner.addTest("Record", testRecord);
+    runner.addTest("ChromeTrace", testChromeTrace);
+    runner.addTest("Probes", testProbes);
+
+    return runner.runAll();
+}
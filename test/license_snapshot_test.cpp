@@ -0,0 +1,144 @@
+/**
+ * @file license_snapshot_test.cpp
+ * @brief Test cases for the CCSL license snapshot
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/license_snapshot.hpp>
+#include "test_framework.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+using namespace ccsl;
+using namespace ccsl::test;
+
+namespace {
+
+License makeLicense() {
+    License license("Test Project", "CCSL-1234-5678");
+
+    CodeContribution scored("Alice", "main.cpp", 10, 20);
+    MetricScores scores;
+    scores.set(MetricType::IMPACT, 0.75, {3.0, 4.0, 0.0});
+    scores.set(MetricType::NOVELTY, 0.25, {1.0, 2.0, 5.0});
+    scored.setMetricScores(scores);
+    license.registerContribution(scored);
+
+    license.registerContribution(CodeContribution("Bob", "main.cpp", 30, 40));
+    license.registerContribution(CodeContribution("Alice", "util.cpp", 0, 5));
+    license.registerContribution(CodeContribution("Carol", "main.cpp", 0, 9));
+
+    license.getPaymentManager().recordPayment(scored, Satoshis(150000));
+    license.getPaymentManager().recordPayment(CodeContribution("Bob", "main.cpp", 30, 40), Satoshis(2500));
+    return license;
+}
+
+} // namespace
+
+void testSnapshotQueries() {
+    std::cout << "Testing LicenseSnapshot queries...\n";
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "ccsl_license_snapshot_test.bin";
+    Assert::isTrue(LicenseSnapshot::write(makeLicense(), path));
+
+    std::optional<LicenseSnapshot> snapshot = LicenseSnapshot::open(path);
+    Assert::isTrue(snapshot.has_value());
+    Assert::areEqual(snapshot->getProjectName(), std::string_view("Test Project"));
+    Assert::areEqual(snapshot->getLicenseKey(), std::string_view("CCSL-1234-5678"));
+    Assert::areEqual(snapshot->getContributionCount(), size_t(4));
+
+    // Contributions keep their registration order, strings and scores
+    SnapshotContribution first = snapshot->getContribution(0);
+    Assert::areEqual(first.contributor, std::string_view("Alice"));
+    Assert::areEqual(first.fileId, std::string_view("main.cpp"));
+    Assert::areEqual(first.lineStart, 10);
+    Assert::areEqual(first.lineEnd, 20);
+    Assert::isTrue(first.scores.has(MetricType::IMPACT));
+    Assert::isFalse(first.scores.has(MetricType::CLEANNESS));
+    Assert::areEqual(first.scores.counts[metricIndex(MetricType::NOVELTY)][2], 5.0);
+    Assert::areEqual(first.calculateValue(), 0.5);
+    Assert::areEqual(snapshot->getContribution(3).contributor, std::string_view("Carol"));
+    Assert::throws<std::out_of_range>([&] { snapshot->getContribution(4); });
+
+    // The interval index answers line lookups and overlap checks in place
+    Assert::areEqual(snapshot->findContribution("main.cpp", 35)->contributor, std::string_view("Bob"));
+    Assert::areEqual(snapshot->findContribution("main.cpp", 0)->contributor, std::string_view("Carol"));
+    Assert::isFalse(snapshot->findContribution("main.cpp", 25).has_value());
+    Assert::isFalse(snapshot->findContribution("main.cpp", 41).has_value());
+    Assert::isFalse(snapshot->findContribution("missing.cpp", 0).has_value());
+    Assert::isTrue(snapshot->overlaps("main.cpp", 15, 25));
+    Assert::isTrue(snapshot->overlaps("main.cpp", 21, 50));
+    Assert::isFalse(snapshot->overlaps("main.cpp", 21, 29));
+    Assert::isFalse(snapshot->overlaps("util.cpp", 6, 100));
+
+    Assert::areEqual(snapshot->getContributorTotal("Alice"), Satoshis(150000));
+    Assert::areEqual(snapshot->getContributorTotal("Bob"), Satoshis(2500));
+    Assert::areEqual(snapshot->getContributorTotal("Dave"), Satoshis(0));
+    Assert::areEqual(snapshot->getTotalPayments(), Satoshis(152500));
+
+    // Moving keeps the mapping alive
+    LicenseSnapshot moved = std::move(*snapshot);
+    Assert::areEqual(moved.getContributionCount(), size_t(4));
+
+    std::filesystem::remove(path);
+}
+
+void testSnapshotToLicense() {
+    std::cout << "Testing LicenseSnapshot::toLicense...\n";
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "ccsl_license_snapshot_reopen.bin";
+    License original = makeLicense();
+    Assert::isTrue(LicenseSnapshot::write(original, path));
+
+    License license = LicenseSnapshot::open(path)->toLicense();
+    Assert::areEqual(license.getLicenseInfo(), original.getLicenseInfo());
+    Assert::areEqual(license.getPaymentManager().getTotalPayments(), Satoshis(152500));
+    Assert::areEqual(license.getPaymentManager().getContributorTotal("Alice"), Satoshis(150000));
+
+    // The rebuilt index still rejects overlaps and accepts free ranges
+    Assert::isFalse(license.registerContribution(CodeContribution("Dave", "main.cpp", 5, 12)));
+    Assert::isTrue(license.registerContribution(CodeContribution("Dave", "main.cpp", 21, 29)));
+    Assert::areEqual(license.getContributions().size(), size_t(5));
+
+    std::filesystem::remove(path);
+}
+
+void testSnapshotRejectsDamage() {
+    std::cout << "Testing LicenseSnapshot validation...\n";
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "ccsl_license_snapshot_damaged.bin";
+    Assert::isFalse(LicenseSnapshot::open(path.string() + ".missing").has_value());
+
+    // An empty license still makes a valid snapshot
+    Assert::isTrue(LicenseSnapshot::write(License("Empty", "CCSL-0000-0000"), path));
+    std::optional<LicenseSnapshot> empty = LicenseSnapshot::open(path);
+    Assert::isTrue(empty.has_value());
+    Assert::areEqual(empty->getContributionCount(), size_t(0));
+    Assert::isFalse(empty->overlaps("main.cpp", 0, 100));
+
+    Assert::isTrue(LicenseSnapshot::write(makeLicense(), path));
+    const std::uintmax_t size = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, size - 1);
+    Assert::isFalse(LicenseSnapshot::open(path).has_value());
+
+    Assert::isTrue(LicenseSnapshot::write(makeLicense(), path));
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.put('X');
+    }
+    Assert::isFalse(LicenseSnapshot::open(path).has_value());
+
+    std::filesystem::remove(path);
+}
+
+int main() {
+    TestRunner runner;
+
+    runner.addTest("SnapshotQueries", testSnapshotQueries);
+    runner.addTest("SnapshotToLicense", testSnapshotToLicense);
+    runner.addTest("SnapshotRejectsDamage", testSnapshotRejectsDamage);
+
+    return runner.runAll();
+}
@@ -5,7 +5,14 @@
  */
 
 #include <ccsl/license.hpp>
+#include <ccsl/utility.hpp>
 #include "test_framework.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory_resource>
+#include <iomanip>
+#include <sstream>
 
 using namespace ccsl;
 using namespace ccsl::test;
@@ -76,6 +83,38 @@ void testCodeContribution() {
     Assert::areEqual(contribution.calculateValue(), 0.9);
 }
 
+void testMetricScores() {
+    std::cout << "Testing MetricScores...\n";
+    
+    CodeContribution contribution("Alice", "main.cpp", 10, 20);
+    
+    MetricEvaluation eval;
+    eval.type = MetricType::IMPACT;
+    eval.value = 0.75;
+    eval.rationale = "High impact code";
+    contribution.addMetricEvaluation(eval);
+    
+    eval.type = MetricType::SIMPLICITY;
+    eval.value = 0.5;
+    contribution.addMetricEvaluation(eval);
+    
+    // Evaluations are mirrored into the compact scores
+    Assert::isTrue(contribution.getMetricScores().has(MetricType::IMPACT));
+    Assert::isFalse(contribution.getMetricScores().has(MetricType::NOVELTY));
+    
+    // Set compact scores without rationales
+    MetricScores scores;
+    scores.set(MetricType::SIMPLICITY, 0.25);
+    scores.set(MetricType::NOVELTY, 0.5);
+    contribution.setMetricScores(scores);
+    
+    // The superseded simplicity evaluation is dropped; impact is kept
+    Assert::areEqual(contribution.getMetricEvaluations().size(), size_t(1));
+    Assert::areEqual(contribution.getMetricScores().size(), size_t(3));
+    Assert::areEqual(contribution.getMetricScores().get(MetricType::SIMPLICITY), 0.25);
+    Assert::areEqual(contribution.calculateValue(), (0.75 + 0.25 + 0.5) / 3);
+}
+
 void testPaymentManager() {
     std::cout << "Testing PaymentManager...\n";
     
@@ -138,6 +177,14 @@ void testLicense() {
     CodeContribution overlapping("Dave", "api.cpp", 150, 250);
     Assert::isFalse(license.registerContribution(overlapping));
     
+    // Test contribution that fully contains an existing one
+    CodeContribution containing("Dave", "api.cpp", 50, 250);
+    Assert::isFalse(license.registerContribution(containing));
+    
+    // Test contribution fully inside an existing one
+    CodeContribution contained("Dave", "api.cpp", 120, 130);
+    Assert::isFalse(license.registerContribution(contained));
+    
     // Test non-overlapping contribution
     CodeContribution nonOverlapping("Eve", "api.cpp", 201, 300);
     Assert::isTrue(license.registerContribution(nonOverlapping));
@@ -153,12 +200,229 @@ void testLicense() {
     Assert::isTrue(info.find("Contributor: Eve") != std::string::npos);
 }
 
+void testRegisterContributions() {
+    std::cout << "Testing License::registerContributions...\n";
+    
+    License license("Test Project", "CCSL-1234-5678");
+    Assert::isTrue(license.registerContribution(CodeContribution("Carol", "api.cpp", 100, 200)));
+    
+    std::vector<CodeContribution> batch = {
+        CodeContribution("Eve", "api.cpp", 300, 400),
+        CodeContribution("Dave", "api.cpp", 150, 160),   // Inside an existing range
+        CodeContribution("Frank", "api.cpp", 201, 299),
+        CodeContribution("Grace", "main.cpp", 1, 50),
+        CodeContribution("Heidi", "api.cpp", 350, 450),  // Overlaps Eve in the same batch
+        CodeContribution("Ivan", "main.cpp", 51, 60)
+    };
+    
+    Assert::areEqual(license.registerContributions(batch), size_t(4));
+    Assert::areEqual(license.getContributions().size(), size_t(5));
+    
+    // The index stays consistent with single registration
+    Assert::isFalse(license.registerContribution(CodeContribution("Judy", "main.cpp", 40, 45)));
+    Assert::isTrue(license.registerContribution(CodeContribution("Judy", "main.cpp", 61, 70)));
+    Assert::areEqual(license.registerContributions({}), size_t(0));
+    
+    // Moving and emplacing register the same way as copying
+    CodeContribution moved("Mallory", "util.cpp", 0, 10);
+    moved.addMetricEvaluation({MetricType::IMPACT, 0.5, "Medium impact"});
+    Assert::isTrue(license.registerContribution(std::move(moved)));
+    Assert::areEqual(license.getContributions().back().getMetricEvaluations().size(), size_t(1));
+    Assert::isTrue(license.emplaceContribution("Niaj", "util.cpp", 11, 20));
+    Assert::isFalse(license.emplaceContribution("Olivia", "util.cpp", 5, 15));
+    Assert::areEqual(license.getContributions().back().getContributor(), std::string("Niaj"));
+    Assert::throws<std::invalid_argument>([&] { license.emplaceContribution("", "util.cpp", 30, 40); });
+    
+    std::vector<CodeContribution> owned = {
+        CodeContribution("Peggy", "util.cpp", 21, 30),
+        CodeContribution("Rupert", "util.cpp", 25, 35)  // Overlaps Peggy
+    };
+    Assert::areEqual(license.registerContributions(std::move(owned)), size_t(1));
+    Assert::areEqual(license.getContributions().size(), size_t(9));
+    Assert::isFalse(license.registerContribution(CodeContribution("Sybil", "util.cpp", 30, 30)));
+}
+
+namespace {
+
+/**
+ * @brief Memory resource that counts the allocations it forwards
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t allocations = 0;
+    
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        allocations++;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+} // namespace
+
+void testMemoryResource() {
+    std::cout << "Testing License with a memory resource...\n";
+    
+    CountingResource counting;
+    std::pmr::monotonic_buffer_resource arena(&counting);
+    
+    License license("Test Project", "CCSL-1234-5678", &arena);
+    Assert::isTrue(license.getMemoryResource() == &arena);
+    
+    // Registered contributions move into the license's resource
+    CodeContribution contribution("Alice", "main.cpp", 10, 20);
+    contribution.addMetricEvaluation({MetricType::IMPACT, 0.5, "Medium impact"});
+    Assert::isTrue(contribution.get_allocator().resource() == std::pmr::get_default_resource());
+    Assert::isTrue(license.registerContribution(contribution));
+    Assert::isTrue(license.registerContribution(CodeContribution("Bob", "main.cpp", 30, 40)));
+    Assert::isTrue(counting.allocations > 0);
+    
+    const CodeContribution& stored = license.getContributions()[0];
+    Assert::isTrue(stored.get_allocator().resource() == &arena);
+    Assert::areEqual(stored.getMetricEvaluations().size(), size_t(1));
+    Assert::areEqual(stored.getMetricEvaluations()[0].rationale, std::string("Medium impact"));
+    
+    // The overlap index and diffs still work against arena storage
+    Assert::isFalse(license.registerContribution(CodeContribution("Carol", "main.cpp", 15, 35)));
+    FileDiff diff{"main.cpp", "main.cpp", {DiffHunk{0, 0, 0, 5}}};
+    Assert::areEqual(license.applyDiff(diff).shifted, size_t(2));
+    Assert::areEqual(license.getContributions()[1].getLineRange().first, 35);
+    
+    // Copies fall back to the default resource
+    License copy = license;
+    Assert::isTrue(copy.getMemoryResource() == std::pmr::get_default_resource());
+    Assert::areEqual(copy.getContributions().size(), size_t(2));
+    
+    const std::size_t before = counting.allocations;
+    CodeContribution copied(stored, std::pmr::polymorphic_allocator<std::byte>(&counting));
+    Assert::isTrue(counting.allocations > before);
+    Assert::areEqual(copied.getContributor(), std::string("Alice"));
+}
+
+void testReportWriter() {
+    std::cout << "Testing ReportWriter...\n";
+    
+    // Numbers match the iostream formatting the reports used before
+    std::ostringstream expected;
+    std::string text;
+    {
+        ReportWriter writer([&text](std::string_view chunk) { text += chunk; });
+        for (double value : {0.0, 1.0 / 3.0, 123456789.0, 1e-7, -2.5, 0.1 + 0.2}) {
+            writer << value << ' ';
+            expected << value << ' ';
+            writer.writeBitcoinAmount(value) << '|';
+            expected << std::fixed << std::setprecision(8) << value << '|' << std::defaultfloat << std::setprecision(6);
+        }
+        writer << -42 << std::uint64_t(18446744073709551615ULL);
+        expected << -42 << 18446744073709551615ULL;
+        writer.writeFixed(1e300, 2);
+        expected << std::fixed << std::setprecision(2) << 1e300;
+    }
+    Assert::areEqual(text, expected.str());
+    Assert::areEqual(formatBitcoinAmount(0.001), std::string("0.00100000"));
+    
+    // Large reports reach the sink in bounded chunks, identical to the string form
+    License license("Test Project", "CCSL-1234-5678");
+    for (int i = 0; i < 2000; i++) {
+        CodeContribution contribution("Contributor " + std::to_string(i), "file.cpp", 10 * i, 10 * i + 5);
+        MetricScores scores;
+        scores.set(MetricType::IMPACT, i / 2000.0);
+        contribution.setMetricScores(scores);
+        Assert::isTrue(license.registerContribution(contribution));
+    }
+    
+    std::string streamed;
+    std::size_t chunks = 0;
+    std::size_t largest = 0;
+    license.writeLicenseInfo([&](std::string_view chunk) {
+        streamed += chunk;
+        chunks++;
+        largest = std::max(largest, chunk.size());
+    });
+    Assert::areEqual(streamed, license.getLicenseInfo());
+    Assert::isTrue(chunks > 1 && largest <= 4096, "Report should be streamed in buffer-sized chunks");
+    Assert::isTrue(streamed.find("  Contributor: Contributor 1999\n  File: file.cpp\n  Lines: 19990-19995\n  Value: 0.9995\n") != std::string::npos);
+    
+    std::ostringstream out;
+    license.writeLicenseInfo(out);
+    Assert::areEqual(out.str(), streamed);
+    
+    PaymentManager& manager = license.getPaymentManager();
+    Assert::isTrue(manager.recordPayment(license.getContributions()[0], 0.5));
+    std::ostringstream report;
+    manager.writePaymentReport(report);
+    Assert::areEqual(report.str(), manager.generatePaymentReport());
+    Assert::isTrue(report.str().find("Contributor 0: 0.50000000 BTC\n\nTotal Payments: 0.50000000 BTC\n") != std::string::npos);
+}
+
+void testSatoshis() {
+    std::cout << "Testing Satoshis...\n";
+    
+    Assert::areEqual(Satoshis::fromBitcoins(0.001).getSatoshis(), std::int64_t(100000));
+    Assert::areEqual(Satoshis::fromBitcoins(0.1 + 0.2).getSatoshis(), std::int64_t(30000000));
+    Assert::areEqual(Satoshis::fromBitcoins(-1.5).getSatoshis(), std::int64_t(-150000000));
+    Assert::areEqual(Satoshis(12345).toBitcoins(), 0.00012345);
+    Assert::throws<std::invalid_argument>([]() { Satoshis::fromBitcoins(1e12); }, "Out of range amount should throw");
+    Assert::throws<std::invalid_argument>([]() { Satoshis::fromBitcoins(std::nan("")); }, "NaN amount should throw");
+    Assert::isTrue(Satoshis::tryFromBitcoins(0.001) == Satoshis(100000));
+    Assert::isFalse(Satoshis::tryFromBitcoins(std::nan("")).has_value());
+    Assert::isFalse(Satoshis::tryFromBitcoins(0.0).has_value());
+    Assert::isFalse(Satoshis::tryFromBitcoins(1e-9).has_value(), "Amounts below half a satoshi round to zero");
+    Assert::isFalse(Satoshis::tryFromBitcoins(-1.0).has_value());
+    Assert::isFalse(Satoshis::tryFromBitcoins(1e12).has_value());
+    
+    Assert::areEqual(formatBitcoinAmount(Satoshis(0)), std::string("0.00000000"));
+    Assert::areEqual(formatBitcoinAmount(Satoshis(-100000)), std::string("-0.00100000"));
+    Assert::areEqual(formatBitcoinAmount(Satoshis(2100000000000000)), std::string("21000000.00000000"));
+    Assert::areEqual(formatBitcoinAmount(Satoshis(std::numeric_limits<std::int64_t>::min())),
+                     std::string("-92233720368.54775808"));
+    std::ostringstream out;
+    out << Satoshis(1);
+    Assert::areEqual(out.str(), std::string("0.00000001"));
+    
+    Satoshis sum(std::numeric_limits<std::int64_t>::max() - 1);
+    Assert::isTrue(sum.tryAdd(Satoshis(1)));
+    Assert::isFalse(sum.tryAdd(Satoshis(1)));
+    Assert::areEqual(sum.getSatoshis(), std::numeric_limits<std::int64_t>::max());
+    
+    // A million micropayments add up exactly, and the running total needs no re-sum
+    PaymentManager manager("1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa");
+    CodeContribution alice("Alice", "main.cpp", 1, 2);
+    CodeContribution bob("Bob", "main.cpp", 3, 4);
+    for (int i = 0; i < 1000000; i++) {
+        Assert::isTrue(manager.recordPayment(i % 2 ? alice : bob, 0.00000010));
+    }
+    Assert::areEqual(manager.getTotalPayments(), Satoshis(10000000));
+    Assert::areEqual(manager.getContributorTotal("Alice"), Satoshis(5000000));
+    Assert::areEqual(manager.getTotalPaymentsForContributor("Bob"), 0.05);
+    Assert::isTrue(manager.generatePaymentReport().find("Total Payments: 0.10000000 BTC") != std::string::npos);
+    
+    // Amounts below half a satoshi round to nothing and are rejected
+    Assert::isFalse(manager.recordPayment(alice, 1e-9));
+    Assert::isFalse(manager.recordPayment(alice, Satoshis(0)));
+    Assert::isFalse(manager.recordPayment(alice, Satoshis(std::numeric_limits<std::int64_t>::max())));
+    Assert::areEqual(manager.getTotalPayments(), Satoshis(10000000));
+}
+
 int main() {
     TestRunner runner;
     
     runner.addTest("CodeContribution", testCodeContribution);
+    runner.addTest("MetricScores", testMetricScores);
     runner.addTest("PaymentManager", testPaymentManager);
     runner.addTest("License", testLicense);
+    runner.addTest("RegisterContributions", testRegisterContributions);
+    runner.addTest("MemoryResource", testMemoryResource);
+    runner.addTest("ReportWriter", testReportWriter);
+    runner.addTest("Satoshis", testSatoshis);
     
     return runner.runAll();
 }
\ No newline at end of file
@@ -6,9 +6,14 @@
 
 #include <ccsl/metrics.hpp>
 #include <ccsl/utility.hpp>
+#include <ccsl/keyword_matcher.hpp>
+#include <ccsl/evaluation_cache.hpp>
+#include <ccsl/c_api.h>
 #include "test_framework.hpp"
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <memory_resource>
 
 using namespace ccsl;
 using namespace ccsl::test;
@@ -334,6 +339,88 @@ void testMetricEvaluatorFactory() {
     }, "Invalid metric type should throw exception");
 }
 
+void testSourceLexer() {
+    std::cout << "Testing SourceLexer...\n";
+    
+    std::string code;
+    code += "/** @param x The input\n";
+    code += " * @see https://example.com/ref and RFC 4122 */\n";
+    code += "\n";
+    code += "int f(int x) {\n";
+    code += "    if (x) { return g (x); } // O(1) lookup\n";
+    code += "}\n";
+    
+    SourceSummary summary = scanSource(code);
+    
+    Assert::areEqual(summary.byteCount, code.size());
+    Assert::areEqual(summary.lines.size(), size_t(6));
+    Assert::areEqual(summary.callSites, 4);           // f(, if (, g (, O(
+    Assert::areEqual(summary.controlStatements, 1);
+    Assert::areEqual(summary.docTags, 2);
+    Assert::areEqual(summary.references, 2);
+    Assert::areEqual(summary.complexityAnnotations, 1);
+    Assert::areEqual(summary.maxBraceDepth, 2);
+    Assert::areEqual(summary.closeParenBraces, 2);
+    
+    // Line facts
+    Assert::isTrue(summary.lines[2].blank, "Empty line should be blank");
+    Assert::areEqual(summary.lines[0].blockCommentOpen, size_t(0));
+    Assert::areEqual(summary.lines[1].blockCommentClose, size_t(45));
+    Assert::areEqual(summary.lines[4].indentLength, size_t(4));
+    Assert::areEqual(summary.lines[4].indentChar, ' ');
+    Assert::areEqual(summary.lines[4].wordsAfterLineComment, 2);
+    
+    // Evaluating the summary must give the same result as evaluating the text
+    auto evaluators = MetricEvaluatorFactory::createAll();
+    for (const auto& evaluator : evaluators) {
+        MetricEvaluation fromText = evaluator->evaluate(code);
+        MetricEvaluation fromSummary = evaluator->evaluate(summary);
+        Assert::areEqual(fromText.value, fromSummary.value);
+        Assert::areEqual(fromText.rationale, fromSummary.rationale);
+    }
+    
+    // A trailing newline does not produce an extra line
+    Assert::areEqual(scanSource("a\nb\n").lines.size(), size_t(2));
+    Assert::areEqual(scanSource("a\nb").lines.size(), size_t(2));
+    Assert::areEqual(scanSource("").lines.size(), size_t(0));
+    
+    // Long words and gaps are skipped in bulk, but what ends or interrupts
+    // them is still seen, at every distance from the start of a run
+    for (std::size_t length = 1; length < 80; length++) {
+        const std::string word(length, 'x');
+        const std::string gap(length, ' ');
+        SourceSummary runs = scanSource("  " + word + "http://a" + gap + "\t" + word + "O(n)" + gap + "\v" + word + "(\n");
+        Assert::areEqual(runs.identifiers, 5);            // word+http, a, word+O, n, word
+        Assert::areEqual(runs.references, 1);
+        Assert::areEqual(runs.complexityAnnotations, 1);
+        Assert::areEqual(runs.callSites, 2);              // O(, word(
+        Assert::areEqual(runs.lines[0].indentLength, size_t(2));
+        Assert::areEqual(runs.lines[0].words, 3);
+        Assert::areEqual(runs.lines[0].length, 5 * length + 17);
+    }
+}
+
+void testKeywordMatcher() {
+    std::cout << "Testing KeywordMatcher...\n";
+    
+    static constexpr KeywordEntry<int> keywords[] = {
+        {"alpha", 1}, {"beta", 2}, {"gamma", 3}, {"delta", 4}, {"epsilon", 5}
+    };
+    static constexpr auto matcher = makeKeywordMatcher(keywords);
+    static_assert(matcher.find("gamma") == 3, "Lookup should work at compile time");
+    
+    for (const auto& keyword : keywords) {
+        Assert::areEqual(matcher.find(keyword.word), keyword.value);
+        Assert::isTrue(matcher.contains(keyword.word));
+    }
+    
+    // Misses return a value-initialized result
+    Assert::areEqual(matcher.find("alphabet"), 0);
+    Assert::areEqual(matcher.find("alph"), 0);
+    Assert::areEqual(matcher.find(""), 0);
+    Assert::isFalse(matcher.contains("Beta"));
+}
+
 void testMetricsEvaluator() {
     std::cout << "Testing MetricsEvaluator...\n";
     
@@ -345,7 +432,18 @@ void testMetricsEvaluator() {
     // Test evaluateAll
     auto evaluations = evaluator.evaluateAll(highQualityCode);
     Assert::areEqual(evaluations.size(), size_t(6)); // 6 types of metrics
-    
+
+    // The memory resource overload returns the same evaluations from an arena
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::vector<MetricEvaluation> arenaEvaluations = evaluator.evaluateAll(highQualityCode, &arena);
+    Assert::isTrue(arenaEvaluations.get_allocator().resource() == &arena);
+    Assert::areEqual(arenaEvaluations.size(), evaluations.size());
+    for (std::size_t i = 0; i < evaluations.size(); i++) {
+        Assert::isTrue(arenaEvaluations[i].type == evaluations[i].type);
+        Assert::areEqual(arenaEvaluations[i].value, evaluations[i].value);
+        Assert::areEqual(arenaEvaluations[i].rationale, evaluations[i].rationale);
+    }
+
     // Test calculateValue
     double value = evaluator.calculateValue(highQualityCode);
     Assert::isTrue(value > 0.5, "High-quality code should have high overall value");
@@ -358,6 +456,177 @@ void testMetricsEvaluator() {
                   "High-quality code should score higher than low-quality code");
 }
 
+void testEvaluateScores() {
+    std::cout << "Testing MetricsEvaluator::evaluateScores...\n";
+    
+    MetricsEvaluator evaluator;
+    std::string code = createSampleCode(true, true, true, true, true, true);
+    
+    auto evaluations = evaluator.evaluateAll(code);
+    MetricScores scores = evaluator.evaluateScores(code);
+    Assert::areEqual(scores.size(), evaluations.size());
+    
+    // Compact scores agree with the full evaluations, and rationales are
+    // reproduced on demand from the raw counts
+    for (const auto& evaluation : evaluations) {
+        Assert::isTrue(scores.has(evaluation.type));
+        Assert::areEqual(scores.get(evaluation.type), evaluation.value);
+        Assert::areEqual(evaluator.formatRationale(scores, evaluation.type), evaluation.rationale);
+    }
+    
+    auto expanded = evaluator.toEvaluations(scores);
+    Assert::areEqual(expanded.size(), evaluations.size());
+    for (size_t i = 0; i < expanded.size(); i++) {
+        Assert::areEqual(expanded[i].type, evaluations[i].type);
+        Assert::areEqual(expanded[i].rationale, evaluations[i].rationale);
+    }
+    
+    Assert::areEqual(scores.mean(), evaluator.calculateValue(code));
+    
+    // Unscored metrics have no rationale
+    MetricScores empty;
+    Assert::areEqual(empty.mean(), 0.0);
+    Assert::areEqual(evaluator.formatRationale(empty, MetricType::IMPACT), std::string());
+    
+    // Batch scoring matches the single-fragment path
+    std::vector<std::string_view> fragments = {code, code};
+    ThreadPool pool(2);
+    auto batch = evaluator.evaluateBatchScores(fragments, pool);
+    Assert::areEqual(batch.size(), size_t(2));
+    Assert::isTrue(batch[1].values == scores.values, "Batch scores should match evaluateScores");
+}
+
+void testEvaluateBatch() {
+    std::cout << "Testing MetricsEvaluator::evaluateBatch...\n";
+    
+    MetricsEvaluator evaluator;
+    
+    std::vector<std::string> codes;
+    for (int i = 0; i < 64; i++) {
+        codes.push_back(createSampleCode(i & 1, i & 2, i & 4, i & 8, i & 16, i & 32));
+    }
+    std::vector<std::string_view> fragments(codes.begin(), codes.end());
+    
+    ThreadPool pool(4);
+    auto results = evaluator.evaluateBatch(fragments, pool);
+    Assert::areEqual(results.size(), fragments.size() * evaluator.getMetricCount());
+    
+    // Results match the serial path, row by row
+    for (size_t f = 0; f < codes.size(); f++) {
+        auto expected = evaluator.evaluateAll(codes[f]);
+        for (size_t m = 0; m < expected.size(); m++) {
+            const auto& actual = results[f * evaluator.getMetricCount() + m];
+            Assert::areEqual(actual.type, expected[m].type);
+            Assert::areEqual(actual.value, expected[m].value);
+        }
+    }
+    
+    // The convenience overload creates its own pool
+    Assert::areEqual(evaluator.evaluateBatch(fragments, size_t(2)).size(), results.size());
+    Assert::areEqual(evaluator.evaluateBatch({}).size(), size_t(0));
+}
+
+void testEvaluationCache() {
+    std::cout << "Testing EvaluationCache...\n";
+    
+    // hashBytes is XXH64 and must never change, since cache keys are persisted
+    Assert::areEqual(hashBytes(""), std::uint64_t(0xef46db3751d8e999ULL));
+    Assert::areEqual(hashBytes("abc"), std::uint64_t(0x44bc2cf5ad770999ULL));
+    Assert::areEqual(hashBytes("Nobody inspects the spammish repetition"), std::uint64_t(0xfbcea83c8a378bf1ULL));
+    Assert::areEqual(calculateHash("abc"), std::string("44bc2cf5ad770999"));
+    Assert::areEqual(calculateHash(""), std::string(""));
+    
+    MetricsEvaluator evaluator;
+    EvaluationCache cache;
+    const std::string code = createSampleCode(true, true, true, true, true, true);
+    
+    auto expected = evaluator.evaluateAll(code);
+    auto first = cache.evaluateAll(evaluator, code);
+    auto second = cache.evaluateAll(evaluator, code);
+    Assert::areEqual(cache.getMisses(), size_t(1));
+    Assert::areEqual(cache.getHits(), size_t(1));
+    Assert::areEqual(cache.size(), size_t(1));
+    
+    Assert::areEqual(second.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        Assert::isTrue(first[i].type == expected[i].type);
+        Assert::areEqual(first[i].value, expected[i].value);
+        Assert::areEqual(second[i].value, expected[i].value);
+        Assert::areEqual(second[i].rationale, expected[i].rationale);
+    }
+    
+    // Changed bytes miss the cache
+    Assert::isFalse(cache.find(code + " ").has_value());
+    
+    // Entries survive a round trip through disk
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "ccsl_evaluation_cache_test.bin";
+    Assert::isTrue(cache.save(path));
+    
+    EvaluationCache reloaded;
+    Assert::isTrue(reloaded.load(path));
+    Assert::areEqual(reloaded.size(), size_t(1));
+    auto cached = reloaded.find(code);
+    Assert::isTrue(cached.has_value());
+    Assert::areEqual(cached->mean(), evaluator.calculateValue(code));
+    
+    // Results saved by other scoring rules are ignored
+    EvaluationCache otherVersion(MetricsEvaluator::kVersion + 1);
+    Assert::isFalse(otherVersion.load(path));
+    Assert::areEqual(otherVersion.size(), size_t(0));
+    
+    std::filesystem::remove(path);
+    Assert::isFalse(reloaded.load(path));
+}
+
+void testCApi() {
+    std::cout << "Testing C API...\n";
+    
+    MetricsEvaluator evaluator;
+    ccsl_evaluator_t* handle = ccsl_evaluator_create();
+    Assert::isTrue(handle != nullptr);
+    Assert::areEqual(ccsl_evaluator_version(), unsigned(MetricsEvaluator::kVersion));
+    
+    // Scores are the library's own, bit for bit
+    const std::string code = createSampleCode(true, true, true, true, true, true);
+    ccsl_scores_t scores;
+    Assert::areEqual(ccsl_evaluate(handle, code.data(), code.size(), &scores), 0);
+    
+    MetricScores expected = evaluator.evaluateScores(code);
+    Assert::areEqual(scores.present, unsigned(expected.present));
+    Assert::areEqual(ccsl_scores_mean(&scores), expected.mean());
+    for (int i = 0; i < CCSL_METRIC_COUNT; i++) {
+        MetricType type = static_cast<MetricType>(i);
+        Assert::areEqual(scores.values[i], expected.get(type));
+        
+        std::string rationale = evaluator.formatRationale(expected, type);
+        char buffer[256];
+        Assert::areEqual(ccsl_format_rationale(handle, &scores, i, buffer, sizeof(buffer)), rationale.size());
+        Assert::areEqual(std::string(buffer), rationale);
+        
+        // Rationales are truncated like snprintf() does
+        char small[8];
+        Assert::areEqual(ccsl_format_rationale(handle, &scores, i, small, sizeof(small)), rationale.size());
+        Assert::areEqual(std::string(small), rationale.substr(0, sizeof(small) - 1));
+    }
+    Assert::areEqual(std::string(ccsl_metric_name(0)), std::string("Impact"));
+    Assert::isTrue(ccsl_metric_name(CCSL_METRIC_COUNT) == nullptr);
+    Assert::areEqual(ccsl_format_rationale(handle, &scores, -1, nullptr, 0), size_t(0));
+    
+    // Files are scored like their contents, and unreadable ones are reported
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "ccsl_c_api_test.cpp";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << code;
+    }
+    ccsl_scores_t fromFile;
+    Assert::areEqual(ccsl_evaluate_file(handle, path.string().c_str(), &fromFile), 0);
+    Assert::areEqual(ccsl_scores_mean(&fromFile), expected.mean());
+    std::filesystem::remove(path);
+    Assert::areEqual(ccsl_evaluate_file(handle, path.string().c_str(), &fromFile), -1);
+    
+    ccsl_evaluator_destroy(handle);
+}
+
 int main() {
     TestRunner runner;
     
@@ -368,7 +637,13 @@ int main() {
     runner.addTest("CreditabilityEvaluator", testCreditabilityEvaluator);
     runner.addTest("NoveltyEvaluator", testNoveltyEvaluator);
     runner.addTest("MetricEvaluatorFactory", testMetricEvaluatorFactory);
+    runner.addTest("SourceLexer", testSourceLexer);
+    runner.addTest("KeywordMatcher", testKeywordMatcher);
     runner.addTest("MetricsEvaluator", testMetricsEvaluator);
+    runner.addTest("EvaluateBatch", testEvaluateBatch);
+    runner.addTest("EvaluateScores", testEvaluateScores);
+    runner.addTest("EvaluationCache", testEvaluationCache);
+    runner.addTest("CApi", testCApi);
     
     return runner.runAll();
 }
\ No newline at end of file
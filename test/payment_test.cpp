@@ -6,10 +6,15 @@
 
 #include <ccsl/payment.hpp>
 #include <ccsl/utility.hpp>
+#include <ccsl/bitcoin_address.hpp>
 #include "test_framework.hpp"
+#include <algorithm>
 #include <iostream>
 #include <thread>
 #include <chrono>
+#include <atomic>
+#include <mutex>
+#include <vector>
 
 using namespace ccsl;
 using namespace ccsl::test;
@@ -38,7 +43,7 @@ void testBitcoinPaymentManager() {
     PaymentVerificationCallback callback = [&callbackCalled](const PaymentTransaction& tx, bool success) {
         callbackCalled = true;
         Assert::isTrue(success);
-        Assert::areEqual(tx.amount, 0.001);
+        Assert::areEqual(tx.amount, Satoshis(100000));
     };
     
     // Send the payment
@@ -72,6 +77,25 @@ void testBitcoinPaymentManager() {
     auto emptyTransactions = manager.getTransactionsForContribution("non-existent");
     Assert::areEqual(emptyTransactions.size(), size_t(0));
     
+    // Visitors see the stored transactions and their current status without copies
+    std::size_t visited = 0;
+    manager.forEachTransaction([&](const PaymentTransaction& tx, bool verified) {
+        Assert::areEqual(tx.transactionId, transactionId);
+        Assert::isTrue(verified);
+        visited++;
+        return true;
+    });
+    manager.forEachTransactionForContribution(contributionId, [&](const PaymentTransaction& tx, bool) {
+        Assert::isTrue(tx.contributionId == contributionId);
+        visited++;
+        return true;
+    });
+    manager.forEachTransactionForContribution("non-existent", [&](const PaymentTransaction&, bool) {
+        visited++;
+        return true;
+    });
+    Assert::areEqual(visited, size_t(2));
+    
     // Test invalid payment parameters
     Assert::throws<std::invalid_argument>([&manager]() {
         manager.sendPayment("invalid-wallet", "3J98t1WpEZ73CNmQviecrnyiWrnqRhWNLy", 0.001, "test", {});
@@ -160,17 +184,377 @@ void testRecurringPaymentManager() {
     manager.addSubscription(subscription2Updated);
     Assert::areEqual(manager.getSubscriptions().size(), size_t(1));
     
+    // Moving and emplacing index the subscription the same way
+    manager.addSubscription(PaymentSubscription("contributor-3", "1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa", 30));
+    manager.emplaceSubscription("contributor-4", "3J98t1WpEZ73CNmQviecrnyiWrnqRhWNLy", 10);
+    manager.emplaceSubscription("contributor-4", "3J98t1WpEZ73CNmQviecrnyiWrnqRhWNLy", 20);
+    Assert::areEqual(manager.getSubscriptions().size(), size_t(3));
+    Assert::areEqual(manager.findSubscription("contributor-4")->getSubscriptionPeriod(), 20);
+    Assert::areEqual(manager.findSubscription("contributor-3")->getContributorId(), std::string("contributor-3"));
+    Assert::isTrue(manager.removeSubscription("contributor-3"));
+    Assert::isTrue(manager.removeSubscription("contributor-4"));
+    
     // Test processing due payments (none should be due)
     int processed = manager.processDuePayments();
     Assert::areEqual(processed, 0);
 }
 
+void testTransactionStore() {
+    std::cout << "Testing TransactionStore...\n";
+    
+    TransactionStore store;
+    auto makeTransaction = [](int id, const std::string& contributionId) {
+        PaymentTransaction transaction{};
+        transaction.transactionId = "tx-" + std::to_string(id);
+        transaction.contributionId = contributionId;
+        transaction.amount = Satoshis(100000);
+        transaction.verified = false;
+        return transaction;
+    };
+    
+    Assert::isTrue(store.insert(makeTransaction(0, "c-0")));
+    Assert::isFalse(store.insert(makeTransaction(0, "c-1")));
+    Assert::isTrue(store.setVerified("tx-0", true));
+    Assert::isFalse(store.setVerified("missing", true));
+    Assert::isTrue(store.isVerified("tx-0"));
+    Assert::isTrue(store.find("tx-0")->verified);
+    Assert::isFalse(store.find("missing").has_value());
+    
+    // Readers run while writers insert and verify, and always see a consistent table
+    const int writerCount = 4;
+    const int perWriter = 2000;
+    std::atomic<bool> done{false};
+    std::atomic<bool> consistent{true};
+    
+    std::thread reader([&]() {
+        while (!done.load()) {
+            std::size_t before = store.size();
+            if (store.snapshot().size() < before || !store.find("tx-0")) {
+                consistent = false;
+            }
+            store.findByContribution("c-1");
+        }
+    });
+    
+    std::vector<std::thread> writers;
+    for (int w = 0; w < writerCount; w++) {
+        writers.emplace_back([&store, &makeTransaction, w, perWriter]() {
+            for (int i = 0; i < perWriter; i++) {
+                int id = 1 + w * perWriter + i;
+                store.insert(makeTransaction(id, "c-" + std::to_string(i % 3)));
+                store.setVerified("tx-" + std::to_string(id), true);
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    reader.join();
+    
+    Assert::isTrue(consistent.load());
+    Assert::areEqual(store.size(), size_t(1 + writerCount * perWriter));
+    Assert::areEqual(store.snapshot().size(), store.size());
+    Assert::isTrue(store.snapshot().front().transactionId == "tx-0");
+    
+    auto contribution = store.findByContribution("c-1");
+    Assert::areEqual(contribution.size(), size_t(writerCount * ((perWriter + 1) / 3)));
+    for (const auto& transaction : contribution) {
+        Assert::isTrue(transaction.verified);
+    }
+}
+
+void testPaymentExecutor() {
+    std::cout << "Testing PaymentExecutor...\n";
+    
+    Assert::throws<std::invalid_argument>([]() {
+        PaymentExecutor invalid(0, 16);
+    }, "Zero workers should throw exception");
+    
+    Assert::throws<std::invalid_argument>([]() {
+        PaymentExecutor invalid(2, 0);
+    }, "Zero capacity should throw exception");
+    
+    // Tasks run in due order, not submission order
+    {
+        PaymentExecutor executor(1, 16);
+        std::mutex mutex;
+        std::vector<int> order;
+        std::promise<void> finished;
+        
+        executor.schedule(std::chrono::milliseconds(60), [&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(2);
+            finished.set_value();
+        });
+        executor.schedule(std::chrono::milliseconds(20), [&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(1);
+        });
+        
+        finished.get_future().wait();
+        std::lock_guard<std::mutex> lock(mutex);
+        Assert::areEqual(order.size(), size_t(2));
+        Assert::areEqual(order[0], 1);
+        Assert::areEqual(order[1], 2);
+    }
+    
+    // A full executor pushes back, and the thread count never changes
+    {
+        PaymentExecutor executor(2, 4);
+        for (int i = 0; i < 4; i++) {
+            Assert::isTrue(executor.trySchedule(std::chrono::milliseconds(50), []() {}));
+        }
+        Assert::isFalse(executor.trySchedule(std::chrono::milliseconds(50), []() {}));
+        Assert::areEqual(executor.getPendingCount(), size_t(4));
+        Assert::areEqual(executor.getThreadCount(), size_t(3));
+        
+        std::atomic<int> ran{0};
+        for (int i = 0; i < 100; i++) {
+            executor.schedule(std::chrono::milliseconds(1), [&ran]() { ran++; });
+        }
+        Assert::areEqual(executor.getThreadCount(), size_t(3));
+        
+        // Remaining tasks run on destruction rather than being dropped
+        executor.schedule(std::chrono::hours(1), [&ran]() { ran++; });
+        while (executor.getPendingCount() > 1) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        Assert::areEqual(ran.load(), 100);
+    }
+    
+    // Many payments share the executor's threads
+    auto executor = std::make_shared<PaymentExecutor>(2, 64);
+    BitcoinPaymentManager manager("test-api-key", executor);
+    manager.setVerificationDelay(std::chrono::milliseconds(5));
+    
+    std::vector<std::future<std::string>> futures;
+    for (int i = 0; i < 200; i++) {
+        futures.push_back(manager.sendPayment("1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa",
+                                              "3J98t1WpEZ73CNmQviecrnyiWrnqRhWNLy",
+                                              0.001, "batch", {}));
+    }
+    for (auto& future : futures) {
+        Assert::isTrue(manager.verifyPayment(future.get()));
+    }
+    Assert::areEqual(manager.getTransactionsForContribution("batch").size(), size_t(200));
+}
+
+void testSendPaymentBatch() {
+    std::cout << "Testing BitcoinPaymentManager::sendPaymentBatch...\n";
+    
+    BitcoinPaymentManager manager("test-api-key", std::make_shared<PaymentExecutor>(1, 16));
+    manager.setVerificationDelay(std::chrono::milliseconds(5));
+    
+    const std::string sourceWallet = "1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa";
+    std::vector<PaymentOutput> outputs = {
+        {"3J98t1WpEZ73CNmQviecrnyiWrnqRhWNLy", 0.002, "contribution-1"},
+        {"invalid-wallet", 0.001, "contribution-2"},
+        {"1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa", 0, "contribution-3"},
+        {"1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa", 0.003, "contribution-1"}
+    };
+    
+    std::atomic<int> callbacks{0};
+    PaymentBatchResult result = manager.sendPaymentBatch(sourceWallet, outputs,
+        [&callbacks](const PaymentTransaction& tx, bool success) {
+            Assert::isTrue(success);
+            Assert::isTrue(tx.verified);
+            callbacks++;
+        }).get();
+    
+    Assert::areEqual(callbacks.load(), 2);
+    Assert::isFalse(result.transactionId.empty());
+    Assert::areEqual(result.outputs.size(), outputs.size());
+    Assert::isTrue(result.outputs[0].state == PaymentOutputState::VERIFIED);
+    Assert::isTrue(result.outputs[1].state == PaymentOutputState::REJECTED);
+    Assert::isTrue(result.outputs[2].state == PaymentOutputState::REJECTED);
+    Assert::isTrue(result.outputs[3].state == PaymentOutputState::VERIFIED);
+    Assert::isFalse(result.outputs[1].error.empty());
+    Assert::isTrue(result.outputs[1].outputId.empty());
+    
+    // Each included output is recorded under the shared transaction ID
+    Assert::areEqual(result.outputs[3].outputId, result.transactionId + ":3");
+    Assert::isTrue(manager.verifyPayment(result.outputs[0].outputId));
+    Assert::areEqual(manager.getTransactions().size(), size_t(2));
+    Assert::areEqual(manager.getTransactionsForContribution("contribution-1").size(), size_t(2));
+    
+    // Rejections are known as soon as the batch is submitted, and exact amounts are sent unconverted
+    std::vector<PaymentOutput> exact = {
+        {"3J98t1WpEZ73CNmQviecrnyiWrnqRhWNLy", Satoshis(123456789), "contribution-4"},
+        {"invalid-wallet", Satoshis(1), "contribution-5"},
+        {"3J98t1WpEZ73CNmQviecrnyiWrnqRhWNLy", Satoshis(0), "contribution-6"},
+        {"3J98t1WpEZ73CNmQviecrnyiWrnqRhWNLy", -1.0, "contribution-7"}
+    };
+    PaymentBatchSubmission submission = manager.submitPaymentBatch(sourceWallet, exact);
+    Assert::areEqual(submission.outputs.size(), exact.size());
+    Assert::isTrue(submission.outputs[0].state == PaymentOutputState::UNVERIFIED);
+    Assert::isTrue(submission.outputs[1].state == PaymentOutputState::REJECTED);
+    Assert::isTrue(submission.outputs[2].state == PaymentOutputState::REJECTED);
+    Assert::isTrue(submission.outputs[3].state == PaymentOutputState::REJECTED);
+    Assert::areEqual(submission.result.get().transactionId, submission.transactionId);
+    Assert::isTrue(manager.getTransactionsForContribution("contribution-4")[0].amount == Satoshis(123456789));
+    
+    Assert::throws<std::invalid_argument>([&manager, &sourceWallet]() {
+        manager.sendPaymentBatch(sourceWallet, {{"invalid-wallet", 0.001, "test"}});
+    }, "Batch without valid outputs should throw exception");
+    
+    Assert::throws<std::invalid_argument>([&manager, &outputs]() {
+        manager.sendPaymentBatch("invalid-wallet", outputs);
+    }, "Invalid source wallet should throw exception");
+}
+
+void testRecurringPaymentSchedule() {
+    std::cout << "Testing RecurringPaymentManager scheduling...\n";
+    
+    BitcoinPaymentManager paymentManager("test-api-key", std::make_shared<PaymentExecutor>(1, 256));
+    paymentManager.setVerificationDelay(std::chrono::milliseconds(1));
+    RecurringPaymentManager manager(paymentManager);
+    
+    const auto now = std::chrono::system_clock::now();
+    for (int i = 0; i < 100; i++) {
+        PaymentSubscription subscription("contributor-" + std::to_string(i), "1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa", 30);
+        subscription.setNextPaymentDate(now + std::chrono::hours(i));
+        manager.addSubscription(subscription);
+    }
+    Assert::areEqual(manager.getSubscriptions().size(), size_t(100));
+    Assert::isNotNull(manager.findSubscription("contributor-42"));
+    Assert::isNull(manager.findSubscription("non-existent"));
+    
+    // Only the subscriptions due by the given time are paid
+    Assert::areEqual(manager.processDuePayments(now + std::chrono::minutes(150)), 3);
+    Assert::areEqual(manager.processDuePayments(now + std::chrono::minutes(150)), 0);
+    Assert::isTrue(manager.findSubscription("contributor-0")->getNextPaymentDate() > now + std::chrono::hours(24 * 29));
+    
+    // Removed and rescheduled subscriptions are not paid at their old date
+    Assert::isTrue(manager.removeSubscription("contributor-3"));
+    Assert::isFalse(manager.removeSubscription("contributor-3"));
+    PaymentSubscription postponed("contributor-4", "1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa", 30);
+    postponed.setNextPaymentDate(now + std::chrono::hours(1000));
+    manager.addSubscription(postponed);
+    Assert::areEqual(manager.getSubscriptions().size(), size_t(99));
+    Assert::areEqual(manager.processDuePayments(now + std::chrono::minutes(330)), 1);
+    
+    // Replacing a subscription many times does not grow the schedule without bound
+    for (int i = 0; i < 1000; i++) {
+        manager.addSubscription(postponed);
+    }
+    Assert::areEqual(manager.getSubscriptions().size(), size_t(99));
+    // Subscriptions paid earlier are due again after their 30-day period
+    Assert::areEqual(manager.processDuePayments(now + std::chrono::hours(999)), 99 - 1);
+    Assert::isTrue(manager.findSubscription("contributor-4")->getNextPaymentDate() == now + std::chrono::hours(1000));
+}
+
+void testGenerateUUID() {
+    std::cout << "Testing generateUUID...\n";
+    
+    auto isUUID = [](const std::string& id, char version) {
+        if (id.size() != 36 || id[14] != version || std::string("89ab").find(id[19]) == std::string::npos) {
+            return false;
+        }
+        for (std::size_t i = 0; i < id.size(); i++) {
+            bool dash = i == 8 || i == 13 || i == 18 || i == 23;
+            if (dash ? id[i] != '-' : std::string("0123456789abcdef").find(id[i]) == std::string::npos) {
+                return false;
+            }
+        }
+        return true;
+    };
+    
+    Assert::isTrue(isUUID(generateUUID(), '4'), "Default UUIDs should be version 4");
+    UUIDChars chars = generateUUIDChars(UUIDVersion::V4);
+    Assert::isTrue(isUUID(std::string(chars.data(), chars.size()), '4'));
+    
+    // Version 7 carries the current Unix time in milliseconds in its first 48 bits
+    auto before = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::string first = generateUUID(UUIDVersion::V7);
+    Assert::isTrue(isUUID(first, '7'), "Version 7 UUID should be well-formed");
+    long long millis = std::stoll(first.substr(0, 8) + first.substr(9, 4), nullptr, 16);
+    Assert::isTrue(millis >= before && millis - before < 60000, "Version 7 UUID should hold the current time");
+    
+    // Version 7 IDs from one thread sort in creation order
+    std::string previous = first;
+    for (int i = 0; i < 10000; i++) {
+        std::string next = generateUUID(UUIDVersion::V7);
+        Assert::isTrue(previous < next, "Version 7 UUIDs should be strictly increasing");
+        previous = next;
+    }
+    
+    // Concurrent callers draw from their own generators and never collide
+    std::vector<std::vector<std::string>> ids(4);
+    std::vector<std::thread> threads;
+    for (auto& list : ids) {
+        threads.emplace_back([&list]() {
+            for (int i = 0; i < 5000; i++) {
+                list.push_back(generateUUID(i % 2 ? UUIDVersion::V4 : UUIDVersion::V7));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::vector<std::string> all;
+    for (const auto& list : ids) {
+        all.insert(all.end(), list.begin(), list.end());
+    }
+    std::sort(all.begin(), all.end());
+    Assert::isTrue(std::adjacent_find(all.begin(), all.end()) == all.end(), "UUIDs should be unique");
+}
+
+void testValidateBitcoinAddress() {
+    std::cout << "Testing validateBitcoinAddress...\n";
+    
+    auto hex = [](const Sha256Digest& digest) {
+        std::string text;
+        for (std::uint8_t byte : digest) {
+            text += "0123456789abcdef"[byte >> 4];
+            text += "0123456789abcdef"[byte & 15];
+        }
+        return text;
+    };
+    Assert::areEqual(hex(sha256("abc")), std::string("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+    Assert::areEqual(hex(sha256(std::string(55, 'a'))), std::string("9f4390f8d30c2dd92ec9f095b65e2b9ae9b0a925a5258e241c9f1e910f734318"));
+    Assert::areEqual(hex(sha256(std::string(1000, 'a'))), std::string("41edece42d63e8d9bf515a9ba6932e1c20cbc9f5a5d134645adb5db1b9737ea3"));
+    
+    // Base58Check
+    Assert::isTrue(parseBitcoinAddress("1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa") == BitcoinAddressType::P2PKH);
+    Assert::isTrue(parseBitcoinAddress("3J98t1WpEZ73CNmQviecrnyiWrnqRhWNLy") == BitcoinAddressType::P2SH);
+    Assert::isTrue(parseBitcoinAddress("1111111111111111111114oLvT2") == BitcoinAddressType::P2PKH);
+    Assert::isFalse(parseBitcoinAddress("1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNb").has_value(), "Bad checksum should be rejected");
+    Assert::isFalse(parseBitcoinAddress("1A1zP1eP5QGefi2DMPTfTL5SLmv7Div0Na").has_value(), "Characters outside Base58 should be rejected");
+    
+    // Bech32 and Bech32m (BIP 173 and BIP 350)
+    Assert::isTrue(parseBitcoinAddress("bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4") == BitcoinAddressType::P2WPKH);
+    Assert::isTrue(parseBitcoinAddress("BC1QW508D6QEJXTDG4Y5R3ZARVARY0C5XW7KV8F3T4") == BitcoinAddressType::P2WPKH);
+    Assert::isTrue(parseBitcoinAddress("bc1qrp33g0q5c5txsp9arysrx4k6zdkfs4nce4xj0gdcccefvpysxf3qccfmv3") == BitcoinAddressType::P2WSH);
+    Assert::isTrue(parseBitcoinAddress("bc1p0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7vqzk5jj0") == BitcoinAddressType::P2TR);
+    Assert::isFalse(parseBitcoinAddress("bc1p0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7vqh2y7hd").has_value(), "Version 1 with a Bech32 checksum should be rejected");
+    Assert::isFalse(parseBitcoinAddress("BC1QR508D6QEJXTDG4Y5R3ZARVARYV98GJ9P").has_value(), "Version 0 programs must be 20 or 32 bytes");
+    Assert::isFalse(parseBitcoinAddress("bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t5").has_value(), "Bad checksum should be rejected");
+    Assert::isFalse(parseBitcoinAddress("bc1qw508d6qejxtdg4y5r3zarvaRy0c5xw7kv8f3t4").has_value(), "Mixed case should be rejected");
+    Assert::isFalse(parseBitcoinAddress("tb1qw508d6qejxtdg4y5r3zarvary0c5xw7kxpjzsx").has_value(), "Testnet addresses should be rejected");
+    
+    // Cached results match fresh ones
+    for (int i = 0; i < 2; i++) {
+        Assert::isTrue(validateBitcoinAddress("bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4"));
+        Assert::isFalse(validateBitcoinAddress("1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNb"));
+    }
+    Assert::isFalse(validateBitcoinAddress(""));
+    Assert::isFalse(validateBitcoinAddress(std::string(100, '1')));
+}
+
 int main() {
     TestRunner runner;
     
     runner.addTest("BitcoinPaymentManager", testBitcoinPaymentManager);
     runner.addTest("PaymentSubscription", testPaymentSubscription);
     runner.addTest("RecurringPaymentManager", testRecurringPaymentManager);
+    runner.addTest("TransactionStore", testTransactionStore);
+    runner.addTest("PaymentExecutor", testPaymentExecutor);
+    runner.addTest("SendPaymentBatch", testSendPaymentBatch);
+    runner.addTest("RecurringPaymentSchedule", testRecurringPaymentSchedule);
+    runner.addTest("GenerateUUID", testGenerateUUID);
+    runner.addTest("ValidateBitcoinAddress", testValidateBitcoinAddress);
     
     return runner.runAll();
 }
\ No newline at end of file
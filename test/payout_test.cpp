@@ -0,0 +1,161 @@
+/**
+ * @file payout_test.cpp
+ * @brief Test cases for the CCSL payout engine
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/payout.hpp>
+#include <ccsl/thread_pool.hpp>
+#include "test_framework.hpp"
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ccsl;
+using namespace ccsl::test;
+
+namespace {
+
+const std::string kWallet = "1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa";
+
+// Registers contributions worth 1.0 each, `shares` of them for the contributor
+void addContributions(License& license, const std::string& contributor, int shares) {
+    for (int i = 0; i < shares; i++) {
+        CodeContribution contribution(contributor, contributor + ".cpp", i * 10, i * 10 + 5);
+        MetricScores scores;
+        scores.set(MetricType::IMPACT, 1.0);
+        contribution.setMetricScores(scores);
+        Assert::isTrue(license.registerContribution(contribution));
+    }
+}
+
+} // namespace
+
+void testComputePayouts() {
+    std::cout << "Testing PayoutEngine::computePayouts...\n";
+
+    License license("Payouts", "CCSL-PAYOUT-0001");
+    addContributions(license, "payout-alice", 3);
+    addContributions(license, "payout-bob", 1);
+    addContributions(license, "payout-carol", 4);
+
+    PayoutEngine engine(license);
+    std::vector<PaymentSubscription> recipients = {
+        PaymentSubscription("payout-alice", kWallet, 30),
+        PaymentSubscription("payout-bob", kWallet, 30),
+        PaymentSubscription("payout-nobody", kWallet, 30)
+    };
+
+    // Shares are fractions of the whole license; Carol has no subscription
+    std::vector<Payout> payouts = engine.computePayouts(recipients, Satoshis(800));
+    Assert::areEqual(payouts.size(), size_t(3));
+    Assert::areEqual(payouts[0].contributorId, std::string("payout-alice"));
+    Assert::areEqual(payouts[0].value, 3.0);
+    Assert::isTrue(payouts[0].amount == Satoshis(300));
+    Assert::isTrue(payouts[1].amount == Satoshis(100));
+    Assert::isTrue(payouts[2].amount == Satoshis(0));
+    Assert::isTrue(engine.computeShare("payout-carol", Satoshis(800)) == Satoshis(400));
+
+    // Shares round down, so they never add up to more than the budget
+    payouts = engine.computePayouts(recipients, Satoshis(7));
+    Assert::isTrue(payouts[0].amount == Satoshis(2));
+    Assert::isTrue(payouts[1].amount == Satoshis(0));
+
+    Assert::throws<std::invalid_argument>([&] { engine.computePayouts(recipients, Satoshis(-1)); });
+
+    License empty("Empty", "CCSL-PAYOUT-0002");
+    Assert::isTrue(PayoutEngine(empty).computeShare("payout-alice", Satoshis(800)) == Satoshis(0));
+}
+
+void testParallelPayouts() {
+    std::cout << "Testing parallel payouts...\n";
+
+    // Enough recipients to be split over several tasks
+    License license("Payouts", "CCSL-PAYOUT-0003");
+    std::vector<PaymentSubscription> recipients;
+    const int count = 10000;
+    for (int i = 0; i < count; i++) {
+        const std::string contributor = "parallel-" + std::to_string(i);
+        addContributions(license, contributor, 1 + i % 3);
+        recipients.emplace_back(contributor, kWallet, 30);
+    }
+
+    ThreadPool pool(4);
+    const Satoshis budget(kSatoshisPerBitcoin);
+    std::vector<Payout> serial = PayoutEngine(license).computePayouts(recipients, budget);
+    std::vector<Payout> parallel = PayoutEngine(license, &pool).computePayouts(recipients, budget);
+
+    Satoshis total;
+    for (int i = 0; i < count; i++) {
+        Assert::areEqual(parallel[i].contributorId, recipients[i].getContributorId());
+        Assert::isTrue(parallel[i].amount == serial[i].amount);
+        total += parallel[i].amount;
+    }
+    Assert::isTrue(total <= budget);
+    Assert::isTrue(total > budget - Satoshis(count));
+}
+
+void testRecurringPayouts() {
+    std::cout << "Testing RecurringPaymentManager payouts...\n";
+
+    License license("Payouts", "CCSL-PAYOUT-0004");
+    addContributions(license, "recurring-alice", 3);
+    addContributions(license, "recurring-bob", 1);
+
+    BitcoinPaymentManager paymentManager("test-api-key", std::make_shared<PaymentExecutor>(1, 16));
+    paymentManager.setVerificationDelay(std::chrono::milliseconds(1));
+    RecurringPaymentManager manager(paymentManager);
+    const auto now = std::chrono::system_clock::now();
+    for (const std::string contributor : {"recurring-alice", "recurring-bob", "recurring-nobody"}) {
+        PaymentSubscription subscription(contributor, kWallet, 30);
+        subscription.setNextPaymentDate(now);
+        manager.addSubscription(subscription);
+    }
+
+    PayoutEngine engine(license);
+    manager.setPayoutEngine(&engine, Satoshis(1000));
+    Assert::isTrue(manager.getPayoutEngine() == &engine);
+    Assert::throws<std::invalid_argument>([&] { manager.setPayoutEngine(&engine, Satoshis(-1)); });
+
+    // Each payment is recorded under the ID of the period it pays for
+    const std::string alicePeriod = manager.findSubscription("recurring-alice")->getPaymentPeriodId();
+    const std::string bobPeriod = manager.findSubscription("recurring-bob")->getPaymentPeriodId();
+    Assert::isTrue(alicePeriod.rfind("recurring-alice:", 0) == 0);
+
+    // Contributors without value are skipped but still wait a period
+    Assert::areEqual(manager.processDuePayments(now), 2);
+    Assert::areEqual(manager.getSkippedPayments(), size_t(1));
+    Assert::isTrue(manager.findSubscription("recurring-nobody")->getNextPaymentDate() == now + std::chrono::hours(24 * 30));
+    Assert::areEqual(manager.processDuePayments(now), 0);
+    Assert::areEqual(manager.getSkippedPayments(), size_t(0));
+
+    std::vector<PaymentTransaction> transactions = paymentManager.getTransactionsForContribution(alicePeriod);
+    Assert::areEqual(transactions.size(), size_t(1));
+    Assert::isTrue(transactions[0].amount == Satoshis(750));
+    Assert::isTrue(paymentManager.getTransactionsForContribution(bobPeriod)[0].amount == Satoshis(250));
+
+    // Both payments went out in one transaction
+    const std::string& id = transactions[0].transactionId;
+    const std::string batchId = id.substr(0, id.find(':'));
+    Assert::isTrue(paymentManager.getTransactionsForContribution(bobPeriod)[0].transactionId.rfind(batchId, 0) == 0);
+
+    // Without an engine every due subscription gets the flat amount
+    manager.setPayoutEngine(nullptr, Satoshis(0));
+    const std::string nobodyPeriod = manager.findSubscription("recurring-nobody")->getPaymentPeriodId();
+    Assert::isTrue(nobodyPeriod != alicePeriod);
+    Assert::areEqual(manager.processDuePayments(now + std::chrono::hours(24 * 30)), 3);
+    Assert::isTrue(paymentManager.getTransactionsForContribution(nobodyPeriod)[0].amount == kFlatRecurringPayment);
+    Assert::isTrue(paymentManager.getTransactionsForContribution("recurring-nobody").empty());
+}
+
+int main() {
+    TestRunner runner;
+
+    runner.addTest("ComputePayouts", testComputePayouts);
+    runner.addTest("ParallelPayouts", testParallelPayouts);
+    runner.addTest("RecurringPayouts", testRecurringPayouts);
+
+    return runner.runAll();
+}
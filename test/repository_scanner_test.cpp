@@ -0,0 +1,161 @@
+/**
+ * @file repository_scanner_test.cpp
+ * @brief Test cases for the CCSL repository scanner
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/repository_scanner.hpp>
+#include "test_framework.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+using namespace ccsl;
+using namespace ccsl::test;
+
+namespace {
+
+std::filesystem::path makeTempTree(const std::string& name) {
+    std::filesystem::path root = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+    return root;
+}
+
+void writeFile(const std::filesystem::path& path, const std::string& contents) {
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream file(path, std::ios::binary);
+    file << contents;
+}
+
+const CodeContribution* findContribution(const License& license, const std::string& fileId) {
+    for (const CodeContribution& contribution : license.getContributions()) {
+        if (contribution.getFileId() == fileId) {
+            return &contribution;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+void testScan() {
+    std::cout << "Testing RepositoryScanner::scan...\n";
+
+    std::filesystem::path root = makeTempTree("ccsl_scanner_test");
+    writeFile(root / "main.cpp", "int main() {\n    return 0;\n}\n");
+    writeFile(root / "src" / "util.hpp", "// Helpers\nint twice(int x) { return 2 * x; }\n");
+    writeFile(root / "src" / "deep" / "ops.c", "int add(int a, int b) { return a + b; }");
+    writeFile(root / "README.txt", "not source\n");
+    writeFile(root / "empty.cpp", "");
+
+    RepositoryScanOptions options;
+    options.contributor = "Alice";
+    options.readThreads = 2;
+    options.evaluateThreads = 2;
+    options.queueCapacity = 1;
+    std::size_t callbacks = 0;
+    options.onProgress = [&](const ScanProgress&) { callbacks++; };
+    RepositoryScanner scanner(options);
+
+    License license("Test Project", "TEST-KEY-123");
+    RepositoryScanResult result = scanner.scan(root, license);
+
+    Assert::isFalse(result.cancelled);
+    Assert::isTrue(result.failures.empty());
+    Assert::areEqual(result.progress.discovered, size_t(4));
+    Assert::areEqual(result.progress.skipped, size_t(1));
+    Assert::areEqual(result.progress.read, size_t(3));
+    Assert::areEqual(result.progress.evaluated, size_t(3));
+    Assert::areEqual(result.progress.registered, size_t(3));
+    Assert::areEqual(result.progress.rejected, size_t(0));
+    Assert::areEqual(callbacks, size_t(4));
+    Assert::areEqual(license.getContributions().size(), size_t(3));
+
+    // Files are identified by generic relative paths and span all their lines
+    const CodeContribution* main = findContribution(license, "main.cpp");
+    Assert::isNotNull(main);
+    Assert::areEqual(main->getContributor(), std::string("Alice"));
+    Assert::isTrue(main->getLineRange() == std::make_pair(0, 2));
+    Assert::areEqual(main->getMetricScores().size(), size_t(kMetricTypeCount));
+    const CodeContribution* ops = findContribution(license, "src/deep/ops.c");
+    Assert::isNotNull(ops);
+    Assert::isTrue(ops->getLineRange() == std::make_pair(0, 0));
+    Assert::isNotNull(findContribution(license, "src/util.hpp"));
+
+    // Scanning again overlaps every registered contribution
+    result = scanner.scan(root, license);
+    Assert::areEqual(result.progress.registered, size_t(0));
+    Assert::areEqual(result.progress.rejected, size_t(3));
+    Assert::areEqual(license.getContributions().size(), size_t(3));
+
+    // An empty extension list scans every file
+    options.extensions.clear();
+    License all("Test Project", "TEST-KEY-123");
+    Assert::areEqual(RepositoryScanner(options).scan(root, all).progress.registered, size_t(4));
+
+    // A missing root is reported as a failure
+    result = scanner.scan(root / "missing", license);
+    Assert::areEqual(result.progress.failed, size_t(1));
+    Assert::areEqual(result.failures.size(), size_t(1));
+
+    std::filesystem::remove_all(root);
+}
+
+void testCancel() {
+    std::cout << "Testing RepositoryScanner::cancel...\n";
+
+    std::filesystem::path root = makeTempTree("ccsl_scanner_cancel_test");
+    const std::size_t fileCount = 200;
+    for (std::size_t i = 0; i < fileCount; i++) {
+        writeFile(root / ("file" + std::to_string(i) + ".cpp"), "int f() { return 1; }\n");
+    }
+
+    RepositoryScanOptions options;
+    options.queueCapacity = 2;
+    RepositoryScanner* scannerPointer = nullptr;
+    options.onProgress = [&](const ScanProgress& progress) {
+        if (progress.registered == 5) {
+            scannerPointer->cancel();
+        }
+    };
+    RepositoryScanner scanner(options);
+    scannerPointer = &scanner;
+
+    License license("Test Project", "TEST-KEY-123");
+    RepositoryScanResult result = scanner.scan(root, license);
+    Assert::isTrue(result.cancelled);
+    Assert::areEqual(result.progress.registered, size_t(5));
+    Assert::isTrue(result.progress.discovered < fileCount);
+    Assert::areEqual(license.getContributions().size(), size_t(5));
+
+    // Scanning again registers the files the cancelled scan did not reach
+    options.onProgress = nullptr;
+    result = RepositoryScanner(options).scan(root, license);
+    Assert::isFalse(result.cancelled);
+    Assert::areEqual(result.progress.registered, fileCount - 5);
+
+    Assert::throws<std::invalid_argument>([] {
+        RepositoryScanOptions invalid;
+        invalid.readThreads = 0;
+        RepositoryScanner scanner(invalid);
+    });
+    Assert::throws<std::invalid_argument>([] {
+        RepositoryScanOptions invalid;
+        invalid.contributor.clear();
+        RepositoryScanner scanner(invalid);
+    });
+
+    std::filesystem::remove_all(root);
+}
+
+int main() {
+    TestRunner runner;
+
+    runner.addTest("Scan", testScan);
+    runner.addTest("Cancel", testCancel);
+
+    return runner.runAll();
+}
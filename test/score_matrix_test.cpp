@@ -0,0 +1,195 @@
+/**
+ * @file score_matrix_test.cpp
+ * @brief Test cases for metric weights, the score matrix and license value totals
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/license.hpp>
+#include "test_framework.hpp"
+#include <cstring>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ccsl;
+using namespace ccsl::test;
+
+namespace {
+
+MetricScores makeScores(std::mt19937& random) {
+    std::uniform_real_distribution<double> value(0.0, 1.0);
+    MetricScores scores;
+    // Leaves some rows without any score
+    const unsigned present = random() % 64;
+    for (std::size_t m = 0; m < kMetricTypeCount; m++) {
+        if ((present >> m) & 1u) {
+            scores.set(static_cast<MetricType>(m), value(random));
+        }
+    }
+    return scores;
+}
+
+bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+CodeContribution makeContribution(const std::string& contributor, const std::string& file,
+                                  int start, int end, std::mt19937& random) {
+    CodeContribution contribution(contributor, file, start, end);
+    MetricScores scores = makeScores(random);
+    scores.set(MetricType::IMPACT, 0.5);
+    contribution.setMetricScores(scores);
+    return contribution;
+}
+
+// Recomputes every total from scratch for comparison with the cached ones
+void checkTotals(const License& license) {
+    const MetricWeights& weights = license.getMetricWeights();
+    std::map<std::string, double> contributors;
+    std::map<std::string, double> files;
+    double total = 0.0;
+    const auto& contributions = license.getContributions();
+    for (std::size_t i = 0; i < contributions.size(); i++) {
+        const double value = weights.apply(contributions[i].getMetricScores());
+        Assert::isTrue(sameBits(license.getContributionValue(i), value));
+        contributors[contributions[i].getContributor()] += value;
+        files[contributions[i].getFileId()] += value;
+        total += value;
+    }
+
+    Assert::areEqual(license.getContributorValues().size(), contributors.size());
+    for (const auto& [name, value] : license.getContributorValues()) {
+        Assert::isTrue(std::abs(contributors[name] - value) < 1e-9);
+        Assert::isTrue(sameBits(license.getContributorValue(name), value));
+        Assert::isTrue(sameBits(license.getInternedContributorValue(InternedString(name)), value));
+    }
+    Assert::areEqual(license.getFileValues().size(), files.size());
+    for (const auto& [name, value] : license.getFileValues()) {
+        Assert::isTrue(std::abs(files[name] - value) < 1e-9);
+    }
+    Assert::isTrue(std::abs(license.getTotalValue() - total) < 1e-9);
+}
+
+} // namespace
+
+void testMetricWeights() {
+    std::cout << "Testing MetricWeights...\n";
+
+    MetricWeights weights;
+    Assert::areEqual(weights.get(MetricType::NOVELTY), 1.0);
+    weights.set(MetricType::NOVELTY, 3.0);
+    weights.set(MetricType::SIMPLICITY, 0.0);
+    Assert::areEqual(weights.get(MetricType::NOVELTY), 3.0);
+    Assert::throws<std::invalid_argument>([&] { weights.set(MetricType::IMPACT, -1.0); });
+    Assert::throws<std::invalid_argument>([&] { weights.set(MetricType::IMPACT, std::numeric_limits<double>::infinity()); });
+
+    // Weighted mean over the scored metrics; weight 0 leaves one out
+    MetricScores scores;
+    scores.set(MetricType::NOVELTY, 0.9);
+    scores.set(MetricType::SIMPLICITY, 0.1);
+    scores.set(MetricType::IMPACT, 0.5);
+    Assert::isTrue(std::abs(weights.apply(scores) - (3.0 * 0.9 + 0.5) / 4.0) < 1e-12);
+    Assert::areEqual(MetricWeights().apply(MetricScores()), 0.0);
+
+    MetricWeights only;
+    only.values.fill(0.0);
+    only.set(MetricType::SIMPLICITY, 1.0);
+    Assert::areEqual(only.apply(scores), 0.1);
+    scores = MetricScores();
+    scores.set(MetricType::IMPACT, 0.5);
+    Assert::areEqual(only.apply(scores), 0.0);
+}
+
+void testScoreMatrix() {
+    std::cout << "Testing ScoreMatrix...\n";
+
+    std::mt19937 random(27);
+    std::vector<MetricScores> rows;
+    ScoreMatrix matrix;
+    // Not a multiple of the vector width, so the scalar tail runs too
+    for (int i = 0; i < 1003; i++) {
+        rows.push_back(makeScores(random));
+        const double value = matrix.append(rows.back());
+        CodeContribution contribution("matrix-author", "matrix.cpp", 0, 1);
+        contribution.setMetricScores(rows.back());
+        Assert::isTrue(sameBits(value, contribution.calculateValue()));
+    }
+    Assert::areEqual(matrix.size(), rows.size());
+
+    MetricWeights weights;
+    weights.set(MetricType::CLEANNESS, 2.5);
+    weights.set(MetricType::COMMENT, 0.0);
+    weights.set(MetricType::IMPACT, 0.3);
+    matrix.setWeights(weights);
+    for (std::size_t i = 0; i < rows.size(); i++) {
+        Assert::isTrue(sameBits(matrix.getValue(i), weights.apply(rows[i])));
+    }
+
+    matrix.removeSwap(10);
+    Assert::areEqual(matrix.size(), rows.size() - 1);
+    Assert::isTrue(sameBits(matrix.getValue(10), weights.apply(rows.back())));
+    matrix.clear();
+    Assert::areEqual(matrix.size(), size_t(0));
+}
+
+void testLicenseValues() {
+    std::cout << "Testing License value totals...\n";
+
+    std::mt19937 random(28);
+    License license("Values", "CCSL-VALUES-0001");
+    for (int i = 0; i < 40; i++) {
+        const std::string file = i % 2 == 0 ? "a.cpp" : "c.cpp";
+        Assert::isTrue(license.registerContribution(
+            makeContribution("author-" + std::to_string(i % 3), file, i * 10, i * 10 + 5, random)));
+    }
+    license.emplaceContribution("author-3", "d.cpp", 0, 10);
+    checkTotals(license);
+    Assert::areEqual(license.getContributorValue("author-never-registered"), 0.0);
+    Assert::areEqual(license.getInternedContributorValue(InternedString("author-interned-only")), 0.0);
+    Assert::areEqual(license.getFileValue("d.cpp"), 0.0);
+    Assert::throws<std::out_of_range>([&] { license.getContributionValue(41); });
+
+    MetricWeights weights;
+    weights.set(MetricType::CLEANNESS, 4.0);
+    weights.set(MetricType::IMPACT, 0.5);
+    license.setMetricWeights(weights);
+    Assert::areEqual(license.getMetricWeights().get(MetricType::CLEANNESS), 4.0);
+    checkTotals(license);
+
+    // Moving a file moves its value; deleting one drops it
+    license.applyDiff(FileDiff{"a.cpp", "b.cpp", {}});
+    Assert::areEqual(license.getFileValue("a.cpp"), 0.0);
+    checkTotals(license);
+    const double fileValue = license.getFileValue("c.cpp");
+    const double totalValue = license.getTotalValue();
+    license.applyDiff(FileDiff{"c.cpp", "", {}});
+    Assert::areEqual(license.getContributions().size(), size_t(21));
+    Assert::isTrue(std::abs(license.getTotalValue() - (totalValue - fileValue)) < 1e-9);
+    checkTotals(license);
+
+    // Later contributions are weighed with the project's weights
+    license.registerContribution(makeContribution("author-4", "e.cpp", 0, 3, random));
+    checkTotals(license);
+
+    license.applyDiff(FileDiff{"b.cpp", "", {}});
+    license.applyDiff(FileDiff{"d.cpp", "", {}});
+    license.applyDiff(FileDiff{"e.cpp", "", {}});
+    Assert::isTrue(license.getContributions().empty());
+    Assert::isTrue(license.getContributorValues().empty());
+    Assert::areEqual(license.getTotalValue(), 0.0);
+}
+
+int main() {
+    TestRunner runner;
+
+    runner.addTest("MetricWeights", testMetricWeights);
+    runner.addTest("ScoreMatrix", testScoreMatrix);
+    runner.addTest("LicenseValues", testLicenseValues);
+
+    return runner.runAll();
+}
@@ -0,0 +1,125 @@
+/**
+ * @file source_classifier_test.cpp
+ * @brief Test cases for the CCSL source classifier
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/source_classifier.hpp>
+#include <ccsl/repository_scanner.hpp>
+#include <ccsl/c_api.h>
+#include "test_framework.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace ccsl;
+using namespace ccsl::test;
+
+namespace {
+
+void writeFile(const std::filesystem::path& path, const std::string& contents) {
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream file(path, std::ios::binary);
+    file << contents;
+}
+
+} // namespace
+
+void testClassify() {
+    std::cout << "Testing SourceClassifier::classify...\n";
+
+    Assert::isTrue(SourceClassifier::languageOf("src/main.c") == SourceLanguage::C);
+    Assert::isTrue(SourceClassifier::languageOf("include/ccsl/license.HPP") == SourceLanguage::CPP);
+    Assert::isTrue(SourceClassifier::languageOf("legacy.C") == SourceLanguage::CPP);
+    Assert::isTrue(SourceClassifier::languageOf("app.min.js") == SourceLanguage::UNKNOWN);
+    Assert::isTrue(SourceClassifier::languageOf(".cpp") == SourceLanguage::UNKNOWN);
+
+    SourceClassifier classifier;
+    const std::string code = "int main() {\n    return 0;\n}\n";
+    SourceClassification result = classifier.classify("main.cpp", code);
+    Assert::isTrue(result.shouldEvaluate());
+    Assert::isTrue(result.language == SourceLanguage::CPP);
+    Assert::areEqual(result.lineCount, size_t(3));
+    Assert::areEqual(result.longestLine, size_t(13));
+
+    // Without an extension only the contents decide
+    Assert::isTrue(classifier.classify("", code).shouldEvaluate());
+    Assert::isTrue(classifier.classify("Makefile", code).shouldEvaluate());
+    Assert::isTrue(classifier.classify("script.py", code).verdict == SourceVerdict::NOT_C_FAMILY);
+
+    std::string binary = code;
+    binary[5] = '\0';
+    Assert::isTrue(classifier.classify("main.cpp", binary).verdict == SourceVerdict::BINARY);
+
+    // One huge line is rejected without measuring all of it
+    const std::string minified = "int x[] = {" + std::string(1 << 20, '1') + "};\n";
+    result = classifier.classify("table.c", minified);
+    Assert::isTrue(result.verdict == SourceVerdict::MINIFIED);
+    Assert::areEqual(result.longestLine, classifier.getOptions().maxLineLength + 1);
+
+    // So is a file made mostly of long lines
+    std::string generated;
+    for (int i = 0; i < 10; i++) {
+        generated += (i % 2 ? std::string(400, 'a') : std::string("short")) + "\n";
+    }
+    result = classifier.classify("generated.c", generated);
+    Assert::isTrue(result.verdict == SourceVerdict::MINIFIED);
+    Assert::areEqual(result.longLines, size_t(5));
+
+    SourceClassifierOptions loose;
+    loose.maxLongLineFraction = 0.5;
+    loose.requireKnownExtension = false;
+    Assert::isTrue(SourceClassifier(loose).classify("generated.py", generated).shouldEvaluate());
+    Assert::areEqual(std::string(verdictName(SourceVerdict::BINARY)), std::string("binary"));
+}
+
+void testClassifiedScan() {
+    std::cout << "Testing classified scans...\n";
+
+    std::filesystem::path root = std::filesystem::temp_directory_path() / "ccsl_classifier_scan_test";
+    std::filesystem::remove_all(root);
+    writeFile(root / "main.cpp", "int main() {\n    return 0;\n}\n");
+    writeFile(root / "blob.cpp", std::string("\x7f" "ELF\0\0\0", 7));
+    writeFile(root / "table.c", std::string(100000, 'x'));
+
+    RepositoryScanOptions options;
+    License license("Test Project", "TEST-KEY-123");
+    RepositoryScanResult result = RepositoryScanner(options).scan(root, license);
+    Assert::areEqual(result.progress.discovered, size_t(3));
+    Assert::areEqual(result.progress.skipped, size_t(2));
+    Assert::areEqual(result.progress.evaluated, size_t(1));
+    Assert::areEqual(license.getContributions().size(), size_t(1));
+
+    options.classifyFiles = false;
+    License all("Test Project", "TEST-KEY-123");
+    Assert::areEqual(RepositoryScanner(options).scan(root, all).progress.registered, size_t(3));
+
+    // The C interface classifies before it scores
+    Assert::areEqual(ccsl_classify("main.cpp", "int x;\n", 7), CCSL_SOURCE_EVALUATE);
+    Assert::areEqual(ccsl_classify("notes.md", "text\n", 5), CCSL_SOURCE_NOT_C_FAMILY);
+    Assert::areEqual(ccsl_classify(nullptr, nullptr, 1), -1);
+    Assert::areEqual(std::string(ccsl_verdict_name(CCSL_SOURCE_MINIFIED)), std::string("minified"));
+    Assert::isTrue(ccsl_verdict_name(4) == nullptr);
+
+    ccsl_evaluator_t* handle = ccsl_evaluator_create();
+    ccsl_scores_t scores;
+    int verdict = -1;
+    Assert::areEqual(ccsl_evaluate_source_file(handle, (root / "main.cpp").string().c_str(), &scores, &verdict), 0);
+    Assert::areEqual(verdict, CCSL_SOURCE_EVALUATE);
+    Assert::areEqual(ccsl_evaluate_source_file(handle, (root / "blob.cpp").string().c_str(), &scores, &verdict), 1);
+    Assert::areEqual(verdict, CCSL_SOURCE_BINARY);
+    Assert::areEqual(ccsl_evaluate_source_file(handle, (root / "missing.cpp").string().c_str(), &scores, nullptr), -1);
+    ccsl_evaluator_destroy(handle);
+
+    std::filesystem::remove_all(root);
+}
+
+int main() {
+    TestRunner runner;
+
+    runner.addTest("Classify", testClassify);
+    runner.addTest("ClassifiedScan", testClassifiedScan);
+
+    return runner.runAll();
+}
@@ -0,0 +1,121 @@
+/**
+ * @file source_file_test.cpp
+ * @brief Test cases for the CCSL source file and file utilities
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/source_file.hpp>
+#include <ccsl/utility.hpp>
+#include <ccsl/metrics.hpp>
+#include "test_framework.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using namespace ccsl;
+using namespace ccsl::test;
+
+namespace {
+
+std::filesystem::path writeTempFile(const std::string& name, const std::string& contents) {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+    std::ofstream file(path, std::ios::binary);
+    file << contents;
+    return path;
+}
+
+} // namespace
+
+void testSourceFile() {
+    std::cout << "Testing SourceFile...\n";
+
+    const std::string contents = "line0\nline1\r\n\nline3";
+    std::filesystem::path path = writeTempFile("ccsl_source_file_test.cpp", contents);
+
+    std::optional<SourceFile> file = SourceFile::open(path);
+    Assert::isTrue(file.has_value());
+    Assert::areEqual(file->getContents(), std::string_view(contents));
+    Assert::areEqual(file->getLineCount(), size_t(4));
+
+    Assert::areEqual(file->getLine(0), std::string_view("line0"));
+    Assert::areEqual(file->getLine(1), std::string_view("line1\r"));
+    Assert::areEqual(file->getLine(2), std::string_view(""));
+    Assert::areEqual(file->getLine(3), std::string_view("line3"));
+    Assert::areEqual(file->getLine(4), std::string_view(""));
+
+    Assert::areEqual(file->getLines(1, 2), std::string_view("line1\r\n\n"));
+    Assert::areEqual(file->getLines(2, 100), std::string_view("\nline3"));
+    Assert::areEqual(file->getLines(4, 5), std::string_view(""));
+
+    // Views stay valid when the file is moved
+    std::string_view line = file->getLine(3);
+    SourceFile moved = std::move(*file);
+    Assert::areEqual(line, std::string_view("line3"));
+    Assert::areEqual(moved.getLine(3).data(), line.data());
+
+    // A trailing newline does not add a line
+    SourceFile text = SourceFile::fromString("a\nb\n");
+    Assert::areEqual(text.getLineCount(), size_t(2));
+    Assert::areEqual(SourceFile::fromString("").getLineCount(), size_t(0));
+
+    Assert::isFalse(SourceFile::open(path.string() + ".missing").has_value());
+    std::filesystem::remove(path);
+}
+
+void testReadCodeFromFile() {
+    std::cout << "Testing readCodeFromFile...\n";
+
+    std::filesystem::path path = writeTempFile("ccsl_read_code_test.cpp", "zero\none\ntwo\nthree");
+
+    Assert::areEqual(readCodeFromFile(path, 1, 2).value(), std::string("one\ntwo\n"));
+    Assert::areEqual(readCodeFromFile(path, 2, 10).value(), std::string("two\nthree\n"));
+    Assert::areEqual(readCodeFromFile(path, 7, 9).value(), std::string(""));
+    Assert::isFalse(readCodeFromFile(path, 2, 1).has_value());
+    Assert::isFalse(readCodeFromFile(path, -1, 1).has_value());
+    Assert::isFalse(readCodeFromFile(path.string() + ".missing", 0, 1).has_value());
+
+    // Slices can be evaluated directly, without copying
+    std::optional<SourceFile> file = SourceFile::open(path);
+    MetricsEvaluator evaluator;
+    Assert::areEqual(evaluator.evaluateAll(file->getLines(1, 2)).size(), evaluator.getMetricCount());
+
+    std::filesystem::remove(path);
+}
+
+void testParseCodeMetadata() {
+    std::cout << "Testing parseCodeMetadata...\n";
+
+    std::string contents =
+        "/**\n"
+        " * @author: Alice Smith \n"
+        " * @version :1.2*/\n"
+        " * @empty:*\n"
+        " ** not @metadata: here\n"
+        " *@license:\tCCSL\r\n";
+    for (int i = 0; i < 20; i++) {
+        contents += "//\n";
+    }
+    contents += " * @late: ignored\n";
+
+    std::filesystem::path path = writeTempFile("ccsl_metadata_test.cpp", contents);
+    auto metadata = parseCodeMetadata(path);
+
+    Assert::areEqual(metadata.size(), size_t(3));
+    Assert::areEqual(metadata["author"], std::string("Alice Smith"));
+    Assert::areEqual(metadata["version"], std::string("1.2"));
+    Assert::areEqual(metadata["license"], std::string("CCSL"));
+    Assert::isTrue(metadata.count("late") == 0);
+
+    Assert::isTrue(parseCodeMetadata(path.string() + ".missing").empty());
+    std::filesystem::remove(path);
+}
+
+int main() {
+    TestRunner runner;
+
+    runner.addTest("SourceFile", testSourceFile);
+    runner.addTest("ReadCodeFromFile", testReadCodeFromFile);
+    runner.addTest("ParseCodeMetadata", testParseCodeMetadata);
+
+    return runner.runAll();
+}
@@ -0,0 +1,126 @@
+/**
+ * @file string_interner_test.cpp
+ * @brief Test cases for the CCSL string interner
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/string_interner.hpp>
+#include <ccsl/license.hpp>
+#include <ccsl/transaction_store.hpp>
+#include "test_framework.hpp"
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ccsl;
+using namespace ccsl::test;
+
+void testStringInterner() {
+    std::cout << "Testing StringInterner...\n";
+
+    StringInterner interner;
+    Assert::areEqual(interner.size(), size_t(1));
+    Assert::areEqual(interner.intern(""), StringId(0));
+
+    StringId alice = interner.intern("Alice");
+    Assert::areEqual(interner.intern(std::string("Alice")), alice);
+    Assert::isTrue(interner.intern("Bob") != alice);
+    Assert::areEqual(interner.lookup(alice), std::string("Alice"));
+    Assert::areEqual(interner.lookup(StringId(1000000)), std::string());
+
+    // find() never adds a string
+    Assert::isFalse(interner.find("Carol").has_value());
+    Assert::areEqual(interner.size(), size_t(3));
+    Assert::areEqual(*interner.find("Alice"), alice);
+
+    // Strings stay put while later blocks are allocated
+    const std::string& stored = interner.lookup(alice);
+    for (int i = 0; i < 5000; i++) {
+        interner.intern("name-" + std::to_string(i));
+    }
+    Assert::isTrue(&stored == &interner.lookup(alice));
+    Assert::areEqual(interner.lookup(*interner.find("name-4999")), std::string("name-4999"));
+    Assert::areEqual(interner.size(), size_t(5003));
+}
+
+void testInternedString() {
+    std::cout << "Testing InternedString...\n";
+
+    InternedString empty;
+    Assert::isTrue(empty.empty());
+    Assert::areEqual(empty.str(), std::string());
+
+    InternedString a = "interned-test-file.cpp";
+    InternedString b = std::string("interned-test-file.cpp");
+    Assert::isTrue(a == b);
+    Assert::areEqual(a.getId(), b.getId());
+    Assert::isTrue(a == "interned-test-file.cpp");
+    Assert::isTrue(std::string("other.cpp") != a);
+    Assert::areEqual(std::hash<InternedString>()(a), std::hash<InternedString>()(b));
+
+    // Comparing against text and finding do not intern
+    Assert::isFalse(a == "interned-test-never-seen");
+    Assert::isFalse(InternedString::find("interned-test-never-seen").has_value());
+    Assert::isTrue(*InternedString::find("interned-test-file.cpp") == a);
+
+    // Contributions, ledgers and transactions share the IDs
+    CodeContribution contribution("interned-test-author", "interned-test-file.cpp", 0, 1);
+    Assert::isTrue(contribution.getInternedFileId() == a);
+    Assert::areEqual(contribution.getFileId(), std::string("interned-test-file.cpp"));
+
+    PaymentManager payments("1A1zP1eP5QGefi2DMPTfTL5SLmv7DivfNa");
+    Assert::areEqual(payments.getContributorTotal("interned-test-unpaid"), Satoshis(0));
+    Assert::isFalse(InternedString::find("interned-test-unpaid").has_value());
+
+    TransactionStore store;
+    PaymentTransaction transaction{"tx-1", "src", "dst", Satoshis(10), {}, "interned-test-contribution", false};
+    Assert::isTrue(store.insert(transaction));
+    Assert::areEqual(store.findByContribution("interned-test-contribution").size(), size_t(1));
+    Assert::isTrue(store.findByContribution("interned-test-missing").empty());
+    Assert::isFalse(InternedString::find("interned-test-missing").has_value());
+}
+
+void testConcurrentInterning() {
+    std::cout << "Testing concurrent interning...\n";
+
+    StringInterner interner;
+    const int threadCount = 4;
+    const int names = 3000;
+    std::vector<std::vector<StringId>> ids(threadCount);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < names; i++) {
+                std::string name = "contributor-" + std::to_string(i);
+                StringId id = interner.intern(name);
+                if (interner.lookup(id) != name) {
+                    id = 0;
+                }
+                ids[t].push_back(id);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // Every thread got the same ID for the same string
+    Assert::areEqual(interner.size(), size_t(names + 1));
+    for (int t = 1; t < threadCount; t++) {
+        Assert::isTrue(ids[t] == ids[0]);
+    }
+    for (int i = 0; i < names; i++) {
+        Assert::isTrue(ids[0][i] != 0);
+    }
+}
+
+int main() {
+    TestRunner runner;
+
+    runner.addTest("StringInterner", testStringInterner);
+    runner.addTest("InternedString", testInternedString);
+    runner.addTest("ConcurrentInterning", testConcurrentInterning);
+
+    return runner.runAll();
+}
@@ -0,0 +1,75 @@
+/**
+ * @file thread_pool_test.cpp
+ * @brief Test cases for the CCSL thread pool
+ * @author Shyamal Chandra (C) 2025
+ */
+
+#include <ccsl/thread_pool.hpp>
+#include "test_framework.hpp"
+#include <atomic>
+#include <iostream>
+#include <future>
+
+using namespace ccsl;
+using namespace ccsl::test;
+
+void testSubmit() {
+    std::cout << "Testing ThreadPool::submit...\n";
+    
+    ThreadPool pool(4);
+    Assert::areEqual(pool.getThreadCount(), size_t(4));
+    
+    std::atomic<int> counter{0};
+    std::promise<void> finished;
+    for (int i = 0; i < 1000; i++) {
+        pool.submit([&counter, &finished]() {
+            if (++counter == 1000) {
+                finished.set_value();
+            }
+        });
+    }
+    
+    finished.get_future().wait();
+    Assert::areEqual(counter.load(), 1000);
+}
+
+void testParallelFor() {
+    std::cout << "Testing ThreadPool::parallelFor...\n";
+    
+    ThreadPool pool(3);
+    
+    // Every index is visited exactly once
+    std::vector<int> visits(10007, 0);
+    pool.parallelFor(visits.size(), [&visits](std::size_t i) { visits[i]++; });
+    for (int count : visits) {
+        Assert::areEqual(count, 1);
+    }
+    
+    // Empty ranges are a no-op
+    pool.parallelFor(0, [](std::size_t) { throw std::runtime_error("should not run"); });
+    
+    // Nested use from inside a task does not deadlock
+    std::atomic<int> inner{0};
+    pool.parallelFor(8, [&pool, &inner](std::size_t) {
+        pool.parallelFor(8, [&inner](std::size_t) { inner++; });
+    });
+    Assert::areEqual(inner.load(), 64);
+    
+    // Exceptions are propagated to the caller
+    Assert::throws<std::runtime_error>([&pool]() {
+        pool.parallelFor(100, [](std::size_t i) {
+            if (i == 42) {
+                throw std::runtime_error("failure");
+            }
+        });
+    }, "Exception from body should be rethrown");
+}
+
+int main() {
+    TestRunner runner;
+    
+    runner.addTest("Submit", testSubmit);
+    runner.addTest("ParallelFor", testParallelFor);
+    
+    return runner.runAll();
+}